@@ -0,0 +1,81 @@
+local lpugl = require"lpugl_cairo"
+
+----------------------------------------------------------------------------------------------
+
+local MAX_THREADS = tonumber(arg and arg[1]) or 8
+local FRAMES      = tonumber(arg and arg[2]) or 20
+local WIDTH       = tonumber(arg and arg[3]) or 1920
+local HEIGHT      = tonumber(arg and arg[4]) or 1080
+local TILE_SIZE   = tonumber(arg and arg[5]) or 256
+
+----------------------------------------------------------------------------------------------
+
+-- Measures the frame time of a paint heavy Lua painter that is invoked for the tiles
+-- of the view in per-thread Lua states. The first row is painted by the world's
+-- thread alone (tileThreads = 0), the following rows add tile threads.
+
+local PAINTER = [[
+    local pi = math.pi
+    return function(cr, x, y, width, height, viewWidth, viewHeight)
+        cr:set_source_rgb(0.1, 0.1, 0.15)
+        cr:paint()
+        for i = 0, 40 do
+            for j = 0, 40 do
+                local cx = x + (i + 0.5) * width  / 41
+                local cy = y + (j + 0.5) * height / 41
+                cr:arc(cx, cy, 3 + (i + j) % 4, 0, 2 * pi)
+                cr:set_source_rgba(cx / viewWidth, cy / viewHeight, 0.5, 0.8)
+                cr:fill()
+            end
+        end
+    end
+]]
+
+----------------------------------------------------------------------------------------------
+
+local function measure(tileThreads)
+    local world   = lpugl.newWorld("cairo_tiles.lua")
+    local backend = lpugl.newBackend(world, { tileThreads = tileThreads, tileSize = TILE_SIZE })
+
+    local exposeCount = 0
+    local view = world:newView {
+        title     = "cairo_tiles",
+        size      = { WIDTH, HEIGHT },
+        backend   = backend,
+        eventFunc = function(view, event, ...)
+                        if event == "EXPOSE" then
+                            exposeCount = exposeCount + 1
+                        end
+                    end
+    }
+    view:setRenderer(PAINTER)
+    view:show()
+    world:update(0.1) -- first frame creates the Lua states
+
+    local t0 = world:getTime()
+    for i = 1, FRAMES do
+        local n = exposeCount
+        view:postRedisplay()
+        while exposeCount == n do
+            world:update(0.1)
+        end
+    end
+    local t = world:getTime() - t0
+
+    view:close()
+    world:close()
+    return t / FRAMES
+end
+
+----------------------------------------------------------------------------------------------
+
+print(string.format("%dx%d, tile size %d, %d frames", WIDTH, HEIGHT, TILE_SIZE, FRAMES))
+print("threads  frame time    speedup")
+
+local baseTime
+for tileThreads = 0, MAX_THREADS - 1 do
+    local frameTime = measure(tileThreads)
+    baseTime = baseTime or frameTime
+    print(string.format("%7d  %7.2f ms  %8.2fx", tileThreads + 1, frameTime * 1000,
+                                                  baseTime / frameTime))
+end
@@ -0,0 +1,126 @@
+local lpugl = require"lpugl_cairo"
+
+local loadstring = loadstring or load -- for Lua 5.1
+local unpack     = table.unpack or unpack
+
+----------------------------------------------------------------------------------------------
+
+local CALL_COUNT = tonumber(arg and arg[1]) or 1000000
+
+----------------------------------------------------------------------------------------------
+
+-- Measures the time per call for the methods of world and view objects.
+-- Methods that create or destroy objects or that block are not measured.
+
+local worldCalls = {
+    { "getTime" },
+    { "id" },
+    { "isClosed" },
+    { "hasViews" },
+    { "viewList" },
+    { "getDefaultBackend" },
+    { "getLayoutContext" },
+    { "getScreenScale" },
+    { "hasClipboard" },
+    { "setNextProcessTime", -1 },
+    { "setLogLevel", "ERROR" },
+    { "awake" },
+    { "hasPendingInput" },
+}
+
+local viewCalls = {
+    { "isClosed" },
+    { "isVisible" },
+    { "hasFocus" },
+    { "getSize" },
+    { "getFrame" },
+    { "getScreenScale" },
+    { "getBackend" },
+    { "getLayoutContext" },
+    { "getNativeHandle" },
+    { "postRedisplay" },
+    { "postRedisplay", 10, 10, 20, 20 },
+    { "setTitle", "call_overhead" },
+    { "setCursor", "ARROW" },
+}
+
+local exposeCalls = {
+    { "getDrawContext" },
+    { "getBufferAge" },
+}
+
+----------------------------------------------------------------------------------------------
+
+local function compile(methodName, argCount)
+    local args = {}
+    for i = 1, argCount do args[i] = "a"..i end
+    args = table.concat(args, ", ")
+    return loadstring(string.format([[
+        local getTime, obj, n %s = ...
+        local t0 = getTime()
+        for i = 1, n do
+            obj%s(%s)
+        end
+        return getTime() - t0
+    ]], argCount > 0 and ", "..args or "",
+        methodName and ":"..methodName or ".noop",
+        args))
+end
+
+local world = lpugl.newWorld("call_overhead.lua")
+
+local function getTime() return world:getTime() end
+
+local baseline
+do
+    local obj = { noop = function() end }
+    baseline = compile(nil, 0)(getTime, obj, CALL_COUNT) / CALL_COUNT
+end
+
+local function measure(title, obj, call)
+    local name = title..":"..call[1].."("..(#call > 1 and "..." or "")..")"
+    if not obj[call[1]] then
+        print(string.format("%-36s %8s", name, "n/a")) -- allows comparing older builds
+        return
+    end
+    local run = compile(call[1], #call - 1)
+    run(getTime, obj, math.floor(CALL_COUNT / 10) + 1, select(2, unpack(call))) -- warm up
+    local t = run(getTime, obj, CALL_COUNT, select(2, unpack(call))) / CALL_COUNT
+    print(string.format("%-36s %8.1f ns", name, (t - baseline) * 1e9))
+end
+
+----------------------------------------------------------------------------------------------
+
+print(string.format("%s (%s), %d calls, baseline %.1f ns per Lua call",
+                    _VERSION, jit and jit.version or "interpreter", CALL_COUNT, baseline * 1e9))
+
+for _, call in ipairs(worldCalls) do
+    measure("world", world, call)
+end
+
+local exposed = false
+
+local view = world:newView {
+    title     = "call_overhead",
+    size      = { 200, 200 },
+    eventFunc = function(view, event, ...)
+        if event == "EXPOSE" and not exposed then
+            exposed = true
+            for _, call in ipairs(exposeCalls) do
+                measure("view", view, call)
+            end
+        end
+    end
+}
+view:show()
+
+for _, call in ipairs(viewCalls) do
+    measure("view", view, call)
+end
+
+view:postRedisplay()
+while not exposed do
+    world:update(1)
+end
+
+world:close()
@@ -0,0 +1,39 @@
+local lpugl = require"lpugl_opengl"
+
+----------------------------------------------------------------------------------------------
+
+local VIEW_COUNT = tonumber(arg and arg[1]) or 100
+
+----------------------------------------------------------------------------------------------
+
+local world = lpugl.newWorld("gl_view_create.lua")
+
+local function eventFunc(view, event, ...)
+end
+
+local function openAndCloseViews(count)
+    local t0 = world:getTime()
+    for i = 1, count do
+        local view = world:newView { 
+            title     = "gl_view_create",
+            size      = { 100, 100 },
+            eventFunc = eventFunc
+        }
+        world:update(0)
+        view:close()
+    end
+    world:update(0)
+    return world:getTime() - t0
+end
+
+-- first view performs the GLX negotiation, following views should
+-- reuse the cached framebuffer configuration
+
+local firstTime = openAndCloseViews(1)
+local totalTime = openAndCloseViews(VIEW_COUNT)
+
+print(string.format("first view:  %8.3f ms", firstTime * 1000))
+print(string.format("%4d views:   %8.3f ms (%.3f ms per view)", 
+                    VIEW_COUNT, totalTime * 1000, totalTime * 1000 / VIEW_COUNT))
+
+world:close()
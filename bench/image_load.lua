@@ -0,0 +1,76 @@
+local lpugl = require"lpugl_cairo"
+local cairo = require"oocairo"
+
+----------------------------------------------------------------------------------------------
+
+local IMAGE_COUNT = tonumber(arg and arg[1]) or 40
+local IMAGE_SIZE  = tonumber(arg and arg[2]) or 512
+
+----------------------------------------------------------------------------------------------
+
+-- Measures the time to the first frame if PNG skins are loaded synchronously on the
+-- GUI thread compared to loading them with backend:loadImageAsync(). Every skin is
+-- loaded twice to show the effect of the image cache.
+
+local paths = {}
+for i = 1, IMAGE_COUNT do
+    local surface = cairo.image_surface_create("argb32", IMAGE_SIZE, IMAGE_SIZE)
+    local cr = cairo.context_create(surface)
+    for j = 1, 200 do
+        cr:set_source_rgba(math.random(), math.random(), math.random(), 0.5)
+        cr:arc(math.random(IMAGE_SIZE), math.random(IMAGE_SIZE), math.random(50), 0, 2 * math.pi)
+        cr:fill()
+    end
+    paths[i] = os.tmpname()
+    surface:write_to_png(paths[i])
+end
+
+local function measure(async)
+    local world   = lpugl.newWorld("image_load.lua")
+    local backend = world:getDefaultBackend()
+    local t0      = world:getTime()
+    local images  = {}
+    local firstFrame, allImages
+    local readyCount = 0
+    local view = world:newView {
+        title     = "image_load",
+        size      = { 800, 600 },
+        eventFunc = function(view, event, ...)
+                        if event == "EXPOSE" then
+                            firstFrame = firstFrame or world:getTime() - t0
+                        elseif event == "IMAGE_READY" then
+                            readyCount = readyCount + 1
+                            if readyCount == #images then
+                                allImages = world:getTime() - t0
+                            end
+                        end
+                    end
+    }
+    for round = 1, 2 do
+        for i = 1, IMAGE_COUNT do
+            if async then
+                images[#images + 1] = backend:loadImageAsync(paths[i])
+            else
+                images[#images + 1] = cairo.image_surface_create_from_png(paths[i])
+            end
+        end
+    end
+    view:show()
+    while not firstFrame or (async and not allImages) do
+        world:update(0.1)
+    end
+    view:close()
+    world:close()
+    return firstFrame, allImages or firstFrame
+end
+
+local syncFirst, syncAll   = measure(false)
+local asyncFirst, asyncAll = measure(true)
+
+print(string.format("%d images %dx%d, each loaded twice", IMAGE_COUNT, IMAGE_SIZE, IMAGE_SIZE))
+print(string.format("sync:   first frame %8.2f ms, all images %8.2f ms", syncFirst * 1000, syncAll * 1000))
+print(string.format("async:  first frame %8.2f ms, all images %8.2f ms", asyncFirst * 1000, asyncAll * 1000))
+
+for i = 1, IMAGE_COUNT do
+    os.remove(paths[i])
+end
@@ -0,0 +1,80 @@
+local lpugl = require"lpugl_cairo"
+
+----------------------------------------------------------------------------------------------
+
+local EVENT_COUNT = tonumber(arg and arg[1]) or 100000
+
+----------------------------------------------------------------------------------------------
+
+local world = lpugl.newWorld("inject_motion.lua")
+
+local motionCount = 0
+local exposeCount = 0
+
+local function eventFunc(view, event, ...)
+    if event == "MOTION" then
+        motionCount = motionCount + 1
+        local x, y = ...
+        view:postRedisplay(x, y, 4, 4)
+    elseif event == "EXPOSE" then
+        exposeCount = exposeCount + 1
+        local cairo = view:getDrawContext()
+        cairo:set_source_rgb(0.5, 0.5, 0.5)
+        cairo:paint()
+    end
+end
+
+local view = world:newView {
+    title     = "inject_motion",
+    size      = { 400, 400 },
+    eventFunc = eventFunc
+}
+view:show()
+world:update(0.1)
+
+local function measure(title, func)
+    motionCount = 0
+    exposeCount = 0
+    local t0 = world:getTime()
+    func()
+    local t = world:getTime() - t0
+    print(string.format("%-28s %8.3f ms (%.3f us per event), %d motions, %d exposures",
+                        title, t * 1000, t * 1e6 / EVENT_COUNT, motionCount, exposeCount))
+end
+
+-- one event per call, each one is dispatched with its own exposure
+
+measure("view:injectEvent()", function()
+    for i = 1, EVENT_COUNT do
+        view:injectEvent("MOTION", i % 400, math.floor(i / 400) % 400)
+    end
+end)
+
+-- alternating modifier state prevents motion coalescing
+
+local records = {}
+for i = 1, EVENT_COUNT do
+    records[i] = string.pack("=i4i4dddd", 1, lpugl.EVENT_MOTION,
+                                          i % 400, math.floor(i / 400) % 400,
+                                          i % 2 * lpugl.MOD_SHIFT, 0)
+end
+local data = table.concat(records)
+
+measure("world:injectEvents()", function()
+    world:injectEvents(data, view)
+end)
+
+-- consecutive motion events with same state are coalesced
+
+records = {}
+for i = 1, EVENT_COUNT do
+    records[i] = string.pack("=i4i4dddd", 1, lpugl.EVENT_MOTION,
+                                          i % 400, math.floor(i / 400) % 400, 0, 0)
+end
+data = table.concat(records)
+
+measure("world:injectEvents() merged", function()
+    world:injectEvents(data, view)
+end)
+
+world:close()
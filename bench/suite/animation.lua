@@ -0,0 +1,65 @@
+package.path = (arg[0]:match("^(.*[/\\])") or "./").."?.lua;"..package.path
+local benchlib = require"benchlib"
+
+----------------------------------------------------------------------------------------------
+
+local bench = benchlib.new("animation")
+local world = bench.world
+
+local FRAME_RATE  = 60
+local FRAME_COUNT = 300 * bench.scale
+
+----------------------------------------------------------------------------------------------
+
+-- full window redraw driven by the process function at 60 Hz,
+-- frame times are the intervals between completed exposures
+
+local frameCount = 0
+local drawTime   = 0
+local missed     = 0
+local nextTime
+
+local view = world:newView(bench:viewOptions {
+    title     = "animation",
+    size      = { 1280, 720 },
+    eventFunc = function(view, event, ...)
+        if event == "EXPOSE" then
+            local t0 = world:getTime()
+            local c  = frameCount % FRAME_RATE / FRAME_RATE
+            bench:fill(view, c, 1 - c, 0.5)
+            local w, h = view:getSize()
+            for i = 0, 15 do
+                bench:fill(view, 1, 1, 1, (c * w + i * 70) % w, i * h / 16, 40, h / 32)
+            end
+            drawTime = drawTime + world:getTime() - t0
+            frameCount = frameCount + 1
+            bench:count()
+            bench:frame()
+        end
+    end
+})
+
+world:setProcessFunc(function()
+    view:postRedisplay()
+    nextTime = nextTime + 1 / FRAME_RATE
+    local timeout = nextTime - world:getTime()
+    if timeout < 0 then
+        missed   = missed + 1
+        nextTime = world:getTime()
+        timeout  = 0
+    end
+    world:setNextProcessTime(timeout)
+end)
+
+view:show()
+while world:update(0.1) do end
+
+bench:start()
+nextTime = world:getTime()
+world:setNextProcessTime(0)
+while frameCount < FRAME_COUNT do
+    world:update(1)
+end
+bench:set("draw_ms_avg", drawTime * 1000 / frameCount)
+bench:set("missed_deadlines", missed)
+bench:finish()
@@ -0,0 +1,67 @@
+package.path = (arg[0]:match("^(.*[/\\])") or "./").."?.lua;"..package.path
+local benchlib  = require"benchlib"
+local llthreads = require"llthreads2.ex"
+
+----------------------------------------------------------------------------------------------
+
+local bench = benchlib.new("awake_storm")
+local world = bench.world
+
+local THREAD_COUNT = 4
+local AWAKE_COUNT  = 100000 * bench.scale
+
+----------------------------------------------------------------------------------------------
+
+-- background threads are calling world:awake() as fast as possible,
+-- the main loop counts the resulting invocations of the process function
+
+local processCount = 0
+local lastProcess
+
+local view = world:newView(bench:viewOptions {
+    title     = "awake_storm",
+    size      = { 200, 100 },
+    eventFunc = function(view, event, ...) end
+})
+view:show()
+while world:update(0.1) do end
+
+world:setProcessFunc(function()
+    processCount = processCount + 1
+    bench:frame()
+end)
+
+local threads = {}
+for i = 1, THREAD_COUNT do
+    threads[i] = llthreads.new(function(worldId, count)
+                                   local lpugl = require("lpugl")
+                                   local world = lpugl.world(worldId)
+                                   for i = 1, count do
+                                       world:awake()
+                                   end
+                               end,
+                               world:id(), AWAKE_COUNT)
+end
+
+bench:start()
+for i = 1, THREAD_COUNT do
+    threads[i]:start()
+end
+local running = THREAD_COUNT
+while running > 0 do
+    world:update(0.01)
+    running = 0
+    for i = 1, THREAD_COUNT do
+        if threads[i]:alive() then
+            running = running + 1
+        end
+    end
+end
+world:update(0)
+for i = 1, THREAD_COUNT do
+    threads[i]:join()
+end
+bench:count(processCount)
+bench:set("threads", THREAD_COUNT)
+bench:set("awakes", THREAD_COUNT * AWAKE_COUNT)
+bench:finish()
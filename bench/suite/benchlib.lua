@@ -0,0 +1,198 @@
+--[[
+     Common helpers for the benchmark scenarios in this directory.
+
+     Each scenario is invoked as
+
+         lua <scenario>.lua [backend] [scale]
+
+     with backend "cairo" (default) or "opengl" and an optional factor
+     for the amount of work. At the end one line of JSON with the
+     measured results is written to stdout.
+--]]
+
+local format = string.format
+local floor  = math.floor
+local sort   = table.sort
+local concat = table.concat
+
+local benchlib = {}
+
+----------------------------------------------------------------------------------------------
+
+local function readRss()
+    local rss, hwm
+    local file = io.open("/proc/self/status", "r")
+    if file then
+        for line in file:lines() do
+            local key, kb = line:match("^(%a+):%s+(%d+) kB")
+            if     key == "VmRSS" then rss = tonumber(kb)
+            elseif key == "VmHWM" then hwm = tonumber(kb) end
+        end
+        file:close()
+    end
+    return rss, hwm
+end
+
+local function percentile(sorted, p)
+    local n = #sorted
+    if n == 0 then
+        return nil
+    end
+    local i = floor(p * (n - 1) + 0.5) + 1
+    return sorted[i]
+end
+
+local function toJson(value)
+    local t = type(value)
+    if t == "table" then
+        local keys = {}
+        for k in pairs(value) do keys[#keys + 1] = k end
+        sort(keys)
+        local items = {}
+        for i, k in ipairs(keys) do
+            items[i] = format("%q:%s", k, toJson(value[k]))
+        end
+        return "{"..concat(items, ",").."}"
+    elseif t == "number" then
+        if value ~= value or value == math.huge or value == -math.huge then
+            return "null"
+        elseif math.type and math.type(value) == "integer" then
+            return tostring(value)
+        else
+            return format("%.6g", value)
+        end
+    elseif t == "string" then
+        return '"'..value:gsub('[%c"\\]', function(c)
+                                              return format("\\u%04x", c:byte())
+                                          end)..'"'
+    elseif t == "boolean" then
+        return tostring(value)
+    else
+        return "null"
+    end
+end
+benchlib.toJson = toJson
+
+----------------------------------------------------------------------------------------------
+
+local Bench = {}
+Bench.__index = Bench
+
+--[[
+     Creates the world for a scenario. The backend module is loaded
+     according to the first script argument.
+--]]
+function benchlib.new(scenario)
+    local backend = arg and arg[1] or "cairo"
+    local scale   = tonumber(arg and arg[2]) or 1
+    local self = setmetatable({}, Bench)
+    self.scenario = scenario
+    self.backend  = backend
+    self.scale    = scale
+    self.lpugl    = require("lpugl_"..backend)
+    self.world    = self.lpugl.newWorld("bench_"..scenario)
+    self.frames   = {}
+    self.events   = 0
+    self.extra    = {}
+    if backend == "opengl" then
+        local ok, gl = pcall(require, "luagl")
+        self.gl = ok and gl or nil -- without LuaGL only buffer swaps are measured
+    end
+    return self
+end
+
+--[[
+     Options for world:newView() that depend on the backend.
+--]]
+function Bench:viewOptions(options)
+    if self.backend == "opengl" then
+        options.useDoubleBuffer = true
+        options.swapInterval = 0
+    end
+    return options
+end
+
+--[[
+     Fills a rectangle of the view, must be called in the EXPOSE handler.
+--]]
+function Bench:fill(view, r, g, b, x, y, w, h)
+    if not x then
+        x, y = 0, 0
+        w, h = view:getSize()
+    end
+    if self.backend == "cairo" then
+        local cairo = view:getDrawContext()
+        cairo:set_source_rgb(r, g, b)
+        cairo:rectangle(x, y, w, h)
+        cairo:fill()
+    elseif self.gl then
+        local gl = self.gl
+        local _, vh = view:getSize()
+        gl.Enable("SCISSOR_TEST")
+        gl.Scissor(x, vh - y - h, w, h)
+        gl.ClearColor(r, g, b, 1)
+        gl.Clear("COLOR_BUFFER_BIT")
+        gl.Disable("SCISSOR_TEST")
+    end
+end
+
+function Bench:start()
+    collectgarbage()
+    self.startTime  = self.world:getTime()
+    self.startClock = os.clock()
+    self.lastFrame  = self.startTime
+end
+
+--[[
+     Records the duration since the last call (or since start())
+     as frame time.
+--]]
+function Bench:frame()
+    local now = self.world:getTime()
+    self.frames[#self.frames + 1] = now - self.lastFrame
+    self.lastFrame = now
+end
+
+function Bench:count(n)
+    self.events = self.events + (n or 1)
+end
+
+function Bench:set(key, value)
+    self.extra[key] = value
+end
+
+--[[
+     Prints the JSON result line and closes the world.
+--]]
+function Bench:finish()
+    local wallTime = self.world:getTime() - self.startTime
+    local cpuTime  = os.clock() - self.startClock
+    local rss, hwm = readRss()
+    local frames   = {}
+    for i, t in ipairs(self.frames) do frames[i] = t end
+    sort(frames)
+    local result = {
+        scenario       = self.scenario,
+        backend        = self.backend,
+        scale          = self.scale,
+        wall_s         = wallTime,
+        cpu_s          = cpuTime,
+        events         = self.events,
+        events_per_s   = wallTime > 0 and self.events / wallTime or nil,
+        frames         = #frames,
+        frame_p50_ms   = frames[1] and percentile(frames, 0.50) * 1000,
+        frame_p99_ms   = frames[1] and percentile(frames, 0.99) * 1000,
+        rss_kb         = rss,
+        rss_peak_kb    = hwm,
+    }
+    for k, v in pairs(self.extra) do
+        result[k] = v
+    end
+    self.world:close()
+    io.write(toJson(result), "\n")
+    io.flush()
+end
+
+----------------------------------------------------------------------------------------------
+
+return benchlib
@@ -0,0 +1,90 @@
+package.path = (arg[0]:match("^(.*[/\\])") or "./").."?.lua;"..package.path
+local benchlib  = require"benchlib"
+local llthreads = require"llthreads2.ex"
+
+----------------------------------------------------------------------------------------------
+
+local bench = benchlib.new("channel_throughput")
+local world = bench.world
+
+local THREAD_COUNT = 4
+local MSG_COUNT    = 100000 * bench.scale
+local MODE         = os.getenv("CHANNEL_MODE") or "channel" -- "channel" or "mtmsg"
+
+----------------------------------------------------------------------------------------------
+
+-- background threads are sending small messages as fast as possible, the main
+-- loop counts the received messages. With CHANNEL_MODE=mtmsg the messages are
+-- sent through an mtmsg buffer with world:awake() for comparison.
+
+local received = 0
+local batches  = 0
+
+local view = world:newView(bench:viewOptions {
+    title     = "channel_throughput",
+    size      = { 200, 100 },
+    eventFunc = function(view, event, ...) end
+})
+view:show()
+while world:update(0.1) do end
+
+local threadFunc, targetId
+
+if MODE == "mtmsg" then
+    local mtmsg  = require("mtmsg")
+    local buffer = mtmsg.newbuffer()
+    buffer:nonblock(true)
+    world:setProcessFunc(function()
+        batches = batches + 1
+        while buffer:nextmsg() do
+            received = received + 1
+        end
+        bench:frame()
+    end)
+    targetId   = buffer:id()
+    threadFunc = function(worldId, bufferId, count)
+                     local lpugl  = require("lpugl")
+                     local mtmsg  = require("mtmsg")
+                     local world  = lpugl.world(worldId)
+                     local buffer = mtmsg.buffer(bufferId)
+                     for i = 1, count do
+                         buffer:addmsg("message")
+                         world:awake()
+                     end
+                 end
+else
+    local channel = world:newChannel(function(...)
+        batches  = batches + 1
+        received = received + select("#", ...)
+        bench:frame()
+    end)
+    targetId   = channel:id()
+    threadFunc = function(worldId, channelId, count)
+                     local lpugl   = require("lpugl")
+                     local channel = lpugl.channel(channelId)
+                     for i = 1, count do
+                         channel:push("message")
+                     end
+                 end
+end
+
+local threads = {}
+for i = 1, THREAD_COUNT do
+    threads[i] = llthreads.new(threadFunc, world:id(), targetId, MSG_COUNT)
+end
+
+bench:start()
+for i = 1, THREAD_COUNT do
+    threads[i]:start()
+end
+while received < THREAD_COUNT * MSG_COUNT do
+    world:update(0.01)
+end
+for i = 1, THREAD_COUNT do
+    threads[i]:join()
+end
+bench:count(received)
+bench:set("mode", MODE)
+bench:set("threads", THREAD_COUNT)
+bench:set("batches", batches)
+bench:finish()
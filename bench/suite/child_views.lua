@@ -0,0 +1,66 @@
+package.path = (arg[0]:match("^(.*[/\\])") or "./").."?.lua;"..package.path
+local benchlib = require"benchlib"
+
+----------------------------------------------------------------------------------------------
+
+local bench = benchlib.new("child_views")
+local world = bench.world
+
+local CHILD_COUNT = 100
+local FRAME_COUNT = 200 * bench.scale
+local CELL_SIZE   = 40
+
+----------------------------------------------------------------------------------------------
+
+local exposed = 0
+
+local function childEventFunc(view, event, ...)
+    if event == "EXPOSE" then
+        exposed = exposed + 1
+        local c = exposed % 256 / 255
+        bench:fill(view, c, 0.5, 1 - c)
+    end
+    bench:count()
+end
+
+local columns = 10
+local main = world:newView(bench:viewOptions {
+    title     = "child_views",
+    size      = { columns * CELL_SIZE, math.floor(CHILD_COUNT / columns) * CELL_SIZE },
+    eventFunc = function(view, event, ...)
+        if event == "EXPOSE" then
+            bench:fill(view, 0, 0, 0)
+        end
+    end
+})
+
+local children = {}
+for i = 1, CHILD_COUNT do
+    local child = world:newView(bench:viewOptions {
+        parent    = main,
+        frame     = { (i - 1) % columns * CELL_SIZE + 1,
+                      math.floor((i - 1) / columns) * CELL_SIZE + 1,
+                      CELL_SIZE - 2, CELL_SIZE - 2 },
+        eventFunc = childEventFunc
+    })
+    child:show()
+    children[i] = child
+end
+main:show()
+while world:update(0.1) do end
+
+-- every frame all child views are redrawn
+
+bench:start()
+for frame = 1, FRAME_COUNT do
+    for i = 1, CHILD_COUNT do
+        children[i]:postRedisplay()
+    end
+    exposed = 0
+    while exposed < CHILD_COUNT do
+        world:update(1)
+    end
+    bench:frame()
+end
+bench:set("views", CHILD_COUNT)
+bench:finish()
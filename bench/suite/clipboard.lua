@@ -0,0 +1,57 @@
+package.path = (arg[0]:match("^(.*[/\\])") or "./").."?.lua;"..package.path
+local benchlib = require"benchlib"
+
+----------------------------------------------------------------------------------------------
+
+local bench = benchlib.new("clipboard")
+local world = bench.world
+
+local PAYLOAD_SIZES = { 1024, 64 * 1024, 1024 * 1024, 8 * 1024 * 1024 }
+local REPEAT        = 5 * bench.scale
+local TIMEOUT       = 10
+
+----------------------------------------------------------------------------------------------
+
+local received
+
+local view = world:newView(bench:viewOptions {
+    title     = "clipboard",
+    size      = { 200, 100 },
+    eventFunc = function(view, event, ...)
+        if event == "DATA_RECEIVED" then
+            received = ...
+        end
+    end
+})
+view:show()
+while world:update(0.1) do end
+
+-- the payload is set and requested by the same world, i.e. it goes
+-- through the display server in both directions
+
+local totalBytes = 0
+local timeouts   = 0
+
+bench:start()
+for _, size in ipairs(PAYLOAD_SIZES) do
+    local payload = string.rep("0123456789abcdef", math.floor(size / 16))
+    for i = 1, REPEAT do
+        world:setClipboard(payload)
+        received = nil
+        view:requestClipboard()
+        local deadline = world:getTime() + TIMEOUT
+        while not received and world:getTime() < deadline do
+            world:update(0.1)
+        end
+        if received and #received == #payload then
+            totalBytes = totalBytes + size
+            bench:count()
+        else
+            timeouts = timeouts + 1
+        end
+        bench:frame()
+    end
+end
+bench:set("bytes_per_s", totalBytes / (world:getTime() - bench.startTime))
+bench:set("failed_transfers", timeouts)
+bench:finish()
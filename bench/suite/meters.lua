@@ -0,0 +1,66 @@
+package.path = (arg[0]:match("^(.*[/\\])") or "./").."?.lua;"..package.path
+local benchlib = require"benchlib"
+
+----------------------------------------------------------------------------------------------
+
+local bench = benchlib.new("meters")
+local world = bench.world
+
+local METER_COUNT    = 64
+local CHANGED_METERS = 8
+local FRAME_COUNT    = 1000 * bench.scale
+local METER_WIDTH    = 12
+local METER_HEIGHT   = 200
+
+----------------------------------------------------------------------------------------------
+
+-- only a few meters change per frame and only their rectangles are redisplayed
+
+local levels  = {}
+local exposed = false
+
+for i = 1, METER_COUNT do
+    levels[i] = 0
+end
+
+local view = world:newView(bench:viewOptions {
+    title          = "meters",
+    size           = { METER_COUNT * METER_WIDTH, METER_HEIGHT },
+    dontMergeRects = true,
+    partialPresent = bench.backend == "opengl" or nil,
+    eventFunc      = function(view, event, ...)
+        if event == "EXPOSE" then
+            local x, y, w, h = ...
+            local first = math.floor(x / METER_WIDTH) + 1
+            local last  = math.min(METER_COUNT, math.floor((x + w - 1) / METER_WIDTH) + 1)
+            for i = first, last do
+                local level = levels[i] * METER_HEIGHT
+                bench:fill(view, 0.1, 0.1, 0.1, (i - 1) * METER_WIDTH, 0, METER_WIDTH, METER_HEIGHT - level)
+                bench:fill(view, 0.2, 0.9, 0.2, (i - 1) * METER_WIDTH, METER_HEIGHT - level, METER_WIDTH, level)
+            end
+            bench:count()
+            exposed = true
+        end
+    end
+})
+view:show()
+while world:update(0.1) do end
+
+math.randomseed(1)
+
+bench:start()
+for frame = 1, FRAME_COUNT do
+    for j = 1, CHANGED_METERS do
+        local i = math.random(METER_COUNT)
+        levels[i] = math.random()
+        view:postRedisplay((i - 1) * METER_WIDTH, 0, METER_WIDTH, METER_HEIGHT)
+    end
+    exposed = false
+    while not exposed do
+        world:update(1)
+    end
+    bench:frame()
+end
+bench:set("meters", METER_COUNT)
+bench:set("changed_per_frame", CHANGED_METERS)
+bench:finish()
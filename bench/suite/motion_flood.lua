@@ -0,0 +1,59 @@
+package.path = (arg[0]:match("^(.*[/\\])") or "./").."?.lua;"..package.path
+local benchlib = require"benchlib"
+
+----------------------------------------------------------------------------------------------
+
+local bench = benchlib.new("motion_flood")
+local world = bench.world
+local lpugl = bench.lpugl
+
+local EVENT_COUNT = 200000 * bench.scale
+local BATCH_SIZE  = 1000
+
+----------------------------------------------------------------------------------------------
+
+local motionCount = 0
+local exposeCount = 0
+
+local view = world:newView(bench:viewOptions {
+    title     = "motion_flood",
+    size      = { 400, 400 },
+    eventFunc = function(view, event, ...)
+        if event == "MOTION" then
+            motionCount = motionCount + 1
+            local x, y = ...
+            view:postRedisplay(x - 2, y - 2, 4, 4)
+        elseif event == "EXPOSE" then
+            exposeCount = exposeCount + 1
+            bench:fill(view, 0.5, 0.5, 0.5, ...)
+        end
+    end
+})
+view:show()
+while world:update(0.1) do end
+
+-- synthetic motion events are dispatched through the same path as X11 events,
+-- alternating modifier state prevents coalescing of the injected motions
+
+local batches = {}
+for b = 1, math.floor(EVENT_COUNT / BATCH_SIZE) do
+    local records = {}
+    for i = 1, BATCH_SIZE do
+        local n = (b - 1) * BATCH_SIZE + i
+        records[i] = string.pack("=i4i4dddd", 1, lpugl.EVENT_MOTION,
+                                              n % 400, math.floor(n / 400) % 400,
+                                              n % 2 * lpugl.MOD_SHIFT, 0)
+    end
+    batches[b] = table.concat(records)
+end
+
+bench:start()
+for b = 1, #batches do
+    world:injectEvents(batches[b], view)
+    world:update(0)
+    bench:frame()
+end
+bench:count(motionCount)
+bench:set("exposures", exposeCount)
+bench:set("batch_size", BATCH_SIZE)
+bench:finish()
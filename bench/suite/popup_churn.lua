@@ -0,0 +1,62 @@
+package.path = (arg[0]:match("^(.*[/\\])") or "./").."?.lua;"..package.path
+local benchlib = require"benchlib"
+
+----------------------------------------------------------------------------------------------
+
+local bench = benchlib.new("popup_churn")
+local world = bench.world
+
+local POPUP_COUNT = 200 * bench.scale
+local POOL_SIZE   = tonumber(os.getenv("VIEW_POOL_SIZE")) or 0 -- reuse closed popups if > 0
+
+----------------------------------------------------------------------------------------------
+
+local exposed = false
+
+local main = world:newView(bench:viewOptions {
+    title     = "popup_churn",
+    size      = { 400, 300 },
+    eventFunc = function(view, event, ...)
+        if event == "EXPOSE" then
+            bench:fill(view, 0.9, 0.9, 0.9)
+        end
+    end
+})
+main:show()
+while world:update(0.1) do end
+
+local function popupEventFunc(view, event, ...)
+    if event == "EXPOSE" then
+        bench:fill(view, 1, 1, 0.8)
+        exposed = true
+    end
+end
+
+-- each popup is created, shown until its first exposure and closed again
+
+local mx, my = main:getFrame()
+
+if POOL_SIZE > 0 then
+    world:setViewPoolSize(POOL_SIZE)
+    world:fillViewPool(1, { useDoubleBuffer = bench.backend == "opengl" })
+end
+bench:set("view_pool_size", POOL_SIZE)
+
+bench:start()
+for i = 1, POPUP_COUNT do
+    local popup = world:newView(bench:viewOptions {
+        popupFor  = main,
+        frame     = { mx + i % 200, my + i % 100, 150, 200 },
+        eventFunc = popupEventFunc
+    })
+    exposed = false
+    popup:show()
+    while not exposed do
+        world:update(1)
+    end
+    popup:close()
+    world:update(0)
+    bench:count()
+    bench:frame()
+end
+bench:finish()
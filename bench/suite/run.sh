@@ -0,0 +1,47 @@
+#!/bin/sh
+#
+# Runs all benchmark scenarios under Xvfb and writes the results as JSON.
+#
+# Usage: run.sh [output.json] [scale]
+#
+# Environment:
+#   LUA        - Lua interpreter (default: lua)
+#   BACKENDS   - backends to run (default: "cairo opengl")
+#   SCENARIOS  - scenarios to run (default: all)
+#   XVFB       - set to empty to run on the current display
+#
+# The OpenGL backend is forced to software rendering with Mesa llvmpipe so that
+# results are comparable between machines.
+
+DIR=$(cd "$(dirname "$0")" && pwd)
+OUTPUT=${1:-bench_results.json}
+SCALE=${2:-1}
+LUA=${LUA:-lua}
+BACKENDS=${BACKENDS:-cairo opengl}
+SCENARIOS=${SCENARIOS:-child_views motion_flood animation meters popup_churn clipboard awake_storm channel_throughput}
+XVFB=${XVFB-xvfb-run -a -s "-screen 0 1920x1080x24"}
+
+export LIBGL_ALWAYS_SOFTWARE=1
+export GALLIUM_DRIVER=llvmpipe
+
+VERSION=$($LUA -e 'print(require"lpugl"._VERSION or "")' 2>/dev/null)
+
+{
+    printf '{"version":"%s","date":"%s","results":[\n' "$VERSION" "$(date "+%Y-%m-%dT%H:%M:%S")"
+    SEP=""
+    for BACKEND in $BACKENDS; do
+        for SCENARIO in $SCENARIOS; do
+            echo "running $SCENARIO ($BACKEND)" >&2
+            LINE=$(eval "$XVFB" '$LUA "$DIR/$SCENARIO.lua" $BACKEND $SCALE' | tail -n 1)
+            if [ -z "$LINE" ]; then
+                LINE=$(printf '{"scenario":"%s","backend":"%s","error":true}' "$SCENARIO" "$BACKEND")
+            fi
+            printf '%s%s' "$SEP" "$LINE"
+            SEP=",
+"
+        done
+    done
+    printf '\n]}\n'
+} > "$OUTPUT"
+
+echo "results written to $OUTPUT" >&2
@@ -0,0 +1,84 @@
+local lpugl     = require"lpugl"
+local llthreads = require"llthreads2.ex"
+
+----------------------------------------------------------------------------------------------
+
+local THREAD_COUNT = tonumber(arg and arg[1]) or 200
+local LOOKUP_COUNT = tonumber(arg and arg[2]) or 10000
+local WORLD_COUNT  = tonumber(arg and arg[3]) or 16
+
+----------------------------------------------------------------------------------------------
+
+-- Stress test for the world registry: many threads look up worlds by id via
+-- lpugl.world(id) and awake them while the main thread closes and creates worlds.
+-- Lookups of closed worlds are expected to fail.
+
+local worlds = {}
+local ids    = {}
+for i = 1, WORLD_COUNT do
+    worlds[i] = lpugl.newWorld("world_registry.lua")
+    ids[i]    = worlds[i]:id()
+end
+
+local threads = {}
+for i = 1, THREAD_COUNT do
+    threads[i] = llthreads.new(function(count, ...)
+                                   local lpugl  = require("lpugl")
+                                   local ids    = { ... }
+                                   local found  = 0
+                                   local failed = 0
+                                   for i = 1, count do
+                                       local id = ids[(i % #ids) + 1]
+                                       local ok, world = pcall(lpugl.world, id)
+                                       if ok then
+                                           world:awake()
+                                           found = found + 1
+                                       else
+                                           failed = failed + 1
+                                       end
+                                   end
+                                   return found, failed
+                               end,
+                               LOOKUP_COUNT, (table.unpack or unpack)(ids))
+end
+
+local t0 = worlds[1]:getTime()
+for i = 1, THREAD_COUNT do
+    threads[i]:start()
+end
+
+local running = THREAD_COUNT
+local churn   = 0
+while running > 0 do
+    -- replace one world
+    churn = churn + 1
+    local i = (churn % WORLD_COUNT) + 1
+    worlds[i]:close()
+    worlds[i] = lpugl.newWorld("world_registry.lua")
+    for j = 1, WORLD_COUNT do
+        worlds[j]:update(0)
+    end
+    running = 0
+    for j = 1, THREAD_COUNT do
+        if threads[j]:alive() then
+            running = running + 1
+        end
+    end
+end
+local wall = worlds[1]:getTime() - t0
+
+local found, failed = 0, 0
+for i = 1, THREAD_COUNT do
+    local ok, f1, f2 = threads[i]:join()
+    assert(ok, f1)
+    found  = found  + f1
+    failed = failed + f2
+end
+for i = 1, WORLD_COUNT do
+    worlds[i]:close()
+end
+
+print(string.format("%s, %d threads, %d worlds, %d worlds replaced", 
+                    _VERSION, THREAD_COUNT, WORLD_COUNT, churn))
+print(string.format("%d lookups (%d failed) in %.3f s, %.0f lookups/s", 
+                    found + failed, failed, wall, (found + failed) / wall))
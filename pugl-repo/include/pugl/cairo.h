@@ -48,6 +48,42 @@ PUGL_API
 void*
 puglCairoBackendGetNativeWorld(PuglWorld* world);
 
+/**
+   Copy a region of the current view contents into a new image surface.
+
+   Returns a `cairo_surface_t*` with format `CAIRO_FORMAT_RGB24` that must be
+   destroyed by the caller, or NULL if this is not supported on the platform.
+   The region must be inside the view frame.
+*/
+PUGL_API
+void*
+puglCairoBackendSnapshot(PuglView* view, PuglRect rect);
+
+/**
+   Function that paints the damaged region of a view before it is presented.
+
+   Called when leaving the exposure with the Cairo context of the view, which
+   is clipped to the damaged region and still holds what was drawn while
+   processing the exposure.  `rects` contains `numRects` rectangles that
+   cover the damaged region, `frame` is the current frame of the view.
+*/
+typedef void (*PuglCairoPaintFunc)(PuglView*       view,
+                                   void*           data,
+                                   void*           cairoContext,
+                                   const PuglRect* rects,
+                                   int             numRects,
+                                   PuglRect        frame);
+
+/**
+   Set a function that paints the view at the end of every exposure.
+
+   The view must be realised.  Returns #PUGL_UNSUPPORTED_TYPE if the platform
+   does not support paint functions.
+*/
+PUGL_API
+PuglStatus
+puglSetCairoPaintFunc(PuglView* view, PuglCairoPaintFunc func, void* data);
+
 /**
    @}
 */
@@ -98,6 +98,85 @@ PUGL_CONST_API
 const PuglBackend*
 puglGlBackend(void);
 
+/**
+   Cache for framebuffer configurations of OpenGL views.
+
+   Views that are configured with the same cache and identical graphics hints
+   reuse the framebuffer configuration that was negotiated for the first of
+   these views.  Pass the cache to puglSetBackendData() before realising a
+   view.
+*/
+typedef struct PuglGlConfigCacheImpl PuglGlConfigCache;
+
+/**
+   Create a new framebuffer configuration cache.
+
+   Returns NULL if the platform does not support caching.
+*/
+PUGL_API
+PuglGlConfigCache*
+puglNewGlConfigCache(void);
+
+/**
+   Free a framebuffer configuration cache.
+
+   The cache must not be used by any view that is not yet realised.
+*/
+PUGL_API
+void
+puglFreeGlConfigCache(PuglGlConfigCache* cache);
+
+/**
+   Function that requests a frame for a view with a detached context.
+
+   Called on the thread that dispatches events.  With an exposure, this is
+   called after the exposure was dispatched and should request rendering of a
+   frame with the size of `frame` on another thread.  With NULL, the context
+   of the view is about to be destroyed or the frame function is about to be
+   removed, and the function must not return before the other thread has
+   finished using the context.
+*/
+typedef void (*PuglGlFrameFunc)(PuglView*              view,
+                                void*                  data,
+                                const PuglEventExpose* expose,
+                                PuglRect               frame);
+
+/**
+   Set the frame function of a view.
+
+   The view must be realised.  While a frame function is set, the context of
+   the view is detached from event handling: exposures are dispatched without
+   entering the context and without presenting, so that the frames can be
+   rendered by another thread between puglEnterGlFrame() and
+   puglLeaveGlFrame().  puglEnterContext() fails for the view.  If a previous
+   frame function is replaced or removed with NULL, it is called with NULL
+   before.  On X11, puglInitApplication() must have been called with
+   #PUGL_APPLICATION_THREADS.
+
+   Returns #PUGL_UNSUPPORTED_TYPE if the platform does not support drawing
+   from other threads.
+*/
+PUGL_API
+PuglStatus
+puglSetGlFrameFunc(PuglView* view, PuglGlFrameFunc func, void* data);
+
+/**
+   Enter the detached context of a view for rendering a frame.
+
+   May only be called by one thread at a time for each view.
+*/
+PUGL_API
+PuglStatus
+puglEnterGlFrame(PuglView* view);
+
+/**
+   Leave the detached context of a view, presenting the rendered frame if
+   `present` is true.
+*/
+PUGL_API
+PuglStatus
+puglLeaveGlFrame(PuglView* view, bool present);
+
 /**
    Return a pointer to the native handle of the world.
 
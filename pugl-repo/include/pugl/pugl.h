@@ -227,6 +227,7 @@ typedef enum {
   PUGL_LOOP_LEAVE,     ///< Recursive loop left, a #PuglEventLoopLeave
   PUGL_MUST_FREE,      ///< puglFreeView() must be called, a #PuglEventAny
   PUGL_DATA_RECEIVED,  ///< Clipboard/Selection data received
+  PUGL_VISIBILITY_CHANGED, ///< View obscured or unobscured, a #PuglEventVisibility
 
 #ifndef PUGL_DISABLE_DEPRECATED
   PUGL_ENTER_NOTIFY  PUGL_DEPRECATED_BY("PUGL_POINTER_IN")  = PUGL_POINTER_IN,
@@ -532,6 +533,18 @@ typedef struct {
   size_t        len;
 } PuglEventReceived;
 
+/**
+   Visibility change event.
+
+   This event is sent when a mapped view becomes fully obscured by other
+   windows or becomes (partially) visible again.  Currently only sent on X11.
+*/
+typedef struct {
+  PuglEventType type;    ///< #PUGL_VISIBILITY_CHANGED.
+  uint32_t      flags;   ///< Bitwise OR of PuglEventFlag values.
+  bool          visible; ///< False if the view is fully obscured.
+} PuglEventVisibility;
+
 /**
    Recursive loop enter event.
 
@@ -588,6 +601,7 @@ typedef union {
   PuglEventFocus     focus;     ///< #PUGL_FOCUS_IN, #PUGL_FOCUS_OUT
   PuglEventClient    client;    ///< #PUGL_CLIENT
   PuglEventReceived  received;  ///< #PUGL_DATA_RECEIVED
+  PuglEventVisibility visibility; ///< #PUGL_VISIBILITY_CHANGED
 } PuglEvent;
 
 
@@ -699,7 +713,17 @@ typedef enum {
 
      - X11: Calls XInitThreads() which is required for some drivers.
   */
-  PUGL_WORLD_THREADS = 1u << 0u
+  PUGL_WORLD_THREADS = 1u << 0u,
+
+  /**
+     Share the connection to the display with other worlds of this thread.
+
+     - X11: All worlds created with this flag in the same thread use one
+       display connection and input method. Each world reads events from the
+       connection and queues events for windows of other worlds, which are
+       dispatched by the next puglUpdate() of the owning world.
+  */
+  PUGL_WORLD_SHARED_DISPLAY = 1u << 1u
 } PuglWorldFlag;
 
 /// Bitwise OR of #PuglWorldFlag values
@@ -874,6 +898,60 @@ PUGL_API
 void
 puglAwake(PuglWorld* world);
 
+/**
+   Return a file descriptor that becomes readable if the world has events to
+   process, e.g. for integrating the world into the event loop of a host.
+
+   X11: Returns an epoll file descriptor (only on Linux) for the display
+   connection and the awake pipe.
+
+   MacOS, Windows: Returns -1.
+
+   Events that are already read from the file descriptor but not yet
+   dispatched do not make it readable, see puglGetNextDeadline().
+*/
+PUGL_API
+int
+puglGetPollFd(PuglWorld* world);
+
+/**
+   Return the time in seconds when puglUpdate() has to be called at the latest
+   even if the poll file descriptor is not readable.
+
+   Returns the current time if there are pending events that were already
+   read and -1 if there is no deadline. Also flushes pending output to the
+   window system, so this should be called before the host starts waiting.
+*/
+PUGL_API
+double
+puglGetNextDeadline(PuglWorld* world);
+
+/**
+   Start or stop watching a file descriptor for readability.
+
+   While a watched file descriptor is readable, puglUpdate() does not wait and
+   the world's process function is called. The caller is responsible for
+   reading from the file descriptor or for stopping to watch it.
+
+   X11: Supported.
+
+   MacOS, Windows: Returns #PUGL_UNSUPPORTED_TYPE.
+*/
+PUGL_API
+PuglStatus
+puglWatchFd(PuglWorld* world, int fd, bool watch);
+
+/**
+   Returns true if input events (keyboard, pointer or crossing events) are
+   waiting to be dispatched or if the world was awakened.
+
+   Does not block and does not dispatch or remove any events. Can be called
+   while drawing to check if rendering should be interrupted.
+*/
+PUGL_API
+bool
+puglHasPendingInput(PuglWorld* world);
+
 /**
    @}
    @defgroup view View
@@ -938,6 +1016,10 @@ typedef enum {
   PUGL_REFRESH_RATE,          ///< Refresh rate in Hz
   PUGL_IS_POPUP,              ///< True if window is popup window
   PUGL_DONT_MERGE_RECTS,      ///< True if redraw rects are not merged
+  PUGL_PARTIAL_PRESENT,       ///< True if only redraw rects are presented
+  PUGL_MAX_FRAMES_IN_FLIGHT,  ///< Maximum number of queued frames, 0 if unlimited
+  PUGL_SKIP_STALE_EXPOSE,     ///< True if drawing is deferred for pending input
+  PUGL_ADAPTIVE_SYNC,         ///< True if late buffer swaps are not synchronized
 
   PUGL_NUM_VIEW_HINTS
 } PuglViewHint;
@@ -1018,6 +1100,17 @@ PUGL_API
 PuglStatus
 puglSetBackend(PuglView* view, const PuglBackend* backend);
 
+/**
+   Set backend specific data for a view.
+
+   The data is owned by the caller and must stay valid until the view is
+   realised.  Its meaning depends on the backend, see for example
+   puglNewGlConfigCache().
+*/
+PUGL_API
+PuglStatus
+puglSetBackendData(PuglView* view, void* backendData);
+
 /// Set the function to call when an event occurs
 PUGL_API
 PuglStatus
@@ -1248,6 +1341,39 @@ PUGL_API
 void*
 puglGetContext(PuglView* view);
 
+/**
+   Get the age of the back buffer.
+
+   This is only meaningful during an expose.  A value n > 0 means that the
+   back buffer contains the frame that was presented n frames ago, so only the
+   regions that changed since then need to be redrawn.  A value of 0 means
+   that the contents are undefined.
+
+   OpenGL: Uses GLX_EXT_buffer_age if available.
+
+   All other backends: returns -1.
+*/
+PUGL_API
+int
+puglGetBufferAge(const PuglView* view);
+
+/**
+   Set the swap interval of a view.
+
+   In contrast to setting the hint #PUGL_SWAP_INTERVAL, this also changes the
+   swap interval of an already realized view.  A negative value requests
+   adaptive synchronization, i.e. late swaps are not synchronized to the
+   vertical blank.  If this is not supported, the absolute value is used.
+   The effective swap interval can be obtained as hint #PUGL_SWAP_INTERVAL,
+   which is never negative, and the hint #PUGL_ADAPTIVE_SYNC.
+
+   @return #PUGL_UNSUPPORTED_TYPE if the backend does not support changing the
+   swap interval.
+*/
+PUGL_API
+PuglStatus
+puglSetSwapInterval(PuglView* view, int interval);
+
 /**
    Request a redisplay for the entire view.
 
@@ -1271,6 +1397,37 @@ PUGL_API
 PuglStatus
 puglPostRedisplayRect(PuglView* view, PuglRect rect);
 
+/**
+   Discard all pending redisplay requests of the view.
+
+   The pending expose event and its redisplay rectangles are dropped, so that a
+   hidden view that is reused is exposed like a newly created view when it is
+   shown again.  This must not be called while the view is drawing.
+*/
+PUGL_API
+PuglStatus
+puglDiscardRedisplay(PuglView* view);
+
+/**
+   Move the contents of a rectangle within the view.
+
+   The pixels within `rect` are moved by `dx` and `dy`.  Only the strips that
+   are uncovered by the movement are requested for redisplay, together with
+   pending redisplay regions within `rect`, which are moved accordingly.  This
+   must not be called while the view is drawing.
+
+   Cairo: The pixels are copied immediately.
+
+   OpenGL: The pixels are copied with glBlitFramebuffer() from the front buffer
+   before the next expose.  Only supported for double buffered views.
+
+   If the backend cannot move the pixels, the whole rectangle is requested for
+   redisplay and #PUGL_UNSUPPORTED_TYPE is returned.
+*/
+PUGL_API
+PuglStatus
+puglScrollContents(PuglView* view, PuglRect rect, int dx, int dy);
+
 /**
    Get the screen scaling factor for the view.
 */
@@ -1403,6 +1560,58 @@ PUGL_API
 PuglStatus
 puglSendEvent(PuglView* view, const PuglEvent* event);
 
+/**
+   An event for puglInjectEvents() together with its target view.
+*/
+typedef struct {
+  PuglView* view;  ///< Target view, entries without view are ignored
+  PuglEvent event; ///< Event to be injected
+} PuglInjectedEvent;
+
+/**
+   Inject events into the event processing of the world.
+
+   The events are processed synchronously in the same way as events received
+   from the window system: expose events are merged into the pending exposure
+   of the view and configure events are deferred to the end of the event
+   processing.  Consecutive motion events for the same view with the same
+   modifier state are coalesced, i.e. only the last one is dispatched.
+
+   If this function is called outside of event processing, pending configure
+   and expose events are dispatched before this function returns.
+
+   The data of injected #PUGL_DATA_RECEIVED events and the text input of
+   #PUGL_KEY_PRESS events with more than 8 bytes must be allocated with
+   malloc(), it is freed after dispatching the event.
+*/
+PUGL_API
+PuglStatus
+puglInjectEvents(PuglWorld*               world,
+                 const PuglInjectedEvent* events,
+                 size_t                   count);
+
+/**
+   A function called for every event received from the window system.
+*/
+typedef void (*PuglRecordFunc)(PuglView*        view,
+                               const PuglEvent* event,
+                               void*            userData);
+
+/**
+   Set a function that is called for every event that has been received
+   from the window system, before the event is processed.
+
+   This can be used for recording input events.  Events that are injected
+   with puglInjectEvents() are not passed to this function.
+
+   Currently this is only supported on X11, Windows and headless platforms.
+*/
+PUGL_API
+void
+puglSetRecordFunc(PuglWorld*     world,
+                  PuglRecordFunc recordFunc,
+                  void*          userData);
+
 /**
    @}
 */
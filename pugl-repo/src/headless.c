@@ -0,0 +1,925 @@
+/*
+  Permission to use, copy, modify, and/or distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THIS SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef _POSIX_C_SOURCE
+#  define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "headless.h"
+
+#include "implementation.h"
+#include "rect.h"
+#include "types.h"
+
+#include "pugl/pugl.h"
+
+#include <sys/select.h>
+#include <sys/time.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef MIN
+#  define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifndef MAX
+#  define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+PuglStatus
+puglInitApplication(PuglApplicationFlags PUGL_UNUSED(flags))
+{
+  return PUGL_SUCCESS;
+}
+
+PuglWorldInternals*
+puglInitWorldInternals(PuglWorldType PUGL_UNUSED(type),
+                       PuglWorldFlags PUGL_UNUSED(flags))
+{
+  PuglWorldInternals* impl =
+    (PuglWorldInternals*)calloc(1, sizeof(PuglWorldInternals));
+  if (!impl) {
+    return NULL;
+  }
+
+  if (pipe(impl->awake_fds) == 0) {
+    fcntl(impl->awake_fds[1],
+          F_SETFL,
+          fcntl(impl->awake_fds[1], F_GETFL) | O_NONBLOCK);
+  } else {
+    impl->awake_fds[0] = -1;
+  }
+
+  const char* virtualTime = getenv("PUGL_HEADLESS_VIRTUAL_TIME");
+
+  impl->virtualTime     = virtualTime && virtualTime[0] &&
+                      strcmp(virtualTime, "0") != 0;
+  impl->nextProcessTime = -1;
+
+  return impl;
+}
+
+void*
+puglGetNativeWorld(PuglWorld* PUGL_UNUSED(world))
+{
+  return NULL;
+}
+
+PuglStatus
+puglSetClassName(PuglWorld* const world, const char* name)
+{
+  puglSetString(&world->className, name);
+  return PUGL_SUCCESS;
+}
+
+PuglInternals*
+puglInitViewInternals(void)
+{
+  PuglInternals* impl = (PuglInternals*)calloc(1, sizeof(PuglInternals));
+  if (!impl) {
+    return NULL;
+  }
+  impl->cursor = PUGL_CURSOR_ARROW;
+
+  return impl;
+}
+
+static PuglStatus
+puglHeadlessQueueEvent(PuglView* view, const PuglEvent* event)
+{
+  PuglWorldInternals* const impl = view->world->impl;
+
+  if (impl->eventsHead > 0 && impl->eventsHead == impl->eventsCount) {
+    impl->eventsHead  = 0;
+    impl->eventsCount = 0;
+  }
+  if (impl->eventsCount == impl->eventsCapacity) {
+    const size_t             capacity = MAX(16, 2 * impl->eventsCapacity);
+    PuglHeadlessQueuedEvent* events   = (PuglHeadlessQueuedEvent*)realloc(
+      impl->events, capacity * sizeof(PuglHeadlessQueuedEvent));
+    if (!events) {
+      return PUGL_UNKNOWN_ERROR;
+    }
+    impl->events         = events;
+    impl->eventsCapacity = capacity;
+  }
+
+  PuglHeadlessQueuedEvent* const queued = impl->events + impl->eventsCount++;
+
+  queued->view  = view;
+  queued->event = *event;
+  return PUGL_SUCCESS;
+}
+
+static void
+puglHeadlessQueueSimpleEvent(PuglView* view, const PuglEventType type)
+{
+  PuglEvent event;
+  puglClearEventStruct(&event, type);
+  puglHeadlessQueueEvent(view, &event);
+}
+
+static void
+puglHeadlessQueueConfigure(PuglView* view)
+{
+  PuglEvent event;
+  puglClearEventStruct(&event, PUGL_CONFIGURE);
+  event.configure.x      = view->reqX;
+  event.configure.y      = view->reqY;
+  event.configure.width  = MAX(view->reqWidth, view->minWidth);
+  event.configure.height = MAX(view->reqHeight, view->minHeight);
+  if (view->maxWidth > 0) {
+    event.configure.width = MIN(event.configure.width, view->maxWidth);
+  }
+  if (view->maxHeight > 0) {
+    event.configure.height = MIN(event.configure.height, view->maxHeight);
+  }
+  puglHeadlessQueueEvent(view, &event);
+}
+
+PuglStatus
+puglRealize(PuglView* view)
+{
+  PuglInternals* const impl = view->impl;
+  PuglStatus           st   = PUGL_SUCCESS;
+
+  if (impl->realized) {
+    return PUGL_FAILURE;
+  }
+
+  if (!view->backend || !view->backend->configure) {
+    return PUGL_BAD_BACKEND;
+  } else if (view->reqWidth <= 0 || view->reqHeight <= 0) {
+    return PUGL_BAD_CONFIGURATION;
+  }
+
+  if ((st = view->backend->configure(view))) {
+    view->backend->destroy(view);
+    return st;
+  }
+
+  if ((st = view->backend->create(view))) {
+    return st;
+  }
+
+  impl->realized    = true;
+  view->frame.x     = view->reqX;
+  view->frame.y     = view->reqY;
+  view->frame.width  = view->reqWidth;
+  view->frame.height = view->reqHeight;
+
+  puglDispatchSimpleEvent(view, PUGL_CREATE);
+  puglHeadlessQueueConfigure(view);
+
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglShow(PuglView* view)
+{
+  PuglStatus st = PUGL_SUCCESS;
+  if (!view->impl->realized) {
+    if ((st = puglRealize(view))) {
+      return st;
+    }
+  }
+
+  if (!view->impl->displayed) {
+    view->impl->displayed = true;
+    puglHeadlessQueueSimpleEvent(view, PUGL_MAP);
+  }
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglHide(PuglView* view)
+{
+  if (view->impl->displayed) {
+    view->impl->displayed = false;
+    puglHeadlessQueueSimpleEvent(view, PUGL_UNMAP);
+  }
+  return PUGL_SUCCESS;
+}
+
+void
+puglFreeViewInternals(PuglView* view)
+{
+  if (view && view->impl) {
+    PuglWorldInternals* const worldImpl = view->world->impl;
+    for (size_t i = worldImpl->eventsHead; i < worldImpl->eventsCount; ++i) {
+      if (worldImpl->events[i].view == view) {
+        worldImpl->events[i].view = NULL;
+      }
+    }
+    if (worldImpl->focusView == view) {
+      worldImpl->focusView = NULL;
+    }
+    if (view->backend) {
+      view->backend->destroy(view);
+    }
+    free(view->impl);
+  }
+}
+
+void
+puglFreeWorldInternals(PuglWorld* world)
+{
+  if (world->impl->awake_fds[0] >= 0) {
+    close(world->impl->awake_fds[0]);
+    close(world->impl->awake_fds[1]);
+  }
+  free(world->impl->events);
+  free(world->impl);
+}
+
+PuglStatus
+puglGrabFocus(PuglView* view)
+{
+  PuglWorldInternals* const impl = view->world->impl;
+  if (impl->focusView != view) {
+    if (impl->focusView) {
+      puglHeadlessQueueSimpleEvent(impl->focusView, PUGL_FOCUS_OUT);
+    }
+    impl->focusView = view;
+    puglHeadlessQueueSimpleEvent(view, PUGL_FOCUS_IN);
+  }
+  return PUGL_SUCCESS;
+}
+
+bool
+puglHasFocus(const PuglView* view)
+{
+  return view->world->impl->focusView == view;
+}
+
+PuglStatus
+puglRequestAttention(PuglView* PUGL_UNUSED(view))
+{
+  return PUGL_SUCCESS;
+}
+
+void
+puglSetProcessFunc(PuglWorld*      world,
+                   PuglProcessFunc processFunc,
+                   void*           userData)
+{
+  world->processFunc     = processFunc;
+  world->processUserData = userData;
+}
+
+void
+puglSetNextProcessTime(PuglWorld* world, double seconds)
+{
+  if (seconds >= 0) {
+    world->impl->nextProcessTime = puglGetTime(world) + seconds;
+  } else {
+    world->impl->nextProcessTime = -1;
+  }
+}
+
+PuglStatus
+puglSendEvent(PuglView* view, const PuglEvent* event)
+{
+  if (event->type == PUGL_NOTHING) {
+    return PUGL_UNSUPPORTED_TYPE;
+  }
+  return puglHeadlessQueueEvent(view, event);
+}
+
+#ifndef PUGL_DISABLE_DEPRECATED
+PuglStatus
+puglWaitForEvent(PuglView* view)
+{
+  return puglUpdate(view->world, -1.0);
+}
+#endif
+
+static void
+mergeExposeEvents(PuglEventExpose* dst, const PuglRect* src)
+{
+  if (!dst->type) {
+    dst->type   = PUGL_EXPOSE;
+    dst->flags  = 0;
+    dst->x      = src->x;
+    dst->y      = src->y;
+    dst->width  = src->width;
+    dst->height = src->height;
+    dst->count  = 0;
+  } else {
+    const double max_x = MAX(dst->x + dst->width, src->x + src->width);
+    const double max_y = MAX(dst->y + dst->height, src->y + src->height);
+
+    dst->x      = MIN(dst->x, src->x);
+    dst->y      = MIN(dst->y, src->y);
+    dst->width  = max_x - dst->x;
+    dst->height = max_y - dst->y;
+  }
+}
+
+static void
+addPendingExpose(PuglView* view, const PuglEventExpose* expose)
+{
+  PuglRect rect = {expose->x, expose->y, expose->width, expose->height};
+  integerRect(&rect);
+  bool added = addRect(&view->rects, &rect);
+  mergeExposeEvents(&view->impl->pendingExpose.expose, &rect);
+  if (!added) {
+    view->rects.rectsList[0].x      = view->impl->pendingExpose.expose.x;
+    view->rects.rectsList[0].y      = view->impl->pendingExpose.expose.y;
+    view->rects.rectsList[0].width  = view->impl->pendingExpose.expose.width;
+    view->rects.rectsList[0].height = view->impl->pendingExpose.expose.height;
+    view->rects.rectsCount          = 1;
+  }
+}
+
+static void
+triggerFullExposure(PuglView* view)
+{
+  PuglRect rect = {0, 0, view->frame.width, view->frame.height};
+  view->impl->pendingExpose.expose.type = PUGL_NOTHING;
+  mergeExposeEvents(&view->impl->pendingExpose.expose, &rect);
+  view->rects.rectsList[0] = rect;
+  view->rects.rectsCount   = 1;
+}
+
+void
+puglAwake(PuglWorld* world)
+{
+  if (world->impl->awake_fds[0] >= 0) {
+    char c = 0;
+    int  PUGL_UNUSED(ignore) = write(world->impl->awake_fds[1], &c, 1);
+  }
+}
+
+bool
+puglHasPendingInput(PuglWorld* world)
+{
+  PuglWorldInternals* const impl = world->impl;
+  const int                 afd  = impl->awake_fds[0];
+
+  if (impl->needsProcessing) {
+    return true;
+  }
+  if (afd >= 0) {
+    fd_set fds;
+    FD_ZERO(&fds); // NOLINT
+    FD_SET(afd, &fds);
+    struct timeval tv = {0, 0};
+    if (select(afd + 1, &fds, NULL, NULL, &tv) > 0) {
+      return true;
+    }
+  }
+  for (size_t i = impl->eventsHead; i < impl->eventsCount; ++i) {
+    switch (impl->events[i].event.type) {
+    case PUGL_KEY_PRESS:
+    case PUGL_KEY_RELEASE:
+    case PUGL_POINTER_IN:
+    case PUGL_POINTER_OUT:
+    case PUGL_BUTTON_PRESS:
+    case PUGL_BUTTON_RELEASE:
+    case PUGL_MOTION:
+    case PUGL_SCROLL:
+      return true;
+    default:
+      break;
+    }
+  }
+  return false;
+}
+
+/// Flush pending configure and expose events for all views
+static void
+flushExposures(PuglWorld* world)
+{
+  int pendingInput = -1; // checked at most once per flush
+
+  for (size_t i = 0; i < world->numViews; ++i) {
+    PuglView* const view = world->views[i];
+
+    if (view->visible) {
+      puglDispatchSimpleEvent(view, PUGL_UPDATE);
+    }
+
+    bool skipExpose = false;
+    if (view->impl->pendingExpose.type && view->hints[PUGL_SKIP_STALE_EXPOSE] &&
+        !view->impl->exposeSkipped) {
+      if (pendingInput < 0) {
+        pendingInput = puglHasPendingInput(world);
+      }
+      skipExpose = pendingInput;
+    }
+    view->impl->exposeSkipped = skipExpose;
+
+    PuglEvent configure = view->impl->pendingConfigure;
+    PuglEvent expose    = view->impl->pendingExpose;
+
+    view->impl->pendingConfigure.type = PUGL_NOTHING;
+    if (skipExpose) {
+      // Keep the expose pending, but draw at the latest in the next flush
+      expose.type = PUGL_NOTHING;
+    } else {
+      view->impl->pendingExpose.type = PUGL_NOTHING;
+    }
+
+    if (configure.type && !expose.type) {
+      view->backend->enter(view, NULL, NULL);
+      puglDispatchEventInContext(view, &configure);
+      view->backend->leave(view, NULL, NULL);
+    } else if (expose.type) {
+      bool useRects2 =
+        view->rects.rectsCount > 0 &&
+        (view->rects2.rectsList || puglRectsInit(&view->rects2, 4));
+      if (useRects2) {
+        PuglRects swap = view->rects2;
+        view->rects2   = view->rects;
+        view->rects    = swap;
+      }
+      view->rects.rectsCount = 0;
+
+      view->backend->enter(
+        view, &expose.expose, useRects2 ? &view->rects2 : NULL);
+      if (configure.type) {
+        puglDispatchEventInContext(view, &configure);
+      }
+      if (view->hints[PUGL_DONT_MERGE_RECTS] && useRects2) {
+        int n = view->rects2.rectsCount;
+        for (int j = 0; j < n; ++j) {
+          PuglRect*       r = view->rects2.rectsList + j;
+          PuglEventExpose e = {
+            PUGL_EXPOSE, 0, r->x, r->y, r->width, r->height, n - 1 - j};
+          puglDispatchEventInContext(view, (PuglEvent*)&e);
+        }
+      } else {
+        puglDispatchEventInContext(view, &expose);
+      }
+      view->backend->leave(
+        view, &expose.expose, useRects2 ? &view->rects2 : NULL);
+      if (useRects2) {
+        view->rects2.rectsCount = 0;
+      }
+    }
+  }
+}
+
+static void
+puglHeadlessHandleEvent(PuglView* view, PuglEvent* event)
+{
+  PuglWorld* const world = view->world;
+
+  switch (event->type) {
+  case PUGL_EXPOSE:
+    if (view->visible) {
+      addPendingExpose(view, &event->expose);
+    }
+    break;
+
+  case PUGL_CONFIGURE: {
+    // Expand configure event to be dispatched after loop
+    bool sizeChanged = view->frame.width != event->configure.width ||
+                       view->frame.height != event->configure.height;
+    view->impl->pendingConfigure = *event;
+    view->frame.x                = event->configure.x;
+    view->frame.y                = event->configure.y;
+    view->frame.width            = event->configure.width;
+    view->frame.height           = event->configure.height;
+    if (sizeChanged && view->visible) {
+      triggerFullExposure(view);
+    }
+    break;
+  }
+
+  case PUGL_MAP:
+    if (!view->visible) {
+      view->visible = true;
+      puglDispatchEvent(view, event);
+      triggerFullExposure(view);
+    }
+    break;
+
+  case PUGL_UNMAP:
+    if (view->visible) {
+      view->visible = false;
+      view->impl->pendingExpose.type = PUGL_NOTHING;
+      view->rects.rectsCount         = 0;
+      puglDispatchEvent(view, event);
+    }
+    break;
+
+  case PUGL_DATA_RECEIVED:
+    // Data is owned by the event and freed after dispatching
+    event->received.data = NULL;
+    event->received.len  = 0;
+    if (world->clipboard.data) {
+      void* data = malloc(world->clipboard.len);
+      if (data) {
+        memcpy(data, world->clipboard.data, world->clipboard.len);
+        event->received.data = data;
+        event->received.len  = world->clipboard.len;
+      }
+    }
+    puglDispatchEvent(view, event);
+    break;
+
+  default:
+    puglDispatchEvent(view, event);
+    break;
+  }
+}
+
+static PuglStatus
+puglDispatchHeadlessEvents(PuglWorld* world)
+{
+  PuglWorldInternals* impl      = world->impl;
+  bool                hadEvents = false;
+  bool wasDispatchingEvents     = impl->dispatchingEvents;
+  impl->dispatchingEvents       = true;
+
+  if (impl->needsProcessing || (impl->nextProcessTime >= 0 &&
+                                impl->nextProcessTime <= puglGetTime(world))) {
+    impl->needsProcessing = false;
+    impl->nextProcessTime = -1;
+    hadEvents             = true;
+    if (world->processFunc) {
+      world->processFunc(world, world->processUserData);
+    }
+  }
+
+  // Process all queued events, including events queued while dispatching
+  while (impl->eventsHead < impl->eventsCount) {
+    hadEvents = true;
+
+    PuglHeadlessQueuedEvent queued = impl->events[impl->eventsHead++];
+    if (queued.view) {
+      puglRecordEvent(queued.view, &queued.event);
+      puglHeadlessHandleEvent(queued.view, &queued.event);
+    }
+  }
+  impl->eventsHead  = 0;
+  impl->eventsCount = 0;
+
+  if (!wasDispatchingEvents) {
+    flushExposures(world);
+    impl->dispatchingEvents = false;
+  }
+
+  // PUGL_SUCCESS=hadEvents, PUGL_FAILURE=noEvents
+  return hadEvents ? PUGL_SUCCESS : PUGL_FAILURE;
+}
+
+static bool
+puglHeadlessHasPendingEvents(PuglWorld* world)
+{
+  PuglWorldInternals* const impl = world->impl;
+
+  return impl->eventsHead < impl->eventsCount || impl->needsProcessing ||
+         (impl->nextProcessTime >= 0 &&
+          impl->nextProcessTime <= puglGetTime(world));
+}
+
+static PuglStatus
+puglPollAwakePipe(PuglWorld* world, const double timeout)
+{
+  PuglWorldInternals* impl = world->impl;
+  const int           afd  = impl->awake_fds[0];
+  int                 ret  = 0;
+  fd_set              fds;
+
+  if (afd < 0) {
+    return PUGL_FAILURE;
+  }
+  FD_ZERO(&fds); // NOLINT
+  FD_SET(afd, &fds);
+  if (timeout < 0.0) {
+    ret = select(afd + 1, &fds, NULL, NULL, NULL);
+  } else {
+    const long     sec  = (long)timeout;
+    const long     usec = (long)((timeout - (double)sec) * 1e6);
+    struct timeval tv   = {sec, usec};
+    ret                 = select(afd + 1, &fds, NULL, NULL, &tv);
+  }
+  if (ret > 0 && FD_ISSET(afd, &fds)) {
+    impl->needsProcessing = true;
+    char buf[128];
+    int  PUGL_UNUSED(ignore) = read(afd, buf, sizeof(buf));
+    return PUGL_SUCCESS;
+  }
+  if (ret < 0 && errno != EINTR) {
+    return PUGL_UNKNOWN_ERROR;
+  }
+  return PUGL_FAILURE;
+}
+
+/// Wait for queued events, due process time or awake, in real or virtual time
+static PuglStatus
+puglWaitHeadlessEvents(PuglWorld* world, const double timeout0)
+{
+  PuglWorldInternals* impl = world->impl;
+
+  if (puglHeadlessHasPendingEvents(world)) {
+    puglPollAwakePipe(world, 0.0);
+    return PUGL_SUCCESS;
+  }
+
+  double timeout = timeout0;
+  if (impl->nextProcessTime >= 0) {
+    timeout = impl->nextProcessTime - puglGetTime(world);
+    if (timeout < 0) {
+      timeout = 0;
+    }
+    if (timeout0 >= 0 && timeout0 < timeout) {
+      timeout = timeout0;
+    }
+  }
+
+  PuglStatus st = PUGL_FAILURE;
+  if (impl->virtualTime && timeout >= 0.0) {
+    if ((st = puglPollAwakePipe(world, 0.0)) == PUGL_FAILURE) {
+      impl->currentTime += timeout;
+    }
+  } else {
+    st = puglPollAwakePipe(world, timeout);
+  }
+  if (st == PUGL_FAILURE && puglHeadlessHasPendingEvents(world)) {
+    st = PUGL_SUCCESS;
+  }
+  // PUGL_SUCCESS=hadEvents, PUGL_FAILURE=timeout
+  return st;
+}
+
+PuglStatus
+puglInjectEvents(PuglWorld* const               world,
+                 const PuglInjectedEvent* const events,
+                 const size_t                   count)
+{
+  const bool wasDispatchingEvents = world->impl->dispatchingEvents;
+  world->impl->dispatchingEvents  = true;
+
+  for (size_t i = 0; i < count; ++i) {
+    if (puglIsSkippedInjectedEvent(world, events, i, count)) {
+      puglFreeSkippedInjectedEvent(&events[i].event);
+    } else {
+      PuglEvent event = events[i].event;
+      puglHeadlessHandleEvent(events[i].view, &event);
+    }
+  }
+
+  if (!wasDispatchingEvents) {
+    flushExposures(world);
+    world->impl->dispatchingEvents = false;
+  }
+  return PUGL_SUCCESS;
+}
+
+#ifndef PUGL_DISABLE_DEPRECATED
+PuglStatus
+puglProcessEvents(PuglView* view)
+{
+  return puglUpdate(view->world, 0.0);
+}
+#endif
+
+int
+puglGetPollFd(PuglWorld* world)
+{
+  return world->impl->awake_fds[0];
+}
+
+double
+puglGetNextDeadline(PuglWorld* world)
+{
+  if (puglHeadlessHasPendingEvents(world)) {
+    return puglGetTime(world);
+  }
+  return world->impl->nextProcessTime;
+}
+
+PuglStatus
+puglWatchFd(PuglWorld* PUGL_UNUSED(world),
+            int        PUGL_UNUSED(fd),
+            bool       PUGL_UNUSED(watch))
+{
+  return PUGL_UNSUPPORTED_TYPE;
+}
+
+PuglStatus
+puglUpdate(PuglWorld* world, double timeout)
+{
+  const double startTime = puglGetTime(world);
+  PuglStatus   st        = PUGL_SUCCESS;
+
+  if (timeout < 0.0) {
+  again:
+    st = puglWaitHeadlessEvents(world, timeout);
+    if (st == PUGL_SUCCESS) {
+      st = puglDispatchHeadlessEvents(world);
+      if (st == PUGL_FAILURE) {
+        goto again; // noEvents
+      }
+    }
+  } else if (timeout <= 0.001) {
+    puglPollAwakePipe(world, 0.0);
+    st = puglDispatchHeadlessEvents(world);
+  } else {
+    const double endTime = startTime + timeout - 0.001;
+    for (double t = startTime; t < endTime; t = puglGetTime(world)) {
+      if ((st = puglWaitHeadlessEvents(world, endTime - t))) {
+        break;
+      }
+      st = puglDispatchHeadlessEvents(world);
+      if (st == PUGL_SUCCESS || st != PUGL_FAILURE) {
+        // PUGL_SUCCESS=hadEvents, PUGL_FAILURE=noEvents
+        break;
+      }
+    }
+  }
+
+  return st;
+}
+
+double
+puglGetTime(const PuglWorld* world)
+{
+  if (world->impl->virtualTime) {
+    return world->impl->currentTime - world->startTime;
+  }
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0) -
+         world->startTime;
+}
+
+PuglStatus
+puglPostRedisplay(PuglView* view)
+{
+  const PuglRect rect = {0, 0, view->frame.width, view->frame.height};
+
+  return puglPostRedisplayRect(view, rect);
+}
+
+PuglStatus
+puglPostRedisplayRect(PuglView* view, PuglRect rect)
+{
+  const PuglEventExpose event = {
+    PUGL_EXPOSE, 0, rect.x, rect.y, rect.width, rect.height, 0};
+
+  if (view->world->impl->dispatchingEvents) {
+    // Currently dispatching events, add/expand expose for the loop end
+    addPendingExpose(view, &event);
+  } else if (view->visible) {
+    return puglSendEvent(view, (const PuglEvent*)&event);
+  }
+
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglDiscardRedisplay(PuglView* view)
+{
+  view->impl->pendingExpose.type = PUGL_NOTHING;
+  view->rects.rectsCount         = 0;
+  return PUGL_SUCCESS;
+}
+
+PuglNativeView
+puglGetNativeWindow(PuglView* view)
+{
+  return view->impl->realized ? (PuglNativeView)view : 0;
+}
+
+PuglStatus
+puglSetWindowTitle(PuglView* view, const char* title)
+{
+  puglSetString(&view->title, title);
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglSetFrame(PuglView* view, const PuglRect frame)
+{
+  view->reqX      = (int)frame.x;
+  view->reqY      = (int)frame.y;
+  view->reqWidth  = (int)frame.width;
+  view->reqHeight = (int)frame.height;
+
+  if (view->impl->realized) {
+    puglHeadlessQueueConfigure(view);
+  }
+
+  view->frame = frame;
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglSetSize(PuglView* view, int width, int height)
+{
+  view->reqWidth  = width;
+  view->reqHeight = height;
+
+  if (view->impl->realized) {
+    view->reqX = (int)view->frame.x;
+    view->reqY = (int)view->frame.y;
+    puglHeadlessQueueConfigure(view);
+  }
+
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglSetMinSize(PuglView* const view, const int width, const int height)
+{
+  view->minWidth  = width;
+  view->minHeight = height;
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglSetMaxSize(PuglView* const view, const int width, const int height)
+{
+  view->maxWidth  = width;
+  view->maxHeight = height;
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglSetAspectRatio(PuglView* const view,
+                   const int       minX,
+                   const int       minY,
+                   const int       maxX,
+                   const int       maxY)
+{
+  view->minAspectX = minX;
+  view->minAspectY = minY;
+  view->maxAspectX = maxX;
+  view->maxAspectY = maxY;
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglSetTransientFor(PuglView* view, PuglNativeView parent)
+{
+  view->transientParent = parent;
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglRequestClipboard(PuglView* const view)
+{
+  puglHeadlessQueueSimpleEvent(view, PUGL_DATA_RECEIVED);
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglSetClipboard(PuglWorld* const  world,
+                 const char* const type,
+                 const void* const data,
+                 const size_t      len)
+{
+  return puglSetInternalClipboard(world, type, data, len);
+}
+
+bool
+puglHasClipboard(PuglWorld* world)
+{
+  return world->clipboard.data != NULL;
+}
+
+PuglStatus
+puglSetCursor(PuglView* view, PuglCursor cursor)
+{
+  if ((unsigned)cursor > (unsigned)PUGL_CURSOR_HIDDEN) {
+    return PUGL_BAD_PARAMETER;
+  }
+  view->impl->cursor = cursor;
+  return PUGL_SUCCESS;
+}
+
+double
+puglGetScreenScale(PuglView* view)
+{
+  return puglGetDefaultScreenScale(view->world);
+}
+
+double
+puglGetDefaultScreenScale(PuglWorld* PUGL_UNUSED(world))
+{
+  return 1.0;
+}
@@ -0,0 +1,67 @@
+/*
+  Permission to use, copy, modify, and/or distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THIS SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef PUGL_DETAIL_HEADLESS_H
+#define PUGL_DETAIL_HEADLESS_H
+
+/*
+  Headless platform: views only exist in memory, events are generated
+  by Pugl itself or queued via puglSendEvent(). No display server is needed.
+
+  If the environment variable PUGL_HEADLESS_VIRTUAL_TIME is set to a non
+  empty value other than "0", the world uses a virtual clock: waiting in
+  puglUpdate() advances the clock immediately instead of sleeping.
+*/
+
+#include "types.h"
+
+#include "pugl/pugl.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct {
+  PuglView* view;
+  PuglEvent event;
+} PuglHeadlessQueuedEvent;
+
+struct PuglWorldInternalsImpl {
+  PuglHeadlessQueuedEvent* events;
+  size_t                   eventsHead;
+  size_t                   eventsCount;
+  size_t                   eventsCapacity;
+  PuglView*                focusView;
+  double                   nextProcessTime;
+  bool                     needsProcessing;
+  int                      awake_fds[2];
+  bool                     dispatchingEvents;
+  bool                     virtualTime;
+  double                   currentTime;
+};
+
+struct PuglInternalsImpl {
+  PuglSurface* surface;
+  PuglEvent    pendingConfigure;
+  PuglEvent    pendingExpose;
+  PuglCursor   cursor;
+  bool         realized;
+  bool         displayed;
+  bool         exposeSkipped;
+};
+
+PUGL_API_PRIVATE
+PuglStatus
+puglHeadlessStubConfigure(PuglView* view);
+
+#endif // PUGL_DETAIL_HEADLESS_H
@@ -0,0 +1,278 @@
+/*
+  Permission to use, copy, modify, and/or distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THIS SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include "headless.h"
+#include "types.h"
+
+#include "pugl/cairo.h"
+#include "pugl/pugl.h"
+
+#include <cairo.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+  cairo_surface_t*   crSurface;
+  cairo_t*           crContext;
+  PuglCairoPaintFunc paintFunc;
+  void*              paintData;
+} PuglHeadlessCairoSurface;
+
+static void
+puglHeadlessCairoClose(PuglView* view)
+{
+  PuglInternals* const            impl = view->impl;
+  PuglHeadlessCairoSurface* const surface =
+    (PuglHeadlessCairoSurface*)impl->surface;
+
+  if (surface && surface->crContext) {
+    cairo_destroy(surface->crContext);
+    surface->crContext = NULL;
+  }
+}
+
+static PuglStatus
+puglHeadlessCairoOpen(PuglView* view)
+{
+  PuglInternals* const            impl = view->impl;
+  PuglHeadlessCairoSurface* const surface =
+    (PuglHeadlessCairoSurface*)impl->surface;
+
+  puglHeadlessCairoClose(view); // just to be sure
+
+  const int width  = (int)view->frame.width;
+  const int height = (int)view->frame.height;
+
+  // The image surface keeps its contents between exposures like a window
+  if (surface->crSurface &&
+      (cairo_image_surface_get_width(surface->crSurface) != width ||
+       cairo_image_surface_get_height(surface->crSurface) != height)) {
+    cairo_surface_destroy(surface->crSurface);
+    surface->crSurface = NULL;
+  }
+  if (!surface->crSurface) {
+    surface->crSurface =
+      cairo_image_surface_create(CAIRO_FORMAT_RGB24, width, height);
+  }
+  if (surface->crSurface) {
+    surface->crContext = cairo_create(surface->crSurface);
+  }
+  if (surface->crContext) {
+    return PUGL_SUCCESS;
+  } else {
+    puglHeadlessCairoClose(view);
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
+}
+
+static PuglStatus
+puglHeadlessCairoCreate(PuglView* view)
+{
+  PuglInternals* const impl = view->impl;
+
+  impl->surface = (PuglSurface*)calloc(1, sizeof(PuglHeadlessCairoSurface));
+
+  return impl->surface ? PUGL_SUCCESS : PUGL_UNKNOWN_ERROR;
+}
+
+static PuglStatus
+puglHeadlessCairoDestroy(PuglView* view)
+{
+  PuglInternals* const            impl = view->impl;
+  PuglHeadlessCairoSurface* const surface =
+    (PuglHeadlessCairoSurface*)impl->surface;
+
+  if (surface) {
+    puglHeadlessCairoClose(view);
+    if (surface->crSurface) {
+      cairo_surface_destroy(surface->crSurface);
+    }
+    free(surface);
+    impl->surface = NULL;
+  }
+  return PUGL_SUCCESS;
+}
+
+static PuglStatus
+puglHeadlessCairoEnter(PuglView*              view,
+                       const PuglEventExpose* expose,
+                       PuglRects*             rects)
+{
+  PuglInternals* const            impl = view->impl;
+  PuglHeadlessCairoSurface* const surface =
+    (PuglHeadlessCairoSurface*)impl->surface;
+
+  if (expose) {
+    if (puglHeadlessCairoOpen(view)) {
+      return PUGL_CREATE_CONTEXT_FAILED;
+    }
+    if (rects && rects->rectsCount > 0) {
+      for (int i = 0; i < rects->rectsCount; ++i) {
+        const PuglRect* r = rects->rectsList + i;
+        cairo_rectangle(surface->crContext, r->x, r->y, r->width, r->height);
+      }
+    } else {
+      cairo_rectangle(surface->crContext,
+                      expose->x,
+                      expose->y,
+                      expose->width,
+                      expose->height);
+    }
+    cairo_clip(surface->crContext);
+  }
+  return PUGL_SUCCESS;
+}
+
+static PuglStatus
+puglHeadlessCairoLeave(PuglView*              view,
+                       const PuglEventExpose* expose,
+                       PuglRects*             rects)
+{
+  PuglInternals* const            impl = view->impl;
+  PuglHeadlessCairoSurface* const surface =
+    (PuglHeadlessCairoSurface*)impl->surface;
+
+  if (expose && surface->crContext) {
+    if (surface->paintFunc) {
+      const PuglRect exposed = {
+        expose->x, expose->y, expose->width, expose->height};
+      const bool useRects = rects && rects->rectsCount > 0;
+      surface->paintFunc(view,
+                         surface->paintData,
+                         surface->crContext,
+                         useRects ? rects->rectsList : &exposed,
+                         useRects ? rects->rectsCount : 1,
+                         view->frame);
+    }
+  }
+  if (expose && surface->crSurface) {
+    cairo_surface_flush(surface->crSurface);
+  }
+  puglHeadlessCairoClose(view);
+
+  return PUGL_SUCCESS;
+}
+
+static PuglStatus
+puglHeadlessCairoScroll(PuglView* view, PuglRect rect, int dx, int dy)
+{
+  PuglInternals* const            impl = view->impl;
+  PuglHeadlessCairoSurface* const surface =
+    (PuglHeadlessCairoSurface*)impl->surface;
+
+  if (!surface || !surface->crSurface || surface->crContext ||
+      cairo_image_surface_get_width(surface->crSurface) <
+        (int)(rect.x + rect.width) ||
+      cairo_image_surface_get_height(surface->crSurface) <
+        (int)(rect.y + rect.height)) {
+    return PUGL_FAILURE;
+  }
+
+  cairo_surface_flush(surface->crSurface);
+
+  uint8_t* const data   = cairo_image_surface_get_data(surface->crSurface);
+  const int      stride = cairo_image_surface_get_stride(surface->crSurface);
+  const int      x      = (int)rect.x + (dx < 0 ? -dx : 0);
+  const int      y      = (int)rect.y + (dy < 0 ? -dy : 0);
+  const int      width  = (int)rect.width - abs(dx);
+  const int      height = (int)rect.height - abs(dy);
+
+  // Rows are processed in the direction that does not overwrite the source
+  for (int i = 0; i < height; ++i) {
+    const int row = dy > 0 ? height - 1 - i : i;
+    memmove(data + (y + row + dy) * stride + (x + dx) * 4,
+            data + (y + row) * stride + x * 4,
+            (size_t)width * 4);
+  }
+
+  cairo_surface_mark_dirty(surface->crSurface);
+  return PUGL_SUCCESS;
+}
+
+static void*
+puglHeadlessCairoGetContext(PuglView* view)
+{
+  PuglInternals* const            impl = view->impl;
+  PuglHeadlessCairoSurface* const surface =
+    (PuglHeadlessCairoSurface*)impl->surface;
+
+  return surface->crContext;
+}
+
+PuglStatus
+puglSetCairoPaintFunc(PuglView* view, PuglCairoPaintFunc func, void* data)
+{
+  PuglHeadlessCairoSurface* const surface =
+    (PuglHeadlessCairoSurface*)view->impl->surface;
+
+  if (!surface) {
+    return PUGL_FAILURE;
+  }
+
+  surface->paintFunc = func;
+  surface->paintData = data;
+  return PUGL_SUCCESS;
+}
+
+void*
+puglCairoBackendGetNativeWorld(PuglWorld* PUGL_UNUSED(world))
+{
+  return NULL;
+}
+
+void*
+puglCairoBackendSnapshot(PuglView* view, PuglRect rect)
+{
+  PuglInternals* const            impl = view->impl;
+  PuglHeadlessCairoSurface* const surface =
+    (PuglHeadlessCairoSurface*)impl->surface;
+
+  cairo_surface_t* const image = cairo_image_surface_create(
+    CAIRO_FORMAT_RGB24, (int)rect.width, (int)rect.height);
+
+  cairo_t* const cr = cairo_create(image);
+  if (surface->crSurface) {
+    cairo_set_source_surface(cr, surface->crSurface, -rect.x, -rect.y);
+  } else {
+    cairo_set_source_rgb(cr, 0.0, 0.0, 0.0); // not exposed yet
+  }
+  cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+  cairo_paint(cr);
+  cairo_destroy(cr);
+  cairo_surface_flush(image);
+
+  if (cairo_surface_status(image) != CAIRO_STATUS_SUCCESS) {
+    cairo_surface_destroy(image);
+    return NULL;
+  }
+  return image;
+}
+
+const PuglBackend*
+puglCairoBackend(void)
+{
+  static const PuglBackend backend = {puglHeadlessStubConfigure,
+                                      puglHeadlessCairoCreate,
+                                      puglHeadlessCairoDestroy,
+                                      puglHeadlessCairoEnter,
+                                      puglHeadlessCairoLeave,
+                                      puglHeadlessCairoGetContext,
+                                      NULL,
+                                      puglHeadlessCairoScroll};
+
+  return &backend;
+}
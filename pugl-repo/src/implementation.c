@@ -19,6 +19,7 @@
 #include "pugl/pugl.h"
 
 #include <assert.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -232,6 +233,15 @@ puglSetLogFunc(PuglWorld* world, PuglLogFunc logFunc)
   return PUGL_SUCCESS;
 }
 
+void
+puglSetRecordFunc(PuglWorld*     world,
+                  PuglRecordFunc recordFunc,
+                  void*          userData)
+{
+  world->recordFunc     = recordFunc;
+  world->recordUserData = userData;
+}
+
 PuglStatus
 puglSetLogLevel(PuglWorld* world, PuglLogLevel level)
 {
@@ -248,6 +258,7 @@ puglNewView(PuglWorld* const world)
     return NULL;
   }
   view->backgroundColor = -1;
+  view->bufferAge       = -1;
   if (!puglRectsInit(&view->rects, 4)) {
     free(view);
     return NULL;
@@ -359,6 +370,13 @@ puglSetBackend(PuglView* view, const PuglBackend* backend)
   return PUGL_SUCCESS;
 }
 
+PuglStatus
+puglSetBackendData(PuglView* view, void* backendData)
+{
+  view->backendData = backendData;
+  return PUGL_SUCCESS;
+}
+
 void
 puglSetHandle(PuglView* view, PuglHandle handle)
 {
@@ -377,6 +395,108 @@ puglGetVisible(const PuglView* view)
   return view->visible;
 }
 
+int
+puglGetBufferAge(const PuglView* view)
+{
+  return view->bufferAge;
+}
+
+PuglStatus
+puglSetSwapInterval(PuglView* view, int interval)
+{
+  if (!view->created) {
+    view->hints[PUGL_SWAP_INTERVAL] = interval < 0 ? -interval : interval;
+    view->hints[PUGL_ADAPTIVE_SYNC] = interval < 0 ? PUGL_TRUE : PUGL_FALSE;
+    return PUGL_SUCCESS;
+  }
+
+  if (!view->backend || !view->backend->setSwapInterval) {
+    return PUGL_UNSUPPORTED_TYPE;
+  }
+
+  return view->backend->setSwapInterval(view, interval);
+}
+
+/// Clip rect to clip, return false if nothing remains
+static bool
+puglClipRect(PuglRect* const rect, const PuglRect clip)
+{
+  const double x0 = rect->x > clip.x ? rect->x : clip.x;
+  const double y0 = rect->y > clip.y ? rect->y : clip.y;
+  const double x1 = fmin(rect->x + rect->width, clip.x + clip.width);
+  const double y1 = fmin(rect->y + rect->height, clip.y + clip.height);
+
+  rect->x      = x0;
+  rect->y      = y0;
+  rect->width  = x1 > x0 ? x1 - x0 : 0.0;
+  rect->height = y1 > y0 ? y1 - y0 : 0.0;
+
+  return rect->width > 0.0 && rect->height > 0.0;
+}
+
+PuglStatus
+puglScrollContents(PuglView* view, PuglRect rect, int dx, int dy)
+{
+  const PuglRect bounds = {0.0, 0.0, view->frame.width, view->frame.height};
+
+  const double x0 = floor(rect.x);
+  const double y0 = floor(rect.y);
+  rect.width      = ceil(rect.x + rect.width) - x0;
+  rect.height     = ceil(rect.y + rect.height) - y0;
+  rect.x          = x0;
+  rect.y          = y0;
+
+  if (!view->created || !puglClipRect(&rect, bounds) || (!dx && !dy)) {
+    return PUGL_SUCCESS;
+  }
+
+  if (abs(dx) >= rect.width || abs(dy) >= rect.height) {
+    // Nothing of the previous contents remains within rect
+    return puglPostRedisplayRect(view, rect);
+  }
+
+  if (!view->backend->scroll || view->backend->scroll(view, rect, dx, dy)) {
+    puglPostRedisplayRect(view, rect);
+    return PUGL_UNSUPPORTED_TYPE;
+  }
+
+  // Pending damage within rect has been moved together with the pixels
+  const int count = view->rects.rectsCount;
+  if (count > 0) {
+    PuglRect* const moved = (PuglRect*)malloc(count * sizeof(PuglRect));
+    if (moved) {
+      memcpy(moved, view->rects.rectsList, count * sizeof(PuglRect));
+      for (int i = 0; i < count; ++i) {
+        PuglRect r = moved[i];
+        if (puglClipRect(&r, rect)) {
+          r.x += dx;
+          r.y += dy;
+          if (puglClipRect(&r, rect)) {
+            puglPostRedisplayRect(view, r);
+          }
+        }
+      }
+      free(moved);
+    } else {
+      puglPostRedisplayRect(view, rect);
+    }
+  }
+
+  // Uncovered strips
+  if (dx) {
+    const PuglRect strip = {
+      dx > 0 ? rect.x : rect.x + rect.width + dx, rect.y, abs(dx), rect.height};
+    puglPostRedisplayRect(view, strip);
+  }
+  if (dy) {
+    const PuglRect strip = {
+      rect.x, dy > 0 ? rect.y : rect.y + rect.height + dy, rect.width, abs(dy)};
+    puglPostRedisplayRect(view, strip);
+  }
+
+  return PUGL_SUCCESS;
+}
+
 PuglRect
 puglGetFrame(const PuglView* view)
 {
@@ -567,6 +687,62 @@ puglDispatchEvent(PuglView* view, PuglEvent* event)
   }
 }
 
+void
+puglRecordEvent(PuglView* view, const PuglEvent* event)
+{
+  PuglWorld* const world = view->world;
+
+  if (world->recordFunc && event->type != PUGL_NOTHING) {
+    world->recordFunc(view, event, world->recordUserData);
+  }
+}
+
+bool
+puglIsSkippedInjectedEvent(const PuglWorld* const         world,
+                           const PuglInjectedEvent* const events,
+                           const size_t                   index,
+                           const size_t                   count)
+{
+  const PuglInjectedEvent* const e = events + index;
+
+  if (!e->view || e->event.type == PUGL_NOTHING) {
+    return true;
+  }
+
+  // Event handlers may have freed the view meanwhile
+  bool found = false;
+  for (size_t i = 0; i < world->numViews; ++i) {
+    if (world->views[i] == e->view) {
+      found = true;
+      break;
+    }
+  }
+  if (!found) {
+    return true;
+  }
+
+  // Coalesce consecutive motion events
+  if (index + 1 < count && e->event.type == PUGL_MOTION) {
+    const PuglInjectedEvent* const next = e + 1;
+
+    return next->view == e->view && next->event.type == PUGL_MOTION &&
+           next->event.motion.state == e->event.motion.state;
+  }
+  return false;
+}
+
+void
+puglFreeSkippedInjectedEvent(const PuglEvent* const event)
+{
+  if (event->type == PUGL_DATA_RECEIVED) {
+    free((void*)event->received.data);
+  } else if ((event->type == PUGL_KEY_PRESS ||
+              event->type == PUGL_KEY_RELEASE) &&
+             event->key.inputLength > 8) {
+    free(event->key.input.ptr);
+  }
+}
+
 const void*
 puglGetInternalClipboard(const PuglView* const view,
                          const char** const    type,
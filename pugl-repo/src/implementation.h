@@ -70,6 +70,21 @@ puglDispatchEventInContext(PuglView* view, PuglEvent* event);
 PUGL_API_PRIVATE void
 puglDispatchEvent(PuglView* view, PuglEvent* event);
 
+/// Pass `event` received from the window system to the world's record function
+PUGL_API_PRIVATE void
+puglRecordEvent(PuglView* view, const PuglEvent* event);
+
+/// Return true if the injected event at `index` is not to be dispatched
+PUGL_API_PRIVATE bool
+puglIsSkippedInjectedEvent(const PuglWorld*         world,
+                           const PuglInjectedEvent* events,
+                           size_t                   index,
+                           size_t                   count);
+
+/// Free the data of an injected event that is not dispatched
+PUGL_API_PRIVATE void
+puglFreeSkippedInjectedEvent(const PuglEvent* event);
+
 /// Set internal (stored in view) clipboard contents
 PUGL_API_PRIVATE const void*
 puglGetInternalClipboard(const PuglView* view, const char** type, size_t* len);
@@ -1618,6 +1618,49 @@ puglAwake(PuglWorld* world)
   [localPool release];
 }
 
+int
+puglGetPollFd(PuglWorld* PUGL_UNUSED(world))
+{
+  return -1;
+}
+
+double
+puglGetNextDeadline(PuglWorld* world)
+{
+  return world->impl->nextProcessTime;
+}
+
+PuglStatus
+puglWatchFd(PuglWorld* PUGL_UNUSED(world),
+            int        PUGL_UNUSED(fd),
+            bool       PUGL_UNUSED(watch))
+{
+  return PUGL_UNSUPPORTED_TYPE;
+}
+
+bool
+puglHasPendingInput(PuglWorld* world)
+{
+  static const NSEventMask inputMask =
+    NSEventMaskKeyDown | NSEventMaskKeyUp | NSEventMaskFlagsChanged |
+    NSEventMaskLeftMouseDown | NSEventMaskLeftMouseUp |
+    NSEventMaskRightMouseDown | NSEventMaskRightMouseUp |
+    NSEventMaskOtherMouseDown | NSEventMaskOtherMouseUp |
+    NSEventMaskMouseMoved | NSEventMaskLeftMouseDragged |
+    NSEventMaskRightMouseDragged | NSEventMaskOtherMouseDragged |
+    NSEventMaskMouseEntered | NSEventMaskMouseExited |
+    NSEventMaskScrollWheel;
+
+  NSAutoreleasePool* localPool = [[NSAutoreleasePool alloc] init];
+  NSEvent* ev = [world->impl->app nextEventMatchingMask:inputMask
+                                              untilDate:[NSDate distantPast]
+                                                 inMode:NSDefaultRunLoopMode
+                                                dequeue:NO];
+  bool     rslt = (ev != nil);
+  [localPool release];
+  return rslt;
+}
+
 PuglStatus
 puglSendEvent(PuglView* view, const PuglEvent* event)
 {
@@ -1645,6 +1688,31 @@ puglSendEvent(PuglView* view, const PuglEvent* event)
   return PUGL_UNSUPPORTED_TYPE;
 }
 
+PuglStatus
+puglInjectEvents(PuglWorld* const               world,
+                 const PuglInjectedEvent* const events,
+                 const size_t                   count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    PuglView* const view = events[i].view;
+    if (puglIsSkippedInjectedEvent(world, events, i, count)) {
+      puglFreeSkippedInjectedEvent(&events[i].event);
+      continue;
+    }
+
+    PuglEvent event = events[i].event;
+    if (event.type == PUGL_EXPOSE) {
+      // Exposures are only drawn by the system, so request a redisplay
+      const PuglRect rect = {
+        event.expose.x, event.expose.y, event.expose.width, event.expose.height};
+      puglPostRedisplayRect(view, rect);
+    } else {
+      puglDispatchEvent(view, &event);
+    }
+  }
+  return PUGL_SUCCESS;
+}
+
 #ifndef PUGL_DISABLE_DEPRECATED
 PuglStatus
 puglWaitForEvent(PuglView* view)
@@ -1770,6 +1838,14 @@ puglPostRedisplayRect(PuglView* view, PuglRect rect)
   return PUGL_SUCCESS;
 }
 
+PuglStatus
+puglDiscardRedisplay(PuglView* view)
+{
+  view->rects.rectsCount = 0;
+  [view->impl->drawView setNeedsDisplay:NO];
+  return PUGL_SUCCESS;
+}
+
 PuglNativeView
 puglGetNativeWindow(PuglView* view)
 {
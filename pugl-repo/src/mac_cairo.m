@@ -400,6 +400,20 @@ puglCairoBackendGetNativeWorld(PuglWorld* PUGL_UNUSED(world))
   return contextRef;
 }
 
+void*
+puglCairoBackendSnapshot(PuglView* PUGL_UNUSED(view), PuglRect PUGL_UNUSED(rect))
+{
+  return NULL;
+}
+
+PuglStatus
+puglSetCairoPaintFunc(PuglView* PUGL_UNUSED(view),
+                      PuglCairoPaintFunc PUGL_UNUSED(func),
+                      void* PUGL_UNUSED(data))
+{
+  return PUGL_UNSUPPORTED_TYPE;
+}
+
 const PuglBackend*
 puglCairoBackend(void)
 {
@@ -408,7 +422,9 @@ puglCairoBackend(void)
                                       puglMacCairoDestroy,
                                       puglMacCairoEnter,
                                       puglMacCairoLeave,
-                                      puglMacCairoGetContext};
+                                      puglMacCairoGetContext,
+                                      NULL,
+                                      NULL};
 
   return &backend;
 }
@@ -377,7 +377,9 @@ puglCairoBackend(void)
                                         puglMacCairoGlDestroy,
                                         puglMacCairoGlEnter,
                                         puglMacCairoGlLeave,
-                                        puglMacCairoGetContext};
+                                        puglMacCairoGetContext,
+                                        NULL,
+                                        NULL};
   
     return &backend;
 }
@@ -240,6 +240,36 @@ puglLeaveContext(PuglView* view)
   return view->backend->leave(view, NULL, NULL);
 }
 
+PuglGlConfigCache*
+puglNewGlConfigCache(void)
+{
+  return NULL;
+}
+
+void
+puglFreeGlConfigCache(PuglGlConfigCache* PUGL_UNUSED(cache))
+{}
+
+PuglStatus
+puglSetGlFrameFunc(PuglView*       PUGL_UNUSED(view),
+                   PuglGlFrameFunc PUGL_UNUSED(func),
+                   void*           PUGL_UNUSED(data))
+{
+  return PUGL_UNSUPPORTED_TYPE;
+}
+
+PuglStatus
+puglEnterGlFrame(PuglView* PUGL_UNUSED(view))
+{
+  return PUGL_UNSUPPORTED_TYPE;
+}
+
+PuglStatus
+puglLeaveGlFrame(PuglView* PUGL_UNUSED(view), bool PUGL_UNUSED(present))
+{
+  return PUGL_UNSUPPORTED_TYPE;
+}
+
 const PuglBackend*
 puglGlBackend(void)
 {
@@ -248,7 +278,9 @@ puglGlBackend(void)
                                       puglMacGlDestroy,
                                       puglMacGlEnter,
                                       puglMacGlLeave,
-                                      puglStubGetContext};
+                                      puglStubGetContext,
+                                      NULL,
+                                      NULL};
 
   return &backend;
 }
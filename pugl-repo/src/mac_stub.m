@@ -86,7 +86,9 @@ puglStubBackend(void)
                                       puglMacStubDestroy,
                                       puglStubEnter,
                                       puglStubLeave,
-                                      puglStubGetContext};
+                                      puglStubGetContext,
+                                      NULL,
+                                      NULL};
 
   return &backend;
 }
@@ -172,7 +172,9 @@ puglVulkanBackend(void)
                                       puglMacVulkanDestroy,
                                       puglStubEnter,
                                       puglStubLeave,
-                                      puglStubGetContext};
+                                      puglStubGetContext,
+                                      NULL,
+                                      NULL};
 
   return &backend;
 }
@@ -57,6 +57,7 @@ typedef struct {
 struct PuglViewImpl {
   PuglWorld*         world;
   const PuglBackend* backend;
+  void*              backendData;
   PuglInternals*     impl;
   PuglHandle         handle;
   PuglEventFunc      eventFunc;
@@ -68,6 +69,7 @@ struct PuglViewImpl {
   PuglRects          rects;
   PuglRects          rects2;
   int                backgroundColor;
+  int                bufferAge;
   int                reqX;
   int                reqY;
   int                reqWidth;
@@ -100,6 +102,8 @@ struct PuglWorldImpl {
   PuglView**          views;
   PuglBlob            clipboard;
   PuglLogLevel        logLevel;
+  PuglRecordFunc      recordFunc;
+  void*               recordUserData;
 };
 
 /// Opaque surface used by graphics backend
@@ -124,6 +128,12 @@ struct PuglBackendImpl {
 
   /// Return the puglGetContext() handle for the application, if any
   void* (*getContext)(PuglView*);
+
+  /// Change the swap interval of a realized view, may be null
+  PuglStatus (*setSwapInterval)(PuglView*, int interval);
+
+  /// Move the pixels within rect of a realized view, may be null
+  PuglStatus (*scroll)(PuglView*, PuglRect rect, int dx, int dy);
 };
 
 static inline void
@@ -323,6 +323,41 @@ puglAwake(PuglWorld* world)
   }
 }
 
+int
+puglGetPollFd(PuglWorld* PUGL_UNUSED(world))
+{
+  return -1;
+}
+
+double
+puglGetNextDeadline(PuglWorld* world)
+{
+  return world->impl->nextProcessTime;
+}
+
+PuglStatus
+puglWatchFd(PuglWorld* PUGL_UNUSED(world),
+            int        PUGL_UNUSED(fd),
+            bool       PUGL_UNUSED(watch))
+{
+  return PUGL_UNSUPPORTED_TYPE;
+}
+
+bool
+puglHasPendingInput(PuglWorld* world)
+{
+  MSG msg;
+  if (world->impl->pseudoWin &&
+      PeekMessage(&msg,
+                  world->impl->pseudoWin,
+                  PUGL_LOCAL_AWAKE_MSG,
+                  PUGL_LOCAL_AWAKE_MSG,
+                  PM_NOREMOVE)) {
+    return true;
+  }
+  return HIWORD(GetQueueStatus(QS_INPUT)) != 0;
+}
+
 PuglStatus
 puglRealize(PuglView* view)
 {
@@ -1079,6 +1114,7 @@ handleMessage(PuglView* view, UINT message, WPARAM wParam, LPARAM lParam)
     return DefWindowProcW(view->impl->hwnd, message, wParam, lParam);
   }
 
+  puglRecordEvent(view, &event);
   puglDispatchEvent(view, &event);
 
   if (event.type == PUGL_MUST_FREE &&
@@ -1180,6 +1216,31 @@ puglSendEvent(PuglView* view, const PuglEvent* event)
   return PUGL_UNSUPPORTED_TYPE;
 }
 
+PuglStatus
+puglInjectEvents(PuglWorld* const               world,
+                 const PuglInjectedEvent* const events,
+                 const size_t                   count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    PuglView* const view = events[i].view;
+    if (puglIsSkippedInjectedEvent(world, events, i, count)) {
+      puglFreeSkippedInjectedEvent(&events[i].event);
+      continue;
+    }
+
+    PuglEvent event = events[i].event;
+    if (event.type == PUGL_EXPOSE) {
+      // Exposures are only drawn by the system, so request a redisplay
+      const PuglRect rect = {
+        event.expose.x, event.expose.y, event.expose.width, event.expose.height};
+      puglPostRedisplayRect(view, rect);
+    } else {
+      puglDispatchEvent(view, &event);
+    }
+  }
+  return PUGL_SUCCESS;
+}
+
 #ifndef PUGL_DISABLE_DEPRECATED
 PuglStatus
 puglWaitForEvent(PuglView* PUGL_UNUSED(view))
@@ -1364,6 +1425,14 @@ puglPostRedisplayRect(PuglView* view, const PuglRect rect)
   return PUGL_SUCCESS;
 }
 
+PuglStatus
+puglDiscardRedisplay(PuglView* view)
+{
+  ValidateRect(view->impl->hwnd, NULL);
+  view->rects.rectsCount = 0;
+  return PUGL_SUCCESS;
+}
+
 PuglNativeView
 puglGetNativeWindow(PuglView* view)
 {
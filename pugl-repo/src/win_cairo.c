@@ -26,9 +26,11 @@
 #include <stdlib.h>
 
 typedef struct {
-  cairo_surface_t* crSurface;
-  cairo_t*         crContext;
-  bool             hasBeginPaint;
+  cairo_surface_t*   crSurface;
+  cairo_t*           crContext;
+  bool               hasBeginPaint;
+  PuglCairoPaintFunc paintFunc;
+  void*              paintData;
 } PuglWinCairoSurface;
 
 static void
@@ -141,6 +143,17 @@ puglWinCairoLeave(PuglView*              view,
   PuglWinCairoSurface* const surface = (PuglWinCairoSurface*)impl->surface;
 
   if (expose && surface->crContext) {
+    if (surface->paintFunc) {
+      const PuglRect exposed = {
+        expose->x, expose->y, expose->width, expose->height};
+      const bool useRects = rects && rects->rectsCount > 0;
+      surface->paintFunc(view,
+                         surface->paintData,
+                         surface->crContext,
+                         useRects ? rects->rectsList : &exposed,
+                         useRects ? rects->rectsCount : 1,
+                         view->frame);
+    }
     cairo_pop_group_to_source(surface->crContext);
     cairo_paint(surface->crContext);
     if (surface->hasBeginPaint) {
@@ -154,6 +167,29 @@ puglWinCairoLeave(PuglView*              view,
   return PUGL_SUCCESS;
 }
 
+static PuglStatus
+puglWinCairoScroll(PuglView* view, PuglRect rect, int dx, int dy)
+{
+  PuglInternals* const       impl    = view->impl;
+  PuglWinCairoSurface* const surface = (PuglWinCairoSurface*)impl->surface;
+
+  if (!surface || surface->crContext) {
+    return PUGL_FAILURE;
+  }
+
+  // Obscured source areas are invalidated by Windows
+  const RECT r = {(long)rect.x,
+                  (long)rect.y,
+                  (long)(rect.x + rect.width),
+                  (long)(rect.y + rect.height)};
+  if (ScrollWindowEx(impl->hwnd, dx, dy, &r, &r, NULL, NULL, SW_INVALIDATE) ==
+      ERROR) {
+    return PUGL_FAILURE;
+  }
+
+  return PUGL_SUCCESS;
+}
+
 static void*
 puglWinCairoGetContext(PuglView* view)
 {
@@ -163,6 +199,44 @@ puglWinCairoGetContext(PuglView* view)
   return surface->crContext;
 }
 
+PuglStatus
+puglSetCairoPaintFunc(PuglView* view, PuglCairoPaintFunc func, void* data)
+{
+  PuglWinCairoSurface* const surface =
+    (PuglWinCairoSurface*)view->impl->surface;
+
+  if (!surface) {
+    return PUGL_FAILURE;
+  }
+
+  surface->paintFunc = func;
+  surface->paintData = data;
+  return PUGL_SUCCESS;
+}
+
+void*
+puglCairoBackendSnapshot(PuglView* view, PuglRect rect)
+{
+  cairo_surface_t* const window = cairo_win32_surface_create(view->impl->hdc);
+
+  cairo_surface_t* const image = cairo_image_surface_create(
+    CAIRO_FORMAT_RGB24, (int)rect.width, (int)rect.height);
+
+  cairo_t* const cr = cairo_create(image);
+  cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+  cairo_set_source_surface(cr, window, -rect.x, -rect.y);
+  cairo_paint(cr);
+  cairo_destroy(cr);
+  cairo_surface_destroy(window);
+  cairo_surface_flush(image);
+
+  if (cairo_surface_status(image) != CAIRO_STATUS_SUCCESS) {
+    cairo_surface_destroy(image);
+    return NULL;
+  }
+  return image;
+}
+
 const PuglBackend*
 puglCairoBackend()
 {
@@ -171,7 +245,9 @@ puglCairoBackend()
                                       puglWinCairoDestroy,
                                       puglWinCairoEnter,
                                       puglWinCairoLeave,
-                                      puglWinCairoGetContext};
+                                      puglWinCairoGetContext,
+                                      NULL,
+                                      puglWinCairoScroll};
 
   return &backend;
 }
@@ -80,7 +80,9 @@ puglStubBackend(void)
                                       puglStubDestroy,
                                       puglWinStubEnter,
                                       puglWinStubLeave,
-                                      puglStubGetContext};
+                                      puglStubGetContext,
+                                      NULL,
+                                      NULL};
 
   return &backend;
 }
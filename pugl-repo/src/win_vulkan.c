@@ -86,7 +86,9 @@ puglVulkanBackend()
                                       puglStubDestroy,
                                       puglWinStubEnter,
                                       puglWinStubLeave,
-                                      puglStubGetContext};
+                                      puglStubGetContext,
+                                      NULL,
+                                      NULL};
 
   return &backend;
 }
@@ -55,6 +55,10 @@
 #include <sys/select.h>
 #include <sys/time.h>
 
+#ifdef __linux__
+#  include <sys/epoll.h>
+#endif
+
 #include <errno.h>
 #include <fcntl.h>
 #include <limits.h>
@@ -81,6 +85,17 @@
 
 #define PUGL_XC_DEFAULT_ARROW XC_left_ptr
 
+/// Display connection shared by the worlds of a thread, see PUGL_WORLD_SHARED_DISPLAY
+struct PuglX11SharedDisplay {
+  Display*    display;
+  XIM         xim;
+  size_t      numRefs;
+  PuglWorld** worlds; ///< Worlds that may own windows
+  size_t      numWorlds;
+};
+
+static __thread PuglX11SharedDisplay* sharedDisplay = NULL;
+
 enum WmClientStateMessageAction {
   WM_STATE_REMOVE,
   WM_STATE_ADD,
@@ -104,7 +119,10 @@ puglInitWorldInternals(PuglWorldType type, PuglWorldFlags flags)
     XInitThreads();
   }
 
-  Display* display = XOpenDisplay(NULL);
+  const bool shareDisplay = (flags & PUGL_WORLD_SHARED_DISPLAY);
+  const bool reuseDisplay = shareDisplay && sharedDisplay;
+
+  Display* display = reuseDisplay ? sharedDisplay->display : XOpenDisplay(NULL);
   if (!display) {
     return NULL;
   }
@@ -113,11 +131,28 @@ puglInitWorldInternals(PuglWorldType type, PuglWorldFlags flags)
   PuglWorldInternals* impl =
     (PuglWorldInternals*)calloc(1, sizeof(PuglWorldInternals));
   if (!impl) {
-    XCloseDisplay(display);
+    if (!reuseDisplay) {
+      XCloseDisplay(display);
+    }
     return NULL;
   }
   impl->display = display;
 
+  if (shareDisplay) {
+    if (!reuseDisplay) {
+      sharedDisplay =
+        (PuglX11SharedDisplay*)calloc(1, sizeof(PuglX11SharedDisplay));
+      if (!sharedDisplay) {
+        XCloseDisplay(display);
+        free(impl);
+        return NULL;
+      }
+      sharedDisplay->display = display;
+    }
+    ++sharedDisplay->numRefs;
+    impl->shared = sharedDisplay;
+  }
+
   // Intern the various atoms we will need
   impl->atoms.CLIPBOARD        = XInternAtom(display, "CLIPBOARD", 0);
   impl->atoms.TARGETS          = XInternAtom(display, "TARGETS", 0);
@@ -132,10 +167,17 @@ puglInitWorldInternals(PuglWorldType type, PuglWorldFlags flags)
     XInternAtom(display, "_NET_WM_STATE_DEMANDS_ATTENTION", 0);
 
   // Open input method
-  XSetLocaleModifiers("");
-  if (!(impl->xim = XOpenIM(display, NULL, NULL, NULL))) {
-    XSetLocaleModifiers("@im=");
-    impl->xim = XOpenIM(display, NULL, NULL, NULL);
+  if (reuseDisplay) {
+    impl->xim = impl->shared->xim;
+  } else {
+    XSetLocaleModifiers("");
+    if (!(impl->xim = XOpenIM(display, NULL, NULL, NULL))) {
+      XSetLocaleModifiers("@im=");
+      impl->xim = XOpenIM(display, NULL, NULL, NULL);
+    }
+    if (impl->shared) {
+      impl->shared->xim = impl->xim;
+    }
   }
 
   XFlush(display);
@@ -149,6 +191,7 @@ puglInitWorldInternals(PuglWorldType type, PuglWorldFlags flags)
   }
 
   impl->nextProcessTime = -1;
+  impl->poll_fd         = -1;
 
   // Key modifiers
   XModifierKeymap* map = XGetModifierMapping(display);
@@ -205,10 +248,44 @@ puglInitWorldInternals(PuglWorldType type, PuglWorldFlags flags)
   return impl;
 }
 
+/// Make the world known to other worlds of the shared display
+static void
+registerSharedWorld(PuglWorld* world)
+{
+  PuglWorldInternals* const   impl   = world->impl;
+  PuglX11SharedDisplay* const shared = impl->shared;
+  if (shared && !impl->sharedRegistered) {
+    PuglWorld** const worlds = (PuglWorld**)realloc(
+      shared->worlds, (shared->numWorlds + 1) * sizeof(PuglWorld*));
+    if (worlds) {
+      worlds[shared->numWorlds++] = world;
+      shared->worlds              = worlds;
+      impl->sharedRegistered      = true;
+    }
+  }
+}
+
+static void
+unregisterSharedWorld(PuglWorld* world)
+{
+  PuglX11SharedDisplay* const shared = world->impl->shared;
+  for (size_t i = 0; i < shared->numWorlds; ++i) {
+    if (shared->worlds[i] == world) {
+      memmove(shared->worlds + i,
+              shared->worlds + i + 1,
+              (shared->numWorlds - i - 1) * sizeof(PuglWorld*));
+      --shared->numWorlds;
+      break;
+    }
+  }
+  world->impl->sharedRegistered = false;
+}
+
 static void
 initWorldPseudoWin(PuglWorld* world)
 {
   PuglWorldInternals* impl = world->impl;
+  registerSharedWorld(world);
   if (!impl->pseudoWin) {
     impl->pseudoWin = XCreateSimpleWindow(
       impl->display,
@@ -249,19 +326,49 @@ puglInitViewInternals(void)
   return impl;
 }
 
+/// Add watched file descriptors to a select set, returns the new nfds
+static int
+addWatchFds(PuglWorldInternals* impl, fd_set* fds, int nfds)
+{
+  for (size_t i = 0; i < impl->numWatchFds; ++i) {
+    FD_SET(impl->watchFds[i], fds);
+    if (impl->watchFds[i] >= nfds) {
+      nfds = impl->watchFds[i] + 1;
+    }
+  }
+  return nfds;
+}
+
+static bool
+hasReadableWatchFd(PuglWorldInternals* impl, fd_set* fds)
+{
+  for (size_t i = 0; i < impl->numWatchFds; ++i) {
+    if (FD_ISSET(impl->watchFds[i], fds)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 static void
 drainAwakePipe(PuglWorld* world)
 {
   PuglWorldInternals* impl = world->impl;
   const int           afd  = impl->awake_fds[0];
-  if (afd >= 0) {
+  if (afd >= 0 || impl->numWatchFds > 0) {
     fd_set fds;
     int    nfds = afd + 1;
     FD_ZERO(&fds);
-    FD_SET(afd, &fds);
+    if (afd >= 0) {
+      FD_SET(afd, &fds);
+    }
+    nfds = addWatchFds(impl, &fds, nfds);
     struct timeval tv  = {0, 0};
     int            ret = select(nfds, &fds, NULL, NULL, &tv);
-    if (ret > 0 && FD_ISSET(afd, &fds)) {
+    if (ret > 0 && hasReadableWatchFd(impl, &fds)) {
+      impl->needsProcessing = true;
+    }
+    if (ret > 0 && afd >= 0 && FD_ISSET(afd, &fds)) {
       impl->needsProcessing = true;
       char buf[128];
       int  PUGL_UNUSED(ignore) = read(afd, buf, sizeof(buf));
@@ -273,7 +380,8 @@ static PuglStatus
 puglPollX11Socket(PuglWorld* world, const double timeout0)
 {
   PuglWorldInternals* impl = world->impl;
-  if (XEventsQueued(world->impl->display, QueuedAlready) > 0) {
+  if (impl->numQueuedEvents > 0 ||
+      XEventsQueued(world->impl->display, QueuedAlready) > 0) {
     drainAwakePipe(world);
     return PUGL_SUCCESS;
   }
@@ -288,6 +396,7 @@ puglPollX11Socket(PuglWorld* world, const double timeout0)
   if (afd >= 0) {
     FD_SET(afd, &fds);
   }
+  nfds = addWatchFds(impl, &fds, nfds);
   double timeout;
   if (impl->nextProcessTime >= 0) {
     timeout = impl->nextProcessTime - puglGetTime(world);
@@ -309,6 +418,10 @@ puglPollX11Socket(PuglWorld* world, const double timeout0)
     ret                 = select(nfds, &fds, NULL, NULL, &tv);
   }
   bool hasEvents = FD_ISSET(fd, &fds);
+  if (ret > 0 && hasReadableWatchFd(impl, &fds)) {
+    hasEvents             = true;
+    impl->needsProcessing = true;
+  }
   if (ret > 0 && afd >= 0 && FD_ISSET(afd, &fds)) {
     hasEvents             = true;
     impl->needsProcessing = true;
@@ -344,6 +457,47 @@ puglFindView(PuglWorld* world, const Window window)
   return NULL;
 }
 
+/// Return the world that owns the window of an event from the shared display
+static PuglWorld*
+findSharedOwner(PuglX11SharedDisplay* shared, const Window window)
+{
+  for (size_t i = 0; i < shared->numWorlds; ++i) {
+    PuglWorld* const w = shared->worlds[i];
+    if (window == w->impl->pseudoWin ||
+        (w->impl->incrTarget.win && window == w->impl->incrTarget.win) ||
+        puglFindView(w, window)) {
+      return w;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+   Queue an event that is dispatched by the next update of the owning world.
+
+   The event has already been read from the socket, so the owner is awoken to
+   make its select() or poll fd return.
+*/
+static void
+queueSharedEvent(PuglWorld* owner, const XEvent* xevent)
+{
+  PuglWorldInternals* const impl = owner->impl;
+  if (impl->numQueuedEvents == 0) {
+    puglAwake(owner);
+  }
+  if (impl->numQueuedEvents == impl->maxQueuedEvents) {
+    const size_t  n      = impl->maxQueuedEvents ? 2 * impl->maxQueuedEvents : 16;
+    XEvent* const events = (XEvent*)realloc(impl->queuedEvents, n * sizeof(XEvent));
+    if (!events) {
+      return; // drop event
+    }
+    impl->queuedEvents    = events;
+    impl->maxQueuedEvents = n;
+  }
+  impl->queuedEvents[impl->numQueuedEvents++] = *xevent;
+}
+
 static PuglStatus
 updateSizeHints(const PuglView* view)
 {
@@ -441,6 +595,8 @@ puglRealize(PuglView* view)
   const Window         parent  = view->parent ? (Window)view->parent : root;
   PuglStatus           st      = PUGL_SUCCESS;
 
+  registerSharedWorld(world);
+
   // Ensure that we're unrealized and that a reasonable backend has been set
   if (impl->win) {
     return PUGL_FAILURE;
@@ -448,7 +604,7 @@ puglRealize(PuglView* view)
 
   if (!view->backend || !view->backend->configure) {
     return PUGL_BAD_BACKEND;
-  } else if (view->reqWidth <= 0 && view->reqHeight <= 0) {
+  } else if (view->reqWidth <= 0 || view->reqHeight <= 0) {
     return PUGL_BAD_CONFIGURATION;
   }
 
@@ -706,17 +862,40 @@ puglFreeViewInternals(PuglView* view)
 void
 puglFreeWorldInternals(PuglWorld* world)
 {
+  PuglX11SharedDisplay* const shared = world->impl->shared;
   if (world->impl->pseudoWin) {
     XDestroyWindow(world->impl->display, world->impl->pseudoWin);
   }
-  if (world->impl->xim) {
-    XCloseIM(world->impl->xim);
+  if (shared) {
+    unregisterSharedWorld(world);
+    if (--shared->numRefs == 0) {
+      if (shared->xim) {
+        XCloseIM(shared->xim);
+      }
+      XCloseDisplay(shared->display);
+      if (sharedDisplay == shared) {
+        sharedDisplay = NULL;
+      }
+      free(shared->worlds);
+      free(shared);
+    } else {
+      XFlush(world->impl->display);
+    }
+  } else {
+    if (world->impl->xim) {
+      XCloseIM(world->impl->xim);
+    }
+    XCloseDisplay(world->impl->display);
   }
-  XCloseDisplay(world->impl->display);
   if (world->impl->awake_fds[0] >= 0) {
     close(world->impl->awake_fds[0]);
     close(world->impl->awake_fds[1]);
   }
+  if (world->impl->poll_fd >= 0) {
+    close(world->impl->poll_fd);
+  }
+  free(world->impl->watchFds);
+  free(world->impl->queuedEvents);
   free(world->impl);
 }
 
@@ -957,9 +1136,15 @@ translateEvent(PuglView* view, XEvent xevent)
       event.client.data2 = (uintptr_t)xevent.xclient.data.l[1];
     }
     break;
-  case VisibilityNotify:
-    view->visible = xevent.xvisibility.state != VisibilityFullyObscured;
+  case VisibilityNotify: {
+    const bool visible = xevent.xvisibility.state != VisibilityFullyObscured;
+    if (visible != view->visible) {
+      view->visible            = visible;
+      event.type               = PUGL_VISIBILITY_CHANGED;
+      event.visibility.visible = visible;
+    }
     break;
+  }
   case MapNotify:
     event.type = PUGL_MAP;
     break;
@@ -998,6 +1183,15 @@ translateEvent(PuglView* view, XEvent xevent)
     event.expose.height = xevent.xexpose.height;
     event.expose.count  = xevent.xexpose.count;
     break;
+  case GraphicsExpose:
+    // Source of puglScrollContents() was obscured
+    event.type          = PUGL_EXPOSE;
+    event.expose.x      = xevent.xgraphicsexpose.x;
+    event.expose.y      = xevent.xgraphicsexpose.y;
+    event.expose.width  = xevent.xgraphicsexpose.width;
+    event.expose.height = xevent.xgraphicsexpose.height;
+    event.expose.count  = xevent.xgraphicsexpose.count;
+    break;
   case MotionNotify:
     event.type         = PUGL_MOTION;
     event.motion.time  = (double)xevent.xmotion.time / 1e3;
@@ -1298,10 +1492,143 @@ puglAwake(PuglWorld* world)
   }
 }
 
+int
+puglGetPollFd(PuglWorld* world)
+{
+#ifdef __linux__
+  PuglWorldInternals* const impl = world->impl;
+  if (impl->poll_fd < 0) {
+    const int pfd = epoll_create1(EPOLL_CLOEXEC);
+    if (pfd < 0) {
+      return -1;
+    }
+    const int fds[2] = {ConnectionNumber(impl->display), impl->awake_fds[0]};
+    for (size_t i = 0; i < 2 + impl->numWatchFds; ++i) {
+      const int          fd = (i < 2) ? fds[i] : impl->watchFds[i - 2];
+      struct epoll_event ev = {0};
+      ev.events             = EPOLLIN;
+      ev.data.fd            = fd;
+      if (fd >= 0 && epoll_ctl(pfd, EPOLL_CTL_ADD, fd, &ev)) {
+        close(pfd);
+        return -1;
+      }
+    }
+    impl->poll_fd = pfd;
+  }
+  return impl->poll_fd;
+#else
+  (void)world;
+  return -1;
+#endif
+}
+
+PuglStatus
+puglWatchFd(PuglWorld* world, int fd, bool watch)
+{
+  PuglWorldInternals* const impl = world->impl;
+  if (fd < 0 || fd >= FD_SETSIZE) {
+    return PUGL_BAD_PARAMETER;
+  }
+  size_t i = 0;
+  while (i < impl->numWatchFds && impl->watchFds[i] != fd) {
+    ++i;
+  }
+  if (watch && i == impl->numWatchFds) {
+    int* const fds =
+      (int*)realloc(impl->watchFds, (impl->numWatchFds + 1) * sizeof(int));
+    if (!fds) {
+      return PUGL_FAILURE;
+    }
+    fds[impl->numWatchFds++] = fd;
+    impl->watchFds           = fds;
+#ifdef __linux__
+    if (impl->poll_fd >= 0) {
+      struct epoll_event ev = {0};
+      ev.events             = EPOLLIN;
+      ev.data.fd            = fd;
+      epoll_ctl(impl->poll_fd, EPOLL_CTL_ADD, fd, &ev);
+    }
+#endif
+  } else if (!watch && i < impl->numWatchFds) {
+    impl->watchFds[i] = impl->watchFds[--impl->numWatchFds];
+#ifdef __linux__
+    if (impl->poll_fd >= 0) {
+      epoll_ctl(impl->poll_fd, EPOLL_CTL_DEL, fd, NULL);
+    }
+#endif
+  }
+  return PUGL_SUCCESS;
+}
+
+double
+puglGetNextDeadline(PuglWorld* world)
+{
+  PuglWorldInternals* const impl = world->impl;
+  XFlush(impl->display);
+  if (impl->needsProcessing || impl->numQueuedEvents > 0 ||
+      XEventsQueued(impl->display, QueuedAlready) > 0) {
+    return puglGetTime(world);
+  }
+  return impl->nextProcessTime;
+}
+
+static Bool
+isInputEvent(Display* PUGL_UNUSED(display), XEvent* xevent, XPointer arg)
+{
+  switch (xevent->type) {
+  case KeyPress:
+  case KeyRelease:
+  case ButtonPress:
+  case ButtonRelease:
+  case MotionNotify:
+  case EnterNotify:
+  case LeaveNotify:
+    *(bool*)arg = true;
+    break;
+  }
+  return False; // only scan, never remove events from the queue
+}
+
+bool
+puglHasPendingInput(PuglWorld* world)
+{
+  PuglWorldInternals* const impl = world->impl;
+  const int                 afd  = impl->awake_fds[0];
+
+  if (impl->needsProcessing) {
+    return true;
+  }
+  for (size_t i = 0; i < impl->numQueuedEvents; ++i) {
+    bool found = false;
+    isInputEvent(impl->display, &impl->queuedEvents[i], (XPointer)&found);
+    if (found) {
+      return true;
+    }
+  }
+  if (afd >= 0) {
+    fd_set fds;
+    FD_ZERO(&fds); // NOLINT
+    FD_SET(afd, &fds);
+    struct timeval tv = {0, 0};
+    if (select(afd + 1, &fds, NULL, NULL, &tv) > 0) {
+      return true;
+    }
+  }
+  if (XEventsQueued(impl->display, QueuedAfterReading) > 0) {
+    bool   found = false;
+    XEvent xevent;
+    XCheckIfEvent(impl->display, &xevent, isInputEvent, (XPointer)&found);
+    return found;
+  }
+  return false;
+}
+
 /// Flush pending configure and expose events for all views
 static void
 flushExposures(PuglWorld* world)
 {
+  int pendingInput = -1; // checked at most once per flush
+
   for (size_t i = 0; i < world->numViews; ++i) {
     PuglView* const view = world->views[i];
 
@@ -1309,11 +1636,26 @@ flushExposures(PuglWorld* world)
       puglDispatchSimpleEvent(view, PUGL_UPDATE);
     }
 
+    bool skipExpose = false;
+    if (view->impl->pendingExpose.type && view->hints[PUGL_SKIP_STALE_EXPOSE] &&
+        !view->impl->exposeSkipped) {
+      if (pendingInput < 0) {
+        pendingInput = puglHasPendingInput(world);
+      }
+      skipExpose = pendingInput;
+    }
+    view->impl->exposeSkipped = skipExpose;
+
     PuglEvent configure = view->impl->pendingConfigure;
     PuglEvent expose    = view->impl->pendingExpose;
 
     view->impl->pendingConfigure.type = PUGL_NOTHING;
-    view->impl->pendingExpose.type    = PUGL_NOTHING;
+    if (skipExpose) {
+      // Keep the expose pending, but draw at the latest in the next flush
+      expose.type = PUGL_NOTHING;
+    } else {
+      view->impl->pendingExpose.type = PUGL_NOTHING;
+    }
 
     if (configure.type && !expose.type) {
       view->backend->enter(view, NULL, NULL);
@@ -1355,6 +1697,56 @@ flushExposures(PuglWorld* world)
   }
 }
 
+/// Handle a translated or injected event like puglDispatchX11Events
+static void
+puglHandleX11Event(PuglView* view, PuglEvent* event)
+{
+  if (event->type == PUGL_EXPOSE) {
+    if (!view->impl->hadConfigure) {
+      // simulate missing configure for xvfb
+      view->impl->pendingConfigure.configure.type   = PUGL_CONFIGURE;
+      view->impl->pendingConfigure.configure.x      = view->reqX;
+      view->impl->pendingConfigure.configure.y      = view->reqY;
+      view->impl->pendingConfigure.configure.width  = view->reqWidth;
+      view->impl->pendingConfigure.configure.height = view->reqHeight;
+      view->frame.x                = event->configure.x;
+      view->frame.y                = event->configure.y;
+      view->frame.width            = event->configure.width;
+      view->frame.height           = event->configure.height;
+      view->impl->hadConfigure = true;
+    }
+    addPendingExpose(view, &event->expose);
+  } else if (event->type == PUGL_CONFIGURE) {
+    // Expand configure event to be dispatched after loop
+    bool sizeChanged =  view->frame.width  != event->configure.width
+                     || view->frame.height != event->configure.height;
+    view->impl->pendingConfigure = *event;
+    view->frame.x                = event->configure.x;
+    view->frame.y                = event->configure.y;
+    view->frame.width            = event->configure.width;
+    view->frame.height           = event->configure.height;
+    if (sizeChanged) {
+      triggerFullExposure(view);
+    }
+  } else if (event->type == PUGL_MAP && view->parent) {
+    XWindowAttributes attrs;
+    XGetWindowAttributes(view->impl->display, view->impl->win, &attrs);
+
+    PuglEventConfigure configure = {PUGL_CONFIGURE,
+                                    0,
+                                    (double)attrs.x,
+                                    (double)attrs.y,
+                                    (double)attrs.width,
+                                    (double)attrs.height};
+
+    puglDispatchEvent(view, (PuglEvent*)&configure);
+    puglDispatchEvent(view, event);
+  } else {
+    // Dispatch event to application immediately
+    puglDispatchEvent(view, event);
+  }
+}
+
 static PuglStatus
 puglDispatchX11Events(PuglWorld* world)
 {
@@ -1385,11 +1777,34 @@ puglDispatchX11Events(PuglWorld* world)
 
   unsigned long serial0 = NextRequest(display);
 
+  // Take events that were queued for this world by other worlds of the shared
+  // display, events that are queued while dispatching are handled next time
+  XEvent* const queuedEvents    = impl->queuedEvents;
+  const size_t  numQueuedEvents = impl->numQueuedEvents;
+  size_t        queuedIndex     = 0;
+  impl->queuedEvents            = NULL;
+  impl->numQueuedEvents         = 0;
+  impl->maxQueuedEvents         = 0;
+
   // Process all queued events
-  while (XEventsQueued(display, QueuedAfterReading) > 0) {
-    hadEvents = true;
+  for (;;) {
     XEvent xevent;
-    XNextEvent(display, &xevent);
+    if (queuedIndex < numQueuedEvents) {
+      xevent = queuedEvents[queuedIndex++];
+    } else if (XEventsQueued(display, QueuedAfterReading) > 0) {
+      XNextEvent(display, &xevent);
+      if (impl->shared) {
+        PuglWorld* const owner =
+          findSharedOwner(impl->shared, xevent.xany.window);
+        if (owner && owner != world) {
+          queueSharedEvent(owner, &xevent);
+          continue;
+        }
+      }
+    } else {
+      break;
+    }
+    hadEvents = true;
 
     if (xevent.xany.window == impl->pseudoWin) {
       if (xevent.type == SelectionClear) {
@@ -1444,51 +1859,11 @@ puglDispatchX11Events(PuglWorld* world)
     // Translate X11 event to Pugl event
     PuglEvent event = translateEvent(view, xevent);
 
-    if (event.type == PUGL_EXPOSE) {
-      if (!view->impl->hadConfigure) {
-        // simulate missing configure for xvfb
-        view->impl->pendingConfigure.configure.type   = PUGL_CONFIGURE;
-        view->impl->pendingConfigure.configure.x      = view->reqX;
-        view->impl->pendingConfigure.configure.y      = view->reqY;
-        view->impl->pendingConfigure.configure.width  = view->reqWidth;
-        view->impl->pendingConfigure.configure.height = view->reqHeight;
-        view->frame.x                = event.configure.x;
-        view->frame.y                = event.configure.y;
-        view->frame.width            = event.configure.width;
-        view->frame.height           = event.configure.height;
-        view->impl->hadConfigure = true;
-      }
-      addPendingExpose(view, &event.expose);
-    } else if (event.type == PUGL_CONFIGURE) {
-      // Expand configure event to be dispatched after loop
-      bool sizeChanged =  view->frame.width  != event.configure.width
-                       || view->frame.height != event.configure.height;
-      view->impl->pendingConfigure = event;
-      view->frame.x                = event.configure.x;
-      view->frame.y                = event.configure.y;
-      view->frame.width            = event.configure.width;
-      view->frame.height           = event.configure.height;
-      if (sizeChanged) {
-        triggerFullExposure(view);
-      }
-    } else if (event.type == PUGL_MAP && view->parent) {
-      XWindowAttributes attrs;
-      XGetWindowAttributes(view->impl->display, view->impl->win, &attrs);
-
-      PuglEventConfigure configure = {PUGL_CONFIGURE,
-                                      0,
-                                      (double)attrs.x,
-                                      (double)attrs.y,
-                                      (double)attrs.width,
-                                      (double)attrs.height};
-
-      puglDispatchEvent(view, (PuglEvent*)&configure);
-      puglDispatchEvent(view, &event);
-    } else {
-      // Dispatch event to application immediately
-      puglDispatchEvent(view, &event);
-    }
+    puglRecordEvent(view, &event);
+    puglHandleX11Event(view, &event);
   }
+  free(queuedEvents);
+
   if (!wasDispatchingEvents) {
     flushExposures(world);
     impl->dispatchingEvents = false;
@@ -1510,6 +1885,30 @@ puglDispatchX11Events(PuglWorld* world)
   return hadEvents ? PUGL_SUCCESS : PUGL_FAILURE;
 }
 
+PuglStatus
+puglInjectEvents(PuglWorld* const               world,
+                 const PuglInjectedEvent* const events,
+                 const size_t                   count)
+{
+  const bool wasDispatchingEvents = world->impl->dispatchingEvents;
+  world->impl->dispatchingEvents  = true;
+
+  for (size_t i = 0; i < count; ++i) {
+    if (puglIsSkippedInjectedEvent(world, events, i, count)) {
+      puglFreeSkippedInjectedEvent(&events[i].event);
+    } else {
+      PuglEvent event = events[i].event;
+      puglHandleX11Event(events[i].view, &event);
+    }
+  }
+
+  if (!wasDispatchingEvents) {
+    flushExposures(world);
+    world->impl->dispatchingEvents = false;
+  }
+  return PUGL_SUCCESS;
+}
+
 #ifndef PUGL_DISABLE_DEPRECATED
 PuglStatus
 puglProcessEvents(PuglView* view)
@@ -1523,6 +1922,7 @@ puglUpdate(PuglWorld* world, double timeout)
 {
   const double startTime = puglGetTime(world);
   PuglStatus   st        = PUGL_SUCCESS;
+  registerSharedWorld(world);
   XFlush(world->impl->display);
 
   if (timeout < 0.0) {
@@ -1588,6 +1988,14 @@ puglPostRedisplayRect(PuglView* view, PuglRect rect)
   return PUGL_SUCCESS;
 }
 
+PuglStatus
+puglDiscardRedisplay(PuglView* view)
+{
+  view->impl->pendingExpose.type = PUGL_NOTHING;
+  view->rects.rectsCount         = 0;
+  return PUGL_SUCCESS;
+}
+
 PuglNativeView
 puglGetNativeWindow(PuglView* view)
 {
@@ -49,8 +49,15 @@ typedef struct PuglX11IncrTarget {
   size_t pos;
 } PuglX11IncrTarget;
 
+typedef struct PuglX11SharedDisplay PuglX11SharedDisplay;
+
 struct PuglWorldInternalsImpl {
   Display*          display;
+  PuglX11SharedDisplay* shared;
+  bool              sharedRegistered;
+  XEvent*           queuedEvents; // events from shared display for this world
+  size_t            numQueuedEvents;
+  size_t            maxQueuedEvents;
   PuglX11Atoms      atoms;
   XIM               xim;
   Window            pseudoWin;
@@ -60,6 +67,9 @@ struct PuglWorldInternalsImpl {
   double            nextProcessTime;
   bool              needsProcessing;
   int               awake_fds[2];
+  int               poll_fd;
+  int*              watchFds;
+  size_t            numWatchFds;
   bool              dispatchingEvents;
   int               shiftKeyStates;
   int               controlKeyStates;
@@ -84,6 +94,7 @@ struct PuglInternalsImpl {
   bool         displayed;
   bool         posRequested;
   bool         hadConfigure;
+  bool         exposeSkipped;
 };
 
 PUGL_API_PRIVATE
@@ -27,8 +27,11 @@
 #include <stdlib.h>
 
 typedef struct {
-  cairo_surface_t* crSurface;
-  cairo_t*         crContext;
+  cairo_surface_t*   crSurface;
+  cairo_t*           crContext;
+  GC                 scrollGc;
+  PuglCairoPaintFunc paintFunc;
+  void*              paintData;
 } PuglX11CairoSurface;
 
 static void
@@ -91,6 +94,9 @@ puglX11CairoDestroy(PuglView* view)
   PuglX11CairoSurface* const surface = (PuglX11CairoSurface*)impl->surface;
 
   puglX11CairoClose(view);
+  if (surface && surface->scrollGc) {
+    XFreeGC(impl->display, surface->scrollGc);
+  }
   free(surface);
   impl->surface = NULL;
   return PUGL_SUCCESS;
@@ -130,12 +136,23 @@ puglX11CairoEnter(PuglView*              view,
 static PuglStatus
 puglX11CairoLeave(PuglView*              view,
                   const PuglEventExpose* expose,
-                  PuglRects*             PUGL_UNUSED(rects))
+                  PuglRects*             rects)
 {
   PuglInternals* const       impl    = view->impl;
   PuglX11CairoSurface* const surface = (PuglX11CairoSurface*)impl->surface;
 
   if (expose && surface->crContext) {
+    if (surface->paintFunc) {
+      const PuglRect exposed = {
+        expose->x, expose->y, expose->width, expose->height};
+      const bool useRects = rects && rects->rectsCount > 0;
+      surface->paintFunc(view,
+                         surface->paintData,
+                         surface->crContext,
+                         useRects ? rects->rectsList : &exposed,
+                         useRects ? rects->rectsCount : 1,
+                         view->frame);
+    }
     cairo_pop_group_to_source(surface->crContext);
     cairo_paint(surface->crContext);
   }
@@ -144,6 +161,39 @@ puglX11CairoLeave(PuglView*              view,
   return PUGL_SUCCESS;
 }
 
+static PuglStatus
+puglX11CairoScroll(PuglView* view, PuglRect rect, int dx, int dy)
+{
+  PuglInternals* const       impl    = view->impl;
+  PuglX11CairoSurface* const surface = (PuglX11CairoSurface*)impl->surface;
+
+  if (!surface || surface->crContext) {
+    return PUGL_FAILURE;
+  }
+  if (!surface->scrollGc) {
+    // Obscured source areas are reported as GraphicsExpose events
+    surface->scrollGc = XCreateGC(impl->display, impl->win, 0, NULL);
+    if (!surface->scrollGc) {
+      return PUGL_FAILURE;
+    }
+  }
+
+  const int x = (int)rect.x + (dx < 0 ? -dx : 0);
+  const int y = (int)rect.y + (dy < 0 ? -dy : 0);
+  XCopyArea(impl->display,
+            impl->win,
+            impl->win,
+            surface->scrollGc,
+            x,
+            y,
+            (unsigned)((int)rect.width - abs(dx)),
+            (unsigned)((int)rect.height - abs(dy)),
+            x + dx,
+            y + dy);
+
+  return PUGL_SUCCESS;
+}
+
 static void*
 puglX11CairoGetContext(PuglView* view)
 {
@@ -153,12 +203,57 @@ puglX11CairoGetContext(PuglView* view)
   return surface->crContext;
 }
 
+PuglStatus
+puglSetCairoPaintFunc(PuglView* view, PuglCairoPaintFunc func, void* data)
+{
+  PuglX11CairoSurface* const surface =
+    (PuglX11CairoSurface*)view->impl->surface;
+
+  if (!surface) {
+    return PUGL_FAILURE;
+  }
+
+  surface->paintFunc = func;
+  surface->paintData = data;
+  return PUGL_SUCCESS;
+}
+
 void*
 puglCairoBackendGetNativeWorld(PuglWorld* world)
 {
   return world->impl->display;
 }
 
+void*
+puglCairoBackendSnapshot(PuglView* view, PuglRect rect)
+{
+  PuglInternals* const impl = view->impl;
+
+  // cairo reads the window contents with XShmGetImage if available
+  cairo_surface_t* const window = cairo_xlib_surface_create(impl->display,
+                                                            impl->win,
+                                                            impl->vi->visual,
+                                                            view->frame.width,
+                                                            view->frame.height);
+
+  cairo_surface_t* const image = cairo_image_surface_create(
+    CAIRO_FORMAT_RGB24, (int)rect.width, (int)rect.height);
+
+  cairo_t* const cr = cairo_create(image);
+  cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+  cairo_set_source_surface(cr, window, -rect.x, -rect.y);
+  cairo_paint(cr);
+  cairo_destroy(cr);
+  cairo_surface_destroy(window);
+  cairo_surface_flush(image);
+
+  if (cairo_surface_status(image) != CAIRO_STATUS_SUCCESS) {
+    cairo_surface_destroy(image);
+    return NULL;
+  }
+  return image;
+}
+
 const PuglBackend*
 puglCairoBackend(void)
 {
@@ -167,7 +262,9 @@ puglCairoBackend(void)
                                       puglX11CairoDestroy,
                                       puglX11CairoEnter,
                                       puglX11CairoLeave,
-                                      puglX11CairoGetContext};
+                                      puglX11CairoGetContext,
+                                      NULL,
+                                      puglX11CairoScroll};
 
   return &backend;
 }
@@ -25,15 +25,111 @@
 #include <X11/X.h>
 #include <X11/Xlib.h>
 
+#include <math.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+/// Maximum value for hint PUGL_MAX_FRAMES_IN_FLIGHT
+#define PUGL_X11_GL_MAX_FENCES 8
 
 typedef struct {
-  GLXFBConfig fb_config;
-  GLXContext  ctx;
+  GLXFBConfig                 fb_config;
+  GLXContext                  ctx;
+  bool                        hasBufferAge;
+  PFNGLXCOPYSUBBUFFERMESAPROC copySubBuffer;
+  bool                        presentedPartially;
+  PFNGLXSWAPINTERVALEXTPROC   swapInterval;
+  bool                        hasSwapControlTear;
+  PFNGLFENCESYNCPROC          fenceSync;
+  PFNGLCLIENTWAITSYNCPROC     clientWaitSync;
+  PFNGLDELETESYNCPROC         deleteSync;
+  GLsync                      fences[PUGL_X11_GL_MAX_FENCES];
+  int                         fencesCount;
+  PFNGLBINDFRAMEBUFFERPROC    bindFramebuffer;
+  PFNGLBLITFRAMEBUFFERPROC    blitFramebuffer;
+  bool                        scrollPending;
+  PuglRect                    scrollRect;
+  int                         scrollDx;
+  int                         scrollDy;
+  PuglGlFrameFunc             frameFunc; // context is detached if not NULL
+  void*                       frameData;
 } PuglX11GlSurface;
 
+/// View hints that determine the chosen GLX framebuffer configuration
+static const PuglViewHint puglX11GlConfigHints[] = {PUGL_RED_BITS,
+                                                    PUGL_GREEN_BITS,
+                                                    PUGL_BLUE_BITS,
+                                                    PUGL_ALPHA_BITS,
+                                                    PUGL_DEPTH_BITS,
+                                                    PUGL_STENCIL_BITS,
+                                                    PUGL_SAMPLES,
+                                                    PUGL_DOUBLE_BUFFER};
+
+#define PUGL_X11_GL_NUM_CONFIG_HINTS \
+  (sizeof(puglX11GlConfigHints) / sizeof(puglX11GlConfigHints[0]))
+
+/// Result of a GLX negotiation for one set of requested hints
+typedef struct {
+  int         screen;
+  int         requested[PUGL_X11_GL_NUM_CONFIG_HINTS];
+  int         resolved[PUGL_X11_GL_NUM_CONFIG_HINTS];
+  GLXFBConfig fb_config;
+  VisualID    visualid;
+} PuglX11GlConfig;
+
+struct PuglGlConfigCacheImpl {
+  PuglX11GlConfig* configs;
+  size_t           numConfigs;
+};
+
+PuglGlConfigCache*
+puglNewGlConfigCache(void)
+{
+  return (PuglGlConfigCache*)calloc(1, sizeof(PuglGlConfigCache));
+}
+
+void
+puglFreeGlConfigCache(PuglGlConfigCache* cache)
+{
+  if (cache) {
+    free(cache->configs);
+    free(cache);
+  }
+}
+
+static const PuglX11GlConfig*
+puglX11GlFindConfig(const PuglGlConfigCache* cache,
+                    const int                screen,
+                    const int*               requested)
+{
+  if (cache) {
+    for (size_t i = 0; i < cache->numConfigs; ++i) {
+      const PuglX11GlConfig* config = &cache->configs[i];
+      if (config->screen == screen &&
+          !memcmp(config->requested, requested, sizeof(config->requested))) {
+        return config;
+      }
+    }
+  }
+  return NULL;
+}
+
+static void
+puglX11GlAddConfig(PuglGlConfigCache* cache, const PuglX11GlConfig* config)
+{
+  if (cache) {
+    PuglX11GlConfig* configs = (PuglX11GlConfig*)realloc(
+      cache->configs, (cache->numConfigs + 1) * sizeof(PuglX11GlConfig));
+    if (configs) {
+      configs[cache->numConfigs++] = *config;
+      cache->configs               = configs;
+    }
+  }
+}
+
 static int
 puglX11GlHintValue(const int value)
 {
@@ -51,16 +147,11 @@ puglX11GlGetAttrib(Display* const display,
 }
 
 static PuglStatus
-puglX11GlConfigure(PuglView* view)
+puglX11GlChooseConfig(PuglView* view, PuglX11GlConfig* config)
 {
   PuglInternals* const impl    = view->impl;
-  const int            screen  = impl->screen;
   Display* const       display = impl->display;
 
-  PuglX11GlSurface* const surface =
-    (PuglX11GlSurface*)calloc(1, sizeof(PuglX11GlSurface));
-  impl->surface = surface;
-
   // clang-format off
   const int attrs[] = {GLX_X_RENDERABLE,  True,
                        GLX_X_VISUAL_TYPE, GLX_TRUE_COLOR,
@@ -78,65 +169,340 @@ puglX11GlConfigure(PuglView* view)
   // clang-format on
 
   int          n_fbc = 0;
-  GLXFBConfig* fbc   = glXChooseFBConfig(display, screen, attrs, &n_fbc);
+  GLXFBConfig* fbc   = glXChooseFBConfig(display, impl->screen, attrs, &n_fbc);
   if (n_fbc <= 0) {
     return PUGL_CREATE_CONTEXT_FAILED;
   }
 
-  surface->fb_config = fbc[0];
-  impl->vi           = glXGetVisualFromFBConfig(impl->display, fbc[0]);
+  XVisualInfo* vi = glXGetVisualFromFBConfig(display, fbc[0]);
+  if (!vi) {
+    XFree(fbc);
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
 
   // clang-format off
-  view->hints[PUGL_RED_BITS]      = puglX11GlGetAttrib(display, fbc[0], GLX_RED_SIZE);
-  view->hints[PUGL_GREEN_BITS]    = puglX11GlGetAttrib(display, fbc[0], GLX_GREEN_SIZE);
-  view->hints[PUGL_BLUE_BITS]     = puglX11GlGetAttrib(display, fbc[0], GLX_BLUE_SIZE);
-  view->hints[PUGL_ALPHA_BITS]    = puglX11GlGetAttrib(display, fbc[0], GLX_ALPHA_SIZE);
-  view->hints[PUGL_DEPTH_BITS]    = puglX11GlGetAttrib(display, fbc[0], GLX_DEPTH_SIZE);
-  view->hints[PUGL_STENCIL_BITS]  = puglX11GlGetAttrib(display, fbc[0], GLX_STENCIL_SIZE);
-  view->hints[PUGL_SAMPLES]       = puglX11GlGetAttrib(display, fbc[0], GLX_SAMPLES);
-  view->hints[PUGL_DOUBLE_BUFFER] = puglX11GlGetAttrib(display, fbc[0], GLX_DOUBLEBUFFER);
+  config->fb_config = fbc[0];
+  config->visualid  = vi->visualid;
+  config->resolved[0] = puglX11GlGetAttrib(display, fbc[0], GLX_RED_SIZE);
+  config->resolved[1] = puglX11GlGetAttrib(display, fbc[0], GLX_GREEN_SIZE);
+  config->resolved[2] = puglX11GlGetAttrib(display, fbc[0], GLX_BLUE_SIZE);
+  config->resolved[3] = puglX11GlGetAttrib(display, fbc[0], GLX_ALPHA_SIZE);
+  config->resolved[4] = puglX11GlGetAttrib(display, fbc[0], GLX_DEPTH_SIZE);
+  config->resolved[5] = puglX11GlGetAttrib(display, fbc[0], GLX_STENCIL_SIZE);
+  config->resolved[6] = puglX11GlGetAttrib(display, fbc[0], GLX_SAMPLES);
+  config->resolved[7] = puglX11GlGetAttrib(display, fbc[0], GLX_DOUBLEBUFFER);
   // clang-format on
 
+  XFree(vi);
+  XFree(fbc);
+
+  return PUGL_SUCCESS;
+}
+
+static XVisualInfo*
+puglX11GlGetVisual(Display* const display, const int screen, VisualID visualid)
+{
+  XVisualInfo pat;
+  int         n = 0;
+
+  pat.visualid = visualid;
+  pat.screen   = screen;
+
+  return XGetVisualInfo(display, VisualIDMask | VisualScreenMask, &pat, &n);
+}
+
+static PuglStatus
+puglX11GlConfigure(PuglView* view)
+{
+  PuglInternals* const     impl    = view->impl;
+  const int                screen  = impl->screen;
+  Display* const           display = impl->display;
+  PuglGlConfigCache* const cache   = (PuglGlConfigCache*)view->backendData;
+
+  PuglX11GlSurface* const surface =
+    (PuglX11GlSurface*)calloc(1, sizeof(PuglX11GlSurface));
+  impl->surface = surface;
+
+  PuglX11GlConfig config;
+  memset(&config, 0, sizeof(config));
+  config.screen = screen;
+  for (size_t i = 0; i < PUGL_X11_GL_NUM_CONFIG_HINTS; ++i) {
+    config.requested[i] = view->hints[puglX11GlConfigHints[i]];
+  }
+
+  // Views with identical hints share the result of the GLX negotiation
+  const PuglX11GlConfig* cached =
+    puglX11GlFindConfig(cache, screen, config.requested);
+  if (cached) {
+    impl->vi = puglX11GlGetVisual(display, screen, cached->visualid);
+    if (impl->vi) {
+      config = *cached;
+    }
+  }
+
+  if (!impl->vi) {
+    const PuglStatus st = puglX11GlChooseConfig(view, &config);
+    if (st) {
+      return st;
+    }
+
+    impl->vi = puglX11GlGetVisual(display, screen, config.visualid);
+    if (!impl->vi) {
+      return PUGL_CREATE_CONTEXT_FAILED;
+    }
+
+    if (!cached) {
+      puglX11GlAddConfig(cache, &config);
+    }
+  }
+
+  surface->fb_config = config.fb_config;
+  for (size_t i = 0; i < PUGL_X11_GL_NUM_CONFIG_HINTS; ++i) {
+    view->hints[puglX11GlConfigHints[i]] = config.resolved[i];
+  }
+
   char msg[256];
 
   snprintf(
     msg,
     sizeof(msg),
-    "Using visual 0x%lX: R=%d G=%d B=%d A=%d D=%d ST=%d DOUBLE=%d SAMPLES=%d\n",
+    "Using visual 0x%lX: R=%d G=%d B=%d A=%d D=%d ST=%d DOUBLE=%d SAMPLES=%d%s\n",
     impl->vi->visualid,
-    puglX11GlGetAttrib(display, fbc[0], GLX_RED_SIZE),
-    puglX11GlGetAttrib(display, fbc[0], GLX_GREEN_SIZE),
-    puglX11GlGetAttrib(display, fbc[0], GLX_BLUE_SIZE),
-    puglX11GlGetAttrib(display, fbc[0], GLX_ALPHA_SIZE),
-    puglX11GlGetAttrib(display, fbc[0], GLX_DEPTH_SIZE),
-    puglX11GlGetAttrib(display, fbc[0], GLX_STENCIL_SIZE),
-    puglX11GlGetAttrib(display, fbc[0], GLX_DOUBLEBUFFER),
-    puglX11GlGetAttrib(display, fbc[0], GLX_SAMPLES));
+    view->hints[PUGL_RED_BITS],
+    view->hints[PUGL_GREEN_BITS],
+    view->hints[PUGL_BLUE_BITS],
+    view->hints[PUGL_ALPHA_BITS],
+    view->hints[PUGL_DEPTH_BITS],
+    view->hints[PUGL_STENCIL_BITS],
+    view->hints[PUGL_DOUBLE_BUFFER],
+    view->hints[PUGL_SAMPLES],
+    cached ? " (cached)" : "");
 
   puglLog(view->world, PUGL_LOG_LEVEL_INFO, msg);
 
-  XFree(fbc);
-
   return PUGL_SUCCESS;
 }
 
+static bool
+puglX11GlHasExtension(const char* const extensions, const char* const name)
+{
+  const size_t len = strlen(name);
+  const char*  ext = extensions;
+
+  while (ext && (ext = strstr(ext, name))) {
+    if ((ext == extensions || ext[-1] == ' ') &&
+        (ext[len] == ' ' || ext[len] == '\0')) {
+      return true;
+    }
+    ext += len;
+  }
+  return false;
+}
+
+static int
+puglX11GlGetBufferAge(PuglView* const view, PuglX11GlSurface* const surface)
+{
+  if (!view->hints[PUGL_DOUBLE_BUFFER] || surface->presentedPartially) {
+    // Drawing goes to a buffer that still holds the last presented frame
+    return 1;
+  }
+  if (surface->hasBufferAge) {
+    unsigned int age = 0;
+    glXQueryDrawable(
+      view->impl->display, view->impl->win, GLX_BACK_BUFFER_AGE_EXT, &age);
+    return (int)age;
+  }
+  return 0;
+}
+
+static bool
+puglX11GlIsPartialDamage(const PuglView* const view,
+                         const PuglRects* const rects)
+{
+  if (!rects || rects->rectsCount <= 0) {
+    return false;
+  }
+  double area = 0.0;
+  for (int i = 0; i < rects->rectsCount; ++i) {
+    area += rects->rectsList[i].width * rects->rectsList[i].height;
+  }
+  return area < view->frame.width * view->frame.height;
+}
+
+static void
+puglX11GlPresentRects(PuglView* const         view,
+                      PuglX11GlSurface* const surface,
+                      const PuglRects* const  rects)
+{
+  // GLX window coordinates have their origin at the bottom left corner
+  const int height = (int)view->frame.height;
+  for (int i = 0; i < rects->rectsCount; ++i) {
+    const PuglRect* r  = rects->rectsList + i;
+    const int       x1 = (int)floor(r->x);
+    const int       y1 = (int)floor(r->y);
+    const int       x2 = (int)ceil(r->x + r->width);
+    const int       y2 = (int)ceil(r->y + r->height);
+    surface->copySubBuffer(
+      view->impl->display, view->impl->win, x1, height - y2, x2 - x1, y2 - y1);
+  }
+}
+
+static void
+puglX11GlDeleteFences(PuglX11GlSurface* const surface, const int count)
+{
+  for (int i = 0; i < count; ++i) {
+    surface->deleteSync(surface->fences[i]);
+  }
+  surface->fencesCount -= count;
+  memmove(surface->fences,
+          surface->fences + count,
+          (size_t)surface->fencesCount * sizeof(GLsync));
+}
+
+static void
+puglX11GlLimitFramesInFlight(PuglView* const         view,
+                             PuglX11GlSurface* const surface)
+{
+  int maxFrames = view->hints[PUGL_MAX_FRAMES_IN_FLIGHT];
+  if (maxFrames > PUGL_X11_GL_MAX_FENCES) {
+    maxFrames = PUGL_X11_GL_MAX_FENCES;
+  }
+  if (!surface->fenceSync || maxFrames <= 0) {
+    if (surface->fencesCount > 0) {
+      puglX11GlDeleteFences(surface, surface->fencesCount);
+    }
+    return;
+  }
+
+  if (surface->fencesCount >= maxFrames) {
+    puglX11GlDeleteFences(surface, surface->fencesCount - maxFrames + 1);
+  }
+
+  GLsync fence = surface->fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  if (fence) {
+    surface->fences[surface->fencesCount++] = fence;
+  }
+
+  // Block until no more than maxFrames frames are queued
+  if (surface->fencesCount >= maxFrames) {
+    surface->clientWaitSync(
+      surface->fences[0], GL_SYNC_FLUSH_COMMANDS_BIT, (GLuint64)1000000000);
+    puglX11GlDeleteFences(surface, 1);
+  }
+}
+
+/// Copy the front buffer with the pending scroll applied into the back buffer
+static void
+puglX11GlApplyScroll(PuglView* const view, PuglX11GlSurface* const surface)
+{
+  const int       width  = (int)view->frame.width;
+  const int       height = (int)view->frame.height;
+  const PuglRect* r      = &surface->scrollRect;
+  const int       dx     = surface->scrollDx;
+  const int       dy     = surface->scrollDy;
+
+  // Destination area within the scrolled rectangle in window coordinates
+  const int x0 = (int)r->x + (dx > 0 ? dx : 0);
+  const int y0 = (int)r->y + (dy > 0 ? dy : 0);
+  const int x1 = (int)(r->x + r->width) + (dx < 0 ? dx : 0);
+  const int y1 = (int)(r->y + r->height) + (dy < 0 ? dy : 0);
+
+  GLint readFramebuffer = 0;
+  GLint drawFramebuffer = 0;
+  GLint readBuffer      = 0;
+  GLint drawBuffer      = 0;
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer);
+  glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer);
+  surface->bindFramebuffer(GL_FRAMEBUFFER, 0);
+  glGetIntegerv(GL_READ_BUFFER, &readBuffer);
+  glGetIntegerv(GL_DRAW_BUFFER, &drawBuffer);
+  const GLboolean scissor = glIsEnabled(GL_SCISSOR_TEST);
+  if (scissor) {
+    glDisable(GL_SCISSOR_TEST);
+  }
+
+  glReadBuffer(GL_FRONT);
+  glDrawBuffer(GL_BACK);
+  surface->blitFramebuffer(0,
+                           0,
+                           width,
+                           height,
+                           0,
+                           0,
+                           width,
+                           height,
+                           GL_COLOR_BUFFER_BIT,
+                           GL_NEAREST);
+  if (x1 > x0 && y1 > y0) {
+    // GLX window coordinates have their origin at the bottom left corner
+    surface->blitFramebuffer(x0 - dx,
+                             height - (y1 - dy),
+                             x1 - dx,
+                             height - (y0 - dy),
+                             x0,
+                             height - y1,
+                             x1,
+                             height - y0,
+                             GL_COLOR_BUFFER_BIT,
+                             GL_NEAREST);
+  }
+
+  glReadBuffer((GLenum)readBuffer);
+  glDrawBuffer((GLenum)drawBuffer);
+  if (scissor) {
+    glEnable(GL_SCISSOR_TEST);
+  }
+  surface->bindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)readFramebuffer);
+  surface->bindFramebuffer(GL_DRAW_FRAMEBUFFER, (GLuint)drawFramebuffer);
+}
+
 static PuglStatus
 puglX11GlEnter(PuglView*              view,
-               const PuglEventExpose* PUGL_UNUSED(expose),
+               const PuglEventExpose* expose,
                PuglRects*             PUGL_UNUSED(rects))
 {
   PuglX11GlSurface* surface = (PuglX11GlSurface*)view->impl->surface;
+  if (surface->frameFunc) {
+    // Frames are rendered by another thread, see puglSetGlFrameFunc()
+    return expose ? PUGL_SUCCESS : PUGL_FAILURE;
+  }
+
   glXMakeCurrent(view->impl->display, view->impl->win, surface->ctx);
+  if (expose) {
+    view->bufferAge = puglX11GlGetBufferAge(view, surface);
+    if (surface->scrollPending) {
+      surface->scrollPending = false;
+      puglX11GlApplyScroll(view, surface);
+      view->bufferAge = 1; // back buffer now holds the scrolled last frame
+    }
+  }
   return PUGL_SUCCESS;
 }
 
 static PuglStatus
 puglX11GlLeave(PuglView*              view,
                const PuglEventExpose* expose,
-               PuglRects*             PUGL_UNUSED(rects))
+               PuglRects*             rects)
 {
+  PuglX11GlSurface* surface = (PuglX11GlSurface*)view->impl->surface;
+  if (surface->frameFunc) {
+    if (expose) {
+      surface->frameFunc(view, surface->frameData, expose, view->frame);
+      return PUGL_SUCCESS;
+    }
+    return PUGL_FAILURE;
+  }
+
   if (expose && view->hints[PUGL_DOUBLE_BUFFER]) {
-    glXSwapBuffers(view->impl->display, view->impl->win);
+    if (view->hints[PUGL_PARTIAL_PRESENT] && surface->copySubBuffer &&
+        puglX11GlIsPartialDamage(view, rects)) {
+      puglX11GlPresentRects(view, surface, rects);
+      surface->presentedPartially = true;
+    } else {
+      glXSwapBuffers(view->impl->display, view->impl->win);
+      surface->presentedPartially = false;
+    }
+    puglX11GlLimitFramesInFlight(view, surface);
   }
 
   glXMakeCurrent(view->impl->display, None, NULL);
@@ -144,6 +510,111 @@ puglX11GlLeave(PuglView*              view,
   return PUGL_SUCCESS;
 }
 
+/// Return true if the current context supports fence sync objects
+static bool
+puglX11GlHasSync(void)
+{
+  const char* const version = (const char*)glGetString(GL_VERSION);
+  int               major   = 0;
+  int               minor   = 0;
+  if (version && sscanf(version, "%d.%d", &major, &minor) == 2 &&
+      (major > 3 || (major == 3 && minor >= 2))) {
+    return true;
+  }
+
+  const char* const extensions = (const char*)glGetString(GL_EXTENSIONS);
+  return extensions && puglX11GlHasExtension(extensions, "GL_ARB_sync");
+}
+
+static void
+puglX11GlUpdateSwapInterval(PuglView* const view)
+{
+  PuglInternals* const    impl    = view->impl;
+  PuglX11GlSurface* const surface = (PuglX11GlSurface*)impl->surface;
+
+  unsigned int interval = 0;
+  unsigned int tear     = 0;
+  glXQueryDrawable(impl->display, impl->win, GLX_SWAP_INTERVAL_EXT, &interval);
+  if (surface->hasSwapControlTear) {
+    glXQueryDrawable(impl->display, impl->win, GLX_LATE_SWAPS_TEAR_EXT, &tear);
+  }
+
+  view->hints[PUGL_SWAP_INTERVAL] = (int)interval;
+  view->hints[PUGL_ADAPTIVE_SYNC] = tear ? PUGL_TRUE : PUGL_FALSE;
+}
+
+static PuglStatus
+puglX11GlSetSwapInterval(PuglView* const view, int interval)
+{
+  PuglInternals* const    impl    = view->impl;
+  PuglX11GlSurface* const surface = (PuglX11GlSurface*)impl->surface;
+
+  if (!surface || !surface->swapInterval || surface->frameFunc) {
+    return PUGL_UNSUPPORTED_TYPE;
+  }
+
+  if (interval < 0 && !surface->hasSwapControlTear) {
+    interval = -interval; // Adaptive vsync is not available
+  }
+
+  // May be called while drawing, so restore whatever context is current
+  GLXContext  prevContext  = glXGetCurrentContext();
+  GLXDrawable prevDrawable = glXGetCurrentDrawable();
+  glXMakeCurrent(impl->display, impl->win, surface->ctx);
+  surface->swapInterval(impl->display, impl->win, interval);
+  glXMakeCurrent(impl->display, prevDrawable, prevContext);
+
+  puglX11GlUpdateSwapInterval(view);
+
+  return PUGL_SUCCESS;
+}
+
+static PuglStatus
+puglX11GlScroll(PuglView* const view, PuglRect rect, int dx, int dy)
+{
+  PuglX11GlSurface* const surface = (PuglX11GlSurface*)view->impl->surface;
+
+  if (!surface || !surface->blitFramebuffer ||
+      !view->hints[PUGL_DOUBLE_BUFFER] || surface->frameFunc) {
+    return PUGL_UNSUPPORTED_TYPE;
+  }
+
+  // Scrolls of the same rectangle before the next expose are combined
+  if (surface->scrollPending) {
+    const PuglRect* r = &surface->scrollRect;
+    if (r->x != rect.x || r->y != rect.y || r->width != rect.width ||
+        r->height != rect.height ||
+        abs(surface->scrollDx + dx) >= (int)rect.width ||
+        abs(surface->scrollDy + dy) >= (int)rect.height) {
+      return PUGL_UNSUPPORTED_TYPE;
+    }
+    surface->scrollDx += dx;
+    surface->scrollDy += dy;
+  } else {
+    surface->scrollPending = true;
+    surface->scrollRect    = rect;
+    surface->scrollDx      = dx;
+    surface->scrollDy      = dy;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+/// Return true if the current context supports glBlitFramebuffer()
+static bool
+puglX11GlHasBlit(void)
+{
+  const char* const version = (const char*)glGetString(GL_VERSION);
+  int               major   = 0;
+  if (version && sscanf(version, "%d.", &major) == 1 && major >= 3) {
+    return true;
+  }
+
+  const char* const extensions = (const char*)glGetString(GL_EXTENSIONS);
+  return extensions &&
+         puglX11GlHasExtension(extensions, "GL_ARB_framebuffer_object");
+}
+
 static PuglStatus
 puglX11GlCreate(PuglView* view)
 {
@@ -169,10 +640,6 @@ puglX11GlCreate(PuglView* view)
     (PFNGLXCREATECONTEXTATTRIBSARBPROC)glXGetProcAddress(
       (const uint8_t*)"glXCreateContextAttribsARB");
 
-  PFNGLXSWAPINTERVALEXTPROC glXSwapIntervalEXT =
-    (PFNGLXSWAPINTERVALEXTPROC)glXGetProcAddress(
-      (const uint8_t*)"glXSwapIntervalEXT");
-
   surface->ctx = create_context(display, fb_config, 0, True, ctx_attrs);
   if (!surface->ctx) {
     surface->ctx =
@@ -183,22 +650,62 @@ puglX11GlCreate(PuglView* view)
     return PUGL_CREATE_CONTEXT_FAILED;
   }
 
-  const int swapInterval = view->hints[PUGL_SWAP_INTERVAL];
-  if (glXSwapIntervalEXT && swapInterval != PUGL_DONT_CARE) {
-    puglX11GlEnter(view, NULL, NULL);
-    glXSwapIntervalEXT(display, impl->win, swapInterval);
-    puglX11GlLeave(view, NULL, NULL);
+  const char* const extensions = glXQueryExtensionsString(display, impl->screen);
+
+  surface->hasBufferAge =
+    puglX11GlHasExtension(extensions, "GLX_EXT_buffer_age");
+
+  if (puglX11GlHasExtension(extensions, "GLX_MESA_copy_sub_buffer")) {
+    surface->copySubBuffer = (PFNGLXCOPYSUBBUFFERMESAPROC)glXGetProcAddress(
+      (const uint8_t*)"glXCopySubBufferMESA");
+  }
+
+  if (puglX11GlHasExtension(extensions, "GLX_EXT_swap_control")) {
+    surface->swapInterval = (PFNGLXSWAPINTERVALEXTPROC)glXGetProcAddress(
+      (const uint8_t*)"glXSwapIntervalEXT");
   }
 
+  surface->hasSwapControlTear =
+    puglX11GlHasExtension(extensions, "GLX_EXT_swap_control_tear");
+
+  puglX11GlEnter(view, NULL, NULL);
+
+  if (puglX11GlHasSync()) {
+    surface->fenceSync =
+      (PFNGLFENCESYNCPROC)glXGetProcAddress((const uint8_t*)"glFenceSync");
+    surface->clientWaitSync = (PFNGLCLIENTWAITSYNCPROC)glXGetProcAddress(
+      (const uint8_t*)"glClientWaitSync");
+    surface->deleteSync =
+      (PFNGLDELETESYNCPROC)glXGetProcAddress((const uint8_t*)"glDeleteSync");
+    if (!surface->clientWaitSync || !surface->deleteSync) {
+      surface->fenceSync = NULL;
+    }
+  }
+
+  if (puglX11GlHasBlit()) {
+    surface->bindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)glXGetProcAddress(
+      (const uint8_t*)"glBindFramebuffer");
+    surface->blitFramebuffer = (PFNGLBLITFRAMEBUFFERPROC)glXGetProcAddress(
+      (const uint8_t*)"glBlitFramebuffer");
+    if (!surface->bindFramebuffer) {
+      surface->blitFramebuffer = NULL;
+    }
+  }
+
+  puglX11GlLeave(view, NULL, NULL);
+
   glXGetConfig(impl->display,
                impl->vi,
                GLX_DOUBLEBUFFER,
                &view->hints[PUGL_DOUBLE_BUFFER]);
 
-  glXQueryDrawable(display,
-                   impl->win,
-                   GLX_SWAP_INTERVAL_EXT,
-                   (unsigned int*)&view->hints[PUGL_SWAP_INTERVAL]);
+  const int swapInterval = view->hints[PUGL_SWAP_INTERVAL];
+  if (swapInterval != PUGL_DONT_CARE) {
+    puglX11GlSetSwapInterval(
+      view, view->hints[PUGL_ADAPTIVE_SYNC] ? -swapInterval : swapInterval);
+  } else {
+    puglX11GlUpdateSwapInterval(view);
+  }
 
   return PUGL_SUCCESS;
 }
@@ -208,6 +715,16 @@ puglX11GlDestroy(PuglView* view)
 {
   PuglX11GlSurface* surface = (PuglX11GlSurface*)view->impl->surface;
   if (surface) {
+    if (surface->frameFunc) {
+      // Waits until the other thread has finished using the context
+      surface->frameFunc(view, surface->frameData, NULL, view->frame);
+      surface->frameFunc = NULL;
+    }
+    if (surface->fencesCount > 0) {
+      puglX11GlEnter(view, NULL, NULL);
+      puglX11GlDeleteFences(surface, surface->fencesCount);
+      puglX11GlLeave(view, NULL, NULL);
+    }
     glXDestroyContext(view->impl->display, surface->ctx);
     free(surface);
     view->impl->surface = NULL;
@@ -233,6 +750,54 @@ puglLeaveContext(PuglView* view)
   return view->backend->leave(view, NULL, NULL);
 }
 
+PuglStatus
+puglSetGlFrameFunc(PuglView* view, PuglGlFrameFunc func, void* data)
+{
+  PuglX11GlSurface* const surface = (PuglX11GlSurface*)view->impl->surface;
+  if (!surface) {
+    return PUGL_FAILURE;
+  }
+
+  if (surface->frameFunc &&
+      (surface->frameFunc != func || surface->frameData != data)) {
+    // Waits until the other thread has finished using the context
+    surface->frameFunc(view, surface->frameData, NULL, view->frame);
+  }
+
+  surface->frameFunc = func;
+  surface->frameData = data;
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglEnterGlFrame(PuglView* view)
+{
+  PuglX11GlSurface* const surface = (PuglX11GlSurface*)view->impl->surface;
+  if (!surface || !surface->frameFunc) {
+    return PUGL_FAILURE;
+  }
+
+  glXMakeCurrent(view->impl->display, view->impl->win, surface->ctx);
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglLeaveGlFrame(PuglView* view, bool present)
+{
+  PuglX11GlSurface* const surface = (PuglX11GlSurface*)view->impl->surface;
+  if (!surface || !surface->frameFunc) {
+    return PUGL_FAILURE;
+  }
+
+  if (present && view->hints[PUGL_DOUBLE_BUFFER]) {
+    glXSwapBuffers(view->impl->display, view->impl->win);
+    puglX11GlLimitFramesInFlight(view, surface);
+  }
+
+  glXMakeCurrent(view->impl->display, None, NULL);
+  return PUGL_SUCCESS;
+}
+
 const PuglBackend*
 puglGlBackend(void)
 {
@@ -241,7 +806,9 @@ puglGlBackend(void)
                                       puglX11GlDestroy,
                                       puglX11GlEnter,
                                       puglX11GlLeave,
-                                      puglStubGetContext};
+                                      puglStubGetContext,
+                                      puglX11GlSetSwapInterval,
+                                      puglX11GlScroll};
 
   return &backend;
 }
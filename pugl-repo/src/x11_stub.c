@@ -52,6 +52,8 @@ puglStubBackend(void)
     puglStubEnter,
     puglStubLeave,
     puglStubGetContext,
+    NULL,
+    NULL,
   };
 
   return &backend;
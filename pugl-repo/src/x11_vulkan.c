@@ -89,7 +89,9 @@ puglVulkanBackend(void)
                                       puglStubDestroy,
                                       puglStubEnter,
                                       puglStubLeave,
-                                      puglStubGetContext};
+                                      puglStubGetContext,
+                                      NULL,
+                                      NULL};
 
   return &backend;
 }
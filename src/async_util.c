@@ -178,3 +178,60 @@ bool lpugl_async_mutex_wait_millis(Mutex* mutex, int timeoutMillis)
 
 #endif
 }
+
+
+#if defined(LPUGL_ASYNC_USE_PTHREAD)
+static void* threadMain(void* arg)
+{
+    Thread* thread = arg;
+    thread->func(thread->arg);
+    return NULL;
+}
+#elif defined(LPUGL_ASYNC_USE_WINTHREAD)
+static DWORD WINAPI threadMain(LPVOID arg)
+{
+    Thread* thread = arg;
+    thread->func(thread->arg);
+    return 0;
+}
+#elif defined(LPUGL_ASYNC_USE_STDTHREAD)
+static int threadMain(void* arg)
+{
+    Thread* thread = arg;
+    thread->func(thread->arg);
+    return 0;
+}
+#endif
+
+bool lpugl_async_thread_start(Thread* thread, void (*func)(void* arg), void* arg)
+{
+    thread->func = func;
+    thread->arg  = arg;
+#if defined(LPUGL_ASYNC_USE_PTHREAD)
+    return pthread_create(&thread->thread, NULL, threadMain, thread) == 0;
+
+#elif defined(LPUGL_ASYNC_USE_WINTHREAD)
+    thread->thread = CreateThread(NULL, 0, threadMain, thread, 0, NULL);
+    return thread->thread != NULL;
+
+#elif defined(LPUGL_ASYNC_USE_STDTHREAD)
+    return thrd_create(&thread->thread, threadMain, thread) == thrd_success;
+#endif
+}
+
+void lpugl_async_thread_join(Thread* thread)
+{
+#if defined(LPUGL_ASYNC_USE_PTHREAD)
+    int rc = pthread_join(thread->thread, NULL);
+    if (rc != 0) { async_util_abort(rc, __LINE__); }
+
+#elif defined(LPUGL_ASYNC_USE_WINTHREAD)
+    DWORD rc = WaitForSingleObject(thread->thread, INFINITE);
+    if (rc != WAIT_OBJECT_0) { async_util_abort(rc, __LINE__); }
+    CloseHandle(thread->thread);
+
+#elif defined(LPUGL_ASYNC_USE_STDTHREAD)
+    int rc = thrd_join(thread->thread, NULL);
+    if (rc != thrd_success) { async_util_abort(rc, __LINE__); }
+#endif
+}
@@ -153,6 +153,30 @@ static inline void async_lock_acquire(Lock* lock)
 
 /* -------------------------------------------------------------------------------------------- */
 
+static inline bool async_lock_tryacquire(Lock* lock) 
+{
+#if defined(LPUGL_ASYNC_USE_PTHREAD)
+    int rc = pthread_mutex_trylock(&lock->lock);
+    if (rc == 0 || rc == EBUSY) {
+        return (rc == 0);
+    } else {
+        return async_util_abort(rc, __LINE__);
+    }
+#elif defined(LPUGL_ASYNC_USE_WINTHREAD)
+    return TryEnterCriticalSection(&lock->lock) != 0;
+
+#elif defined(LPUGL_ASYNC_USE_STDTHREAD)
+    int rc = mtx_trylock(&lock->lock);
+    if (rc == thrd_success || rc == thrd_busy) {
+        return rc == thrd_success;
+    } else {
+        return async_util_abort(rc, __LINE__); 
+    }
+#endif
+}
+
+/* -------------------------------------------------------------------------------------------- */
+
 static inline void async_lock_release(Lock* lock)
 {
 #if defined(LPUGL_ASYNC_USE_PTHREAD)
@@ -294,5 +318,32 @@ static inline void async_mutex_notify(Mutex* mutex)
 
 /* -------------------------------------------------------------------------------------------- */
 
+typedef struct
+{
+#if defined(LPUGL_ASYNC_USE_PTHREAD)
+    pthread_t             thread;
+
+#elif defined(LPUGL_ASYNC_USE_WINTHREAD)
+    HANDLE                thread;
+
+#elif defined(LPUGL_ASYNC_USE_STDTHREAD)
+    thrd_t                thread;
+#endif
+    void                  (*func)(void* arg);
+    void*                 arg;
+} Thread;
+
+/* -------------------------------------------------------------------------------------------- */
+
+#define async_thread_start lpugl_async_thread_start
+bool async_thread_start(Thread* thread, void (*func)(void* arg), void* arg);
+
+/* -------------------------------------------------------------------------------------------- */
+
+#define async_thread_join lpugl_async_thread_join
+void async_thread_join(Thread* thread);
+
+/* -------------------------------------------------------------------------------------------- */
+
 #endif /* LPUGL_ASYNC_UTIL_H */
 
@@ -8,6 +8,23 @@
 
 struct LpuglWorld;
 
+/*
+ * Pixel data of a view snapshot. The callbacks get view == NULL if the
+ * view was closed and drawing == true within exposure event handling.
+ */
+typedef struct LpuglSnapshot {
+
+    int                  width;
+    int                  height;
+    int                  stride;
+    const char*          format;   // "RGB24" or "ARGB32", native endian 32 bit per pixel
+    void*                data;     // NULL while asynchronous readback is pending
+    bool                 (*isReady)(struct LpuglSnapshot* snapshot, PuglView* view, bool drawing);
+    bool                 (*map)    (struct LpuglSnapshot* snapshot, PuglView* view, bool drawing);
+    void                 (*release)(struct LpuglSnapshot* snapshot, PuglView* view, bool drawing);
+
+} LpuglSnapshot;
+
 typedef struct LpuglBackend {
     
     int                  magic;
@@ -15,9 +32,15 @@ typedef struct LpuglBackend {
     struct LpuglWorld*   world;
     int                  used;
     const PuglBackend*   puglBackend;
-    int                  (*newDrawContext)(lua_State* L, void* context);
+    void*                puglBackendData;
+    int                  (*newDrawContext)(lua_State* L);
+    int                  (*bindDrawContext)(lua_State* L, int contextIdx, int backendIdx, void* context);
     int                  (*finishDrawContext)(lua_State* L, int contextIdx);
     void                 (*closeBackend)(lua_State* L, int backendIdx);
+    LpuglSnapshot*       (*newSnapshot)(struct LpuglBackend* backend, PuglView* view, bool drawing,
+                                        PuglRect rect, double viewHeight);
+    void                 (*setRenderer)(lua_State* L, struct LpuglBackend* backend, PuglView* view,
+                                        int rendererIdx); // rendererIdx == 0 removes the renderer
 
 } LpuglBackend;
 
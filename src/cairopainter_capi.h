@@ -0,0 +1,182 @@
+#ifndef LPUGL_CAIROPAINTER_CAPI_H
+#define LPUGL_CAIROPAINTER_CAPI_H
+
+#define LPUGL_CAIROPAINTER_CAPI_ID_STRING     "_capi_lpugl_cairopainter"
+#define LPUGL_CAIROPAINTER_CAPI_VERSION_MAJOR  0
+#define LPUGL_CAIROPAINTER_CAPI_VERSION_MINOR  1
+#define LPUGL_CAIROPAINTER_CAPI_VERSION_PATCH  0
+
+#ifndef LPUGL_CAIROPAINTER_CAPI_IMPLEMENT_SET_CAPI
+#  define LPUGL_CAIROPAINTER_CAPI_IMPLEMENT_SET_CAPI 0
+#endif
+
+#ifndef LPUGL_CAIROPAINTER_CAPI_IMPLEMENT_GET_CAPI
+#  define LPUGL_CAIROPAINTER_CAPI_IMPLEMENT_GET_CAPI 0
+#endif
+
+#ifdef __cplusplus
+
+extern "C" {
+
+struct lpugl_cairopainter;
+struct lpugl_cairopainter_capi;
+struct lpugl_cairotile;
+
+#else /* __cplusplus */
+
+typedef struct lpugl_cairopainter      lpugl_cairopainter;
+typedef struct lpugl_cairopainter_capi lpugl_cairopainter_capi;
+typedef struct lpugl_cairotile         lpugl_cairotile;
+
+#endif /* ! __cplusplus */
+
+/**
+ * Tile of a view that is to be painted by a painter of an lpugl_cairo backend.
+ */
+struct lpugl_cairotile
+{
+    /**
+     * Identifies the view. The same painter may be set for several views.
+     */
+    const void* view;
+
+    /**
+     * Area of the tile in view coordinates. The cairo context is clipped
+     * to this area.
+     */
+    int x;
+    int y;
+    int width;
+    int height;
+
+    /**
+     * Size of the view.
+     */
+    int viewWidth;
+    int viewHeight;
+
+    /**
+     * Index of the painting thread: 0 for the world's thread, 1..n for the
+     * tile threads of the backend.
+     */
+    int thread;
+};
+
+/**
+ *  LPugl Cairo Painter C API.
+ *
+ *  Implemented by objects that can be set as painter for views of an
+ *  lpugl_cairo backend. Tiles of the damaged region are painted in parallel
+ *  by the world's thread and by the tile threads of the backend.
+ */
+struct lpugl_cairopainter_capi
+{
+    int version_major;
+    int version_minor;
+    int version_patch;
+
+    /**
+     * May point to another (incompatible) version of this API implementation.
+     * NULL if no such implementation exists.
+     */
+    void* next_capi;
+
+    /**
+     * Must return a valid pointer if the Lua object at the given stack
+     * index is a valid painter, otherwise must return NULL.
+     *
+     * To keep the painter beyond this call, the function retainPainter()
+     * is called (see below).
+     */
+    lpugl_cairopainter* (*toPainter)(lua_State* L, int index);
+
+    /**
+     * Increases the reference counter of the painter. Must be thread safe.
+     */
+    void (*retainPainter)(lpugl_cairopainter* p);
+
+    /**
+     * Decreases the reference counter of the painter and destructs the
+     * painter if no reference is left. Must be thread safe.
+     */
+    void (*releasePainter)(lpugl_cairopainter* p);
+
+    /**
+     * Paints the whole area of the tile into the given cairo context, which
+     * is translated to view coordinates. May be called concurrently from
+     * different threads for different tiles, therefore it must be thread safe.
+     *
+     * The target of the context is an RGB24 image surface that is reused for
+     * the tile at the same position in later frames and is not cleared, i.e.
+     * pixels that are not painted keep the content of a previous frame.
+     */
+    void (*paintTile)(lpugl_cairopainter* p, cairo_t* cr, const lpugl_cairotile* tile);
+};
+
+#if LPUGL_CAIROPAINTER_CAPI_IMPLEMENT_SET_CAPI
+/**
+ * Sets the LPugl Cairo Painter C API into the metatable at the given index.
+ */
+static int lpugl_cairopainter_set_capi(lua_State* L, int index, const lpugl_cairopainter_capi* capi)
+{
+    lua_pushlstring(L, LPUGL_CAIROPAINTER_CAPI_ID_STRING, strlen(LPUGL_CAIROPAINTER_CAPI_ID_STRING));   /* -> key */
+    void** udata = (void**) lua_newuserdata(L, sizeof(void*) + strlen(LPUGL_CAIROPAINTER_CAPI_ID_STRING) + 1); /* -> key, value */
+    *udata = (void*)capi;
+    strcpy((char*)(udata + 1), LPUGL_CAIROPAINTER_CAPI_ID_STRING); /* -> key, value */
+    lua_rawset(L, (index < 0) ? (index - 2) : index);          /* -> */
+    return 0;
+}
+#endif /* LPUGL_CAIROPAINTER_CAPI_IMPLEMENT_SET_CAPI */
+
+#if LPUGL_CAIROPAINTER_CAPI_IMPLEMENT_GET_CAPI
+/**
+ * Gives the associated LPugl Cairo Painter C API for the object at the given stack index.
+ * Returns NULL, if the object at the given stack index does not have an
+ * associated C API or only has a C API with incompatible version number.
+ * If errorReason is not NULL it receives the error reason in this case:
+ * 1 for incompatible version nummber and 2 for no associated C API at all.
+ */
+static const lpugl_cairopainter_capi* lpugl_cairopainter_get_capi(lua_State* L, int index, int* errorReason)
+{
+    if (luaL_getmetafield(L, index, LPUGL_CAIROPAINTER_CAPI_ID_STRING) != LUA_TNIL)   /* -> _capi */
+    {
+        const void** udata = (const void**) lua_touserdata(L, -1);               /* -> _capi */
+
+        if (   udata
+            && (lua_rawlen(L, -1) >= sizeof(void*) + strlen(LPUGL_CAIROPAINTER_CAPI_ID_STRING) + 1)
+            && (memcmp((char*)(udata + 1), LPUGL_CAIROPAINTER_CAPI_ID_STRING,
+                       strlen(LPUGL_CAIROPAINTER_CAPI_ID_STRING) + 1) == 0))
+        {
+            const lpugl_cairopainter_capi* capi = (const lpugl_cairopainter_capi*) *udata; /* -> _capi */
+            while (capi) {
+                if (   capi->version_major == LPUGL_CAIROPAINTER_CAPI_VERSION_MAJOR
+                    && capi->version_minor >= LPUGL_CAIROPAINTER_CAPI_VERSION_MINOR)
+                {                                                                 /* -> _capi */
+                    lua_pop(L, 1);                                                /* -> */
+                    return capi;
+                }
+                capi = (const lpugl_cairopainter_capi*) capi->next_capi;
+            }
+            if (errorReason) {
+                *errorReason = 1;
+            }
+        } else {                                                                  /* -> _capi */
+            if (errorReason) {
+                *errorReason = 2;
+            }
+        }
+        lua_pop(L, 1);                                                            /* -> */
+    } else {                                                                      /* -> */
+        if (errorReason) {
+            *errorReason = 2;
+        }
+    }
+    return NULL;
+}
+#endif /* LPUGL_CAIROPAINTER_CAPI_IMPLEMENT_GET_CAPI */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LPUGL_CAIROPAINTER_CAPI_H */
@@ -0,0 +1,467 @@
+#define LPUGL_CHANNEL_CAPI_IMPLEMENT_SET_CAPI 1
+
+#include "base.h"
+
+#include "lpugl.h"
+#include "channel.h"
+#include "world.h"
+#include "error.h"
+#include "channel_capi.h"
+
+/* ============================================================================================ */
+
+static const char* const LPUGL_CHANNEL_CLASS_NAME = "lpugl.channel";
+
+static LpuglChannel* global_channel_list = NULL;
+
+/* ============================================================================================ */
+
+typedef struct ChannelUserData {
+    LpuglChannel* channel;
+    bool          restricted;
+} ChannelUserData;
+
+/* ============================================================================================ */
+
+static void setupChannelMeta(lua_State* L);
+
+static int pushChannelMeta(lua_State* L)
+{
+    if (luaL_newmetatable(L, LPUGL_CHANNEL_CLASS_NAME)) {
+        setupChannelMeta(L);
+    }
+    return 1;
+}
+
+/* ============================================================================================ */
+
+/*
+ * Takes all pushed messages, returns them in the order they were pushed.
+ */
+static LpuglChannelMsg* takeMessages(LpuglChannel* channel)
+{
+    LpuglChannelMsg* msgs;
+    do {
+        msgs = atomic_get_ptr(&channel->head);
+    } while (msgs && !atomic_set_ptr_if_equal(&channel->head, msgs, NULL));
+
+    LpuglChannelMsg* rslt = NULL;
+    while (msgs) {
+        LpuglChannelMsg* next = msgs->next;
+        msgs->next = rslt;
+        rslt = msgs;
+        msgs = next;
+    }
+    return rslt;
+}
+
+static void freeMessages(LpuglChannelMsg* msgs)
+{
+    while (msgs) {
+        LpuglChannelMsg* next = msgs->next;
+        free(msgs);
+        msgs = next;
+    }
+}
+
+/* ============================================================================================ */
+
+/*
+ * Can be called from any thread. Returns 0 on success, 1 if the channel is closed
+ * and 2 if out of memory.
+ */
+static int pushMessage(LpuglChannel* channel, const char* data, size_t len)
+{
+    if (atomic_get(&channel->closed)) {
+        return 1;
+    }
+    LpuglChannelMsg* msg = malloc(offsetof(LpuglChannelMsg, data) + len);
+    if (!msg) {
+        return 2;
+    }
+    msg->len = len;
+    memcpy(msg->data, data, len);
+
+    LpuglChannelMsg* head;
+    do {
+        head = atomic_get_ptr(&channel->head);
+        msg->next = head;
+    } while (!atomic_set_ptr_if_equal(&channel->head, head, msg));
+
+    // awakeSent is reset before the messages are taken, so one awake per batch is sufficient
+    if (atomic_get(&channel->world->awakeSent) == 0) {
+        lpugl_world_awake(channel->world);
+    }
+    return 0;
+}
+
+/* ============================================================================================ */
+
+static void retainChannel(LpuglChannel* channel)
+{
+    atomic_inc(&channel->used);
+}
+
+static void releaseChannel(LpuglChannel* channel)
+{
+    if (atomic_dec(&channel->used) <= 0) {
+        freeMessages(takeMessages(channel));
+        lpugl_world_release(channel->world);
+        free(channel);
+    }
+}
+
+/* ============================================================================================ */
+
+/*
+ * Must be called on the world's thread.
+ */
+static bool closeChannel(LpuglChannel* channel)
+{
+    if (!atomic_set_if_equal(&channel->closed, 0, 1)) {
+        return false;
+    }
+    async_mutex_lock(lpugl_global_lock);
+        LpuglChannel** c = &global_channel_list;
+        while (*c && *c != channel) {
+            c = &(*c)->nextGlobal;
+        }
+        if (*c) {
+            *c = channel->nextGlobal;
+        }
+    async_mutex_unlock(lpugl_global_lock);
+
+    LpuglWorld* world = channel->world;
+    LpuglChannel** c2 = &world->channels;
+    while (*c2 && *c2 != channel) {
+        c2 = &(*c2)->nextChannel;
+    }
+    if (*c2) {
+        *c2 = channel->nextChannel;
+    }
+    world->channelsChanged += 1;
+
+    freeMessages(takeMessages(channel));
+    return true;
+}
+
+/* ============================================================================================ */
+
+int lpugl_channel_new(lua_State* L, LpuglWorld* world, int worldIdx, int funcIdx)
+{
+    ChannelUserData* udata = lua_newuserdata(L, sizeof(ChannelUserData));  /* -> udata */
+    memset(udata, 0, sizeof(ChannelUserData));
+    pushChannelMeta(L);                                                     /* -> udata, meta */
+    lua_setmetatable(L, -2);                                                /* -> udata */
+
+    LpuglChannel* channel = calloc(1, sizeof(LpuglChannel));
+    if (!channel) {
+        return lpugl_ERROR_OUT_OF_MEMORY(L);
+    }
+    udata->channel = channel;
+    atomic_set(&channel->used, 1);
+    channel->id    = atomic_inc(&lpugl_id_counter);
+    channel->world = world;
+    atomic_inc(&world->used);
+
+    lua_newtable(L);                                                        /* -> udata, uservalue */
+    lua_pushvalue(L, funcIdx);                                              /* -> udata, uservalue, func */
+    lua_rawseti(L, -2, LPUGL_CHANNEL_UV_FUNC);                              /* -> udata, uservalue */
+    lua_setuservalue(L, -2);                                                /* -> udata */
+
+    lua_getuservalue(L, worldIdx);                                          /* -> udata, worldUservalue */
+    if (lua_rawgeti(L, -1, LPUGL_WORLD_UV_CHANNELS) != LUA_TTABLE) {        /* -> udata, worldUservalue, ? */
+        lua_pop(L, 1);                                                      /* -> udata, worldUservalue */
+        lua_newtable(L);                                                    /* -> udata, worldUservalue, channels */
+        lua_pushvalue(L, -1);                                               /* -> udata, worldUservalue, channels, channels */
+        lua_rawseti(L, -3, LPUGL_WORLD_UV_CHANNELS);                        /* -> udata, worldUservalue, channels */
+    }                                                                       /* -> udata, worldUservalue, channels */
+    lua_pushvalue(L, -3);                                                   /* -> udata, worldUservalue, channels, udata */
+    lua_rawsetp(L, -2, channel);                                            /* -> udata, worldUservalue, channels */
+    lua_pop(L, 2);                                                          /* -> udata */
+
+    channel->nextChannel   = world->channels;
+    world->channels        = channel;
+    world->channelsChanged += 1;
+
+    async_mutex_lock(lpugl_global_lock);
+        channel->nextGlobal = global_channel_list;
+        global_channel_list = channel;
+    async_mutex_unlock(lpugl_global_lock);
+
+    return 1;
+}
+
+/* ============================================================================================ */
+
+void lpugl_channel_close_all(lua_State* L, LpuglWorld* world, int worldUservalueIdx)
+{
+    while (world->channels) {
+        closeChannel(world->channels);
+    }
+    lua_pushnil(L);                                                         /* -> nil */
+    lua_rawseti(L, worldUservalueIdx, LPUGL_WORLD_UV_CHANNELS);             /* -> */
+}
+
+/* ============================================================================================ */
+
+/*
+ * Invokes the channel functions for all pending messages. Must be called on the
+ * world's thread with the world's uservalue at the given index.
+ */
+void lpugl_channel_deliver_all(lua_State* L, LpuglWorld* world, int worldUservalueIdx, int msgh)
+{
+again:
+    for (LpuglChannel* channel = world->channels; channel; channel = channel->nextChannel) {
+        LpuglChannelMsg* msgs = takeMessages(channel);
+        if (!msgs) {
+            continue;
+        }
+        int changed = world->channelsChanged;
+
+        lua_checkstack(L, LPUGL_CHANNEL_BATCH_SIZE + LUA_MINSTACK);
+        lua_rawgeti(L, worldUservalueIdx, LPUGL_WORLD_UV_CHANNELS);         /* -> channels */
+        lua_rawgetp(L, -1, channel);                                        /* -> channels, udata */
+        lua_getuservalue(L, -1);                                            /* -> channels, udata, uservalue */
+
+        while (msgs && !atomic_get(&channel->closed)) {
+            lua_rawgeti(L, -1, LPUGL_CHANNEL_UV_FUNC);                      /* -> channels, udata, uservalue, func */
+            int n = 0;
+            while (msgs && n < LPUGL_CHANNEL_BATCH_SIZE) {
+                LpuglChannelMsg* next = msgs->next;
+                lua_pushlstring(L, msgs->data, msgs->len);                  /* -> channels, udata, uservalue, func, msgs... */
+                free(msgs);
+                msgs = next;
+                n += 1;
+            }
+            if (lua_pcall(L, n, 0, msgh) != 0) {                            /* -> channels, udata, uservalue, ? */
+                lpugl_world_handle_error(L, worldUservalueIdx, msgh);       /* -> channels, udata, uservalue */
+            }
+        }
+        freeMessages(msgs);
+        lua_pop(L, 3);                                                      /* -> */
+
+        if (world->channelsChanged != changed) {
+            goto again; // channel list was modified by the channel function
+        }
+    }
+}
+
+/* ============================================================================================ */
+
+static int Lpugl_channel(lua_State* L)
+{
+    lua_Integer id = luaL_checkinteger(L, 1);
+
+    ChannelUserData* udata = lua_newuserdata(L, sizeof(ChannelUserData));  /* -> udata */
+    memset(udata, 0, sizeof(ChannelUserData));
+    pushChannelMeta(L);                                                     /* -> udata, meta */
+    lua_setmetatable(L, -2);                                                /* -> udata */
+    udata->restricted = true;
+
+    async_mutex_lock(lpugl_global_lock);
+        LpuglChannel* c = global_channel_list;
+        while (c && c->id != id) {
+            c = c->nextGlobal;
+        }
+        if (c) {
+            atomic_inc(&c->used);
+        }
+    async_mutex_unlock(lpugl_global_lock);
+
+    if (c) {
+        udata->channel = c;
+        return 1;
+    } else {
+        return lpugl_ERROR_UNKNOWN_OBJECT_channel_id(L, id);
+    }
+}
+
+/* ============================================================================================ */
+
+static int Channel_release(lua_State* L)
+{
+    ChannelUserData* udata = luaL_checkudata(L, 1, LPUGL_CHANNEL_CLASS_NAME);
+    if (udata->channel) {
+        if (!udata->restricted) {
+            closeChannel(udata->channel);
+        }
+        releaseChannel(udata->channel);
+        udata->channel = NULL;
+    }
+    return 0;
+}
+
+/* ============================================================================================ */
+
+static int Channel_close(lua_State* L)
+{
+    ChannelUserData* udata = luaL_checkudata(L, 1, LPUGL_CHANNEL_CLASS_NAME);
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (udata->channel && closeChannel(udata->channel)) {
+        LpuglWorld* world = udata->channel->world;
+        if (world->weakWorldRef != LUA_REFNIL) {
+            if (lua_rawgeti(L, LUA_REGISTRYINDEX, world->weakWorldRef)
+                                                    == LUA_TTABLE) {    /* -> weakWorld */
+                if (   lua_rawgeti(L, -1, 0) == LUA_TUSERDATA           /* -> weakWorld, world */
+                    && lua_getuservalue(L, -1) == LUA_TTABLE            /* -> weakWorld, world, worldUservalue */
+                    && lua_rawgeti(L, -1, LPUGL_WORLD_UV_CHANNELS) == LUA_TTABLE)
+                {                                                       /* -> weakWorld, world, worldUservalue, channels */
+                    lua_pushnil(L);                                     /* -> weakWorld, world, worldUservalue, channels, nil */
+                    lua_rawsetp(L, -2, udata->channel);                 /* -> weakWorld, world, worldUservalue, channels */
+                }
+            }
+            lua_settop(L, 1);                                           /* -> */
+        }
+    }
+    return 0;
+}
+
+/* ============================================================================================ */
+
+static int Channel_isClosed(lua_State* L)
+{
+    ChannelUserData* udata = luaL_checkudata(L, 1, LPUGL_CHANNEL_CLASS_NAME);
+    lua_pushboolean(L, !udata->channel || atomic_get(&udata->channel->closed));
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int Channel_id(lua_State* L)
+{
+    ChannelUserData* udata = luaL_checkudata(L, 1, LPUGL_CHANNEL_CLASS_NAME);
+    if (!udata->channel) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    lua_pushinteger(L, udata->channel->id);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int Channel_push(lua_State* L)
+{
+    ChannelUserData* udata = luaL_checkudata(L, 1, LPUGL_CHANNEL_CLASS_NAME);
+    size_t      len;
+    const char* data = luaL_checklstring(L, 2, &len);
+    if (!udata->channel) {
+        lua_pushboolean(L, false);
+        return 1;
+    }
+    int rc = pushMessage(udata->channel, data, len);
+    if (rc == 2) {
+        return lpugl_ERROR_OUT_OF_MEMORY_bytes(L, len);
+    }
+    lua_pushboolean(L, rc == 0);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int Channel_toString(lua_State* L)
+{
+    ChannelUserData* udata = luaL_checkudata(L, 1, LPUGL_CHANNEL_CLASS_NAME);
+    if (udata->channel) {
+        lua_pushfstring(L, "%s: %p (id=%d)", LPUGL_CHANNEL_CLASS_NAME, udata, (int)udata->channel->id);
+    } else {
+        lua_pushfstring(L, "%s: %p (closed)", LPUGL_CHANNEL_CLASS_NAME, udata);
+    }
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static lpugl_channel* channel_capi_toChannel(lua_State* L, int index)
+{
+    ChannelUserData* udata = luaL_testudata(L, index, LPUGL_CHANNEL_CLASS_NAME);
+    return udata ? (lpugl_channel*)udata->channel : NULL;
+}
+
+static void channel_capi_retainChannel(lpugl_channel* c)
+{
+    retainChannel((LpuglChannel*)c);
+}
+
+static void channel_capi_releaseChannel(lpugl_channel* c)
+{
+    if (c) {
+        releaseChannel((LpuglChannel*)c);
+    }
+}
+
+static int channel_capi_push(lpugl_channel* c, const char* data, size_t len)
+{
+    return pushMessage((LpuglChannel*)c, data, len);
+}
+
+static const lpugl_channel_capi channel_capi_impl =
+{
+    LPUGL_CHANNEL_CAPI_VERSION_MAJOR,
+    LPUGL_CHANNEL_CAPI_VERSION_MINOR,
+    LPUGL_CHANNEL_CAPI_VERSION_PATCH,
+    NULL, // next_capi
+
+    channel_capi_toChannel,
+
+    channel_capi_retainChannel,
+    channel_capi_releaseChannel,
+
+    channel_capi_push
+};
+
+/* ============================================================================================ */
+
+static const luaL_Reg ChannelMethods[] =
+{
+    { "id",        Channel_id       },
+    { "push",      Channel_push     },
+    { "close",     Channel_close    },
+    { "isClosed",  Channel_isClosed },
+    { NULL,        NULL } /* sentinel */
+};
+
+static const luaL_Reg ChannelMetaMethods[] =
+{
+    { "__tostring", Channel_toString },
+    { "__gc",       Channel_release  },
+    { NULL,         NULL } /* sentinel */
+};
+
+static const luaL_Reg ModuleFunctions[] =
+{
+    { "channel",    Lpugl_channel },
+    { NULL,         NULL } /* sentinel */
+};
+
+static void setupChannelMeta(lua_State* L)
+{                                                       /* -> meta */
+    lua_pushstring(L, LPUGL_CHANNEL_CLASS_NAME);        /* -> meta, className */
+    lua_setfield(L, -2, "__metatable");                 /* -> meta */
+
+    luaL_setfuncs(L, ChannelMetaMethods, 0);            /* -> meta */
+
+    lua_newtable(L);  /* ChannelClass */                /* -> meta, ChannelClass */
+    luaL_setfuncs(L, ChannelMethods, 0);                /* -> meta, ChannelClass */
+    lua_setfield (L, -2, "__index");                    /* -> meta */
+
+    lpugl_channel_set_capi(L, -1, &channel_capi_impl);  /* -> meta */
+}
+
+int lpugl_channel_init_module(lua_State* L, int module)
+{
+    if (luaL_newmetatable(L, LPUGL_CHANNEL_CLASS_NAME)) {
+        setupChannelMeta(L);
+    }
+    lua_pop(L, 1);
+
+    lua_pushvalue(L, module);
+        luaL_setfuncs(L, ModuleFunctions, 0);
+    lua_pop(L, 1);
+
+    return 0;
+}
+
+/* ============================================================================================ */
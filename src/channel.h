@@ -0,0 +1,52 @@
+#ifndef LPUGL_CHANNEL_H
+#define LPUGL_CHANNEL_H
+
+#include "base.h"
+#include "async_util.h"
+
+struct LpuglWorld;
+
+/* ============================================================================================ */
+
+//  channel uservalue indices
+#define LPUGL_CHANNEL_UV_FUNC  1
+
+//  maximal number of messages per invocation of the channel function
+#define LPUGL_CHANNEL_BATCH_SIZE  64
+
+/* ============================================================================================ */
+
+typedef struct LpuglChannelMsg {
+    struct LpuglChannelMsg* next;
+    size_t                  len;
+    char                    data[1];
+} LpuglChannelMsg;
+
+/*
+ * Multiple producer single consumer channel. Producers push messages onto a
+ * lock-free stack, the event loop of the owning world takes all messages at
+ * once and delivers them in the order they were pushed.
+ */
+typedef struct LpuglChannel {
+    lua_Integer           id;
+    AtomicCounter         used;
+    AtomicCounter         closed;
+    AtomicPtr             head;         // pushed messages, most recent first
+    struct LpuglWorld*    world;        // retained until channel is destructed
+    struct LpuglChannel*  nextChannel;  // in list of world's open channels
+    struct LpuglChannel*  nextGlobal;   // in global list of open channels
+} LpuglChannel;
+
+/* ============================================================================================ */
+
+int lpugl_channel_init_module(lua_State* L, int module);
+
+int lpugl_channel_new(lua_State* L, struct LpuglWorld* world, int worldIdx, int funcIdx);
+
+void lpugl_channel_close_all(lua_State* L, struct LpuglWorld* world, int worldUservalueIdx);
+
+void lpugl_channel_deliver_all(lua_State* L, struct LpuglWorld* world, int worldUservalueIdx, int msgh);
+
+/* ============================================================================================ */
+
+#endif /* LPUGL_CHANNEL_H */
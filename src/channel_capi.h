@@ -0,0 +1,151 @@
+#ifndef LPUGL_CHANNEL_CAPI_H
+#define LPUGL_CHANNEL_CAPI_H
+
+#define LPUGL_CHANNEL_CAPI_ID_STRING     "_capi_lpugl_channel"
+#define LPUGL_CHANNEL_CAPI_VERSION_MAJOR  0
+#define LPUGL_CHANNEL_CAPI_VERSION_MINOR  1
+#define LPUGL_CHANNEL_CAPI_VERSION_PATCH  0
+
+#ifndef LPUGL_CHANNEL_CAPI_IMPLEMENT_SET_CAPI
+#  define LPUGL_CHANNEL_CAPI_IMPLEMENT_SET_CAPI 0
+#endif
+
+#ifndef LPUGL_CHANNEL_CAPI_IMPLEMENT_GET_CAPI
+#  define LPUGL_CHANNEL_CAPI_IMPLEMENT_GET_CAPI 0
+#endif
+
+#ifdef __cplusplus
+
+extern "C" {
+
+struct lpugl_channel;
+struct lpugl_channel_capi;
+
+#else /* __cplusplus */
+
+typedef struct lpugl_channel      lpugl_channel;
+typedef struct lpugl_channel_capi lpugl_channel_capi;
+
+#endif /* ! __cplusplus */
+
+/**
+ *  LPugl Channel C API.
+ *
+ *  Allows producers in any thread to send byte messages into the event loop
+ *  of an lpugl world without Lua. Messages are queued without locking.
+ */
+struct lpugl_channel_capi
+{
+    int version_major;
+    int version_minor;
+    int version_patch;
+
+    /**
+     * May point to another (incompatible) version of this API implementation.
+     * NULL if no such implementation exists.
+     */
+    void* next_capi;
+
+    /**
+     * Returns a valid pointer if the Lua object at the given stack
+     * index is a channel object, otherwise returns NULL.
+     *
+     * The returned channel is valid as long as the Lua object at the given
+     * stack index remains valid. To keep the channel beyond this call, the
+     * function retainChannel() must be called (see below).
+     */
+    lpugl_channel* (*toChannel)(lua_State* L, int index);
+
+    /**
+     * Increases the reference counter of the channel. Thread safe.
+     */
+    void (*retainChannel)(lpugl_channel* c);
+
+    /**
+     * Decreases the reference counter of the channel and destructs the
+     * channel if no reference is left. Thread safe.
+     */
+    void (*releaseChannel)(lpugl_channel* c);
+
+    /**
+     * Appends a copy of the given bytes as message to the channel. Can be
+     * called from any thread, the message is queued without locking. The
+     * world's event loop is awakened once for all messages that are pushed
+     * before the messages are delivered. Awakening takes the world's lock
+     * and writes to the event loop's wake-up pipe.
+     *
+     * Returns 0 - on success
+     *         1 - if the channel is closed. The caller is expected to release the channel.
+     *             Subsequent calls will always result this return code again.
+     *         2 - if memory for the message could not be allocated.
+     */
+    int (*push)(lpugl_channel* c, const char* data, size_t len);
+};
+
+#if LPUGL_CHANNEL_CAPI_IMPLEMENT_SET_CAPI
+/**
+ * Sets the LPugl Channel C API into the metatable at the given index.
+ */
+static int lpugl_channel_set_capi(lua_State* L, int index, const lpugl_channel_capi* capi)
+{
+    lua_pushlstring(L, LPUGL_CHANNEL_CAPI_ID_STRING, strlen(LPUGL_CHANNEL_CAPI_ID_STRING));   /* -> key */
+    void** udata = (void**) lua_newuserdata(L, sizeof(void*) + strlen(LPUGL_CHANNEL_CAPI_ID_STRING) + 1); /* -> key, value */
+    *udata = (void*)capi;
+    strcpy((char*)(udata + 1), LPUGL_CHANNEL_CAPI_ID_STRING); /* -> key, value */
+    lua_rawset(L, (index < 0) ? (index - 2) : index);         /* -> */
+    return 0;
+}
+#endif /* LPUGL_CHANNEL_CAPI_IMPLEMENT_SET_CAPI */
+
+#if LPUGL_CHANNEL_CAPI_IMPLEMENT_GET_CAPI
+/**
+ * Gives the associated LPugl Channel C API for the object at the given stack index.
+ * Returns NULL, if the object at the given stack index does not have an
+ * associated C API or only has a C API with incompatible version number.
+ * If errorReason is not NULL it receives the error reason in this case:
+ * 1 for incompatible version nummber and 2 for no associated C API at all.
+ */
+static const lpugl_channel_capi* lpugl_channel_get_capi(lua_State* L, int index, int* errorReason)
+{
+    if (luaL_getmetafield(L, index, LPUGL_CHANNEL_CAPI_ID_STRING) != LUA_TNIL)   /* -> _capi */
+    {
+        const void** udata = (const void**) lua_touserdata(L, -1);              /* -> _capi */
+
+        if (   udata
+            && (lua_rawlen(L, -1) >= sizeof(void*) + strlen(LPUGL_CHANNEL_CAPI_ID_STRING) + 1)
+            && (memcmp((char*)(udata + 1), LPUGL_CHANNEL_CAPI_ID_STRING,
+                       strlen(LPUGL_CHANNEL_CAPI_ID_STRING) + 1) == 0))
+        {
+            const lpugl_channel_capi* capi = (const lpugl_channel_capi*) *udata; /* -> _capi */
+            while (capi) {
+                if (   capi->version_major == LPUGL_CHANNEL_CAPI_VERSION_MAJOR
+                    && capi->version_minor >= LPUGL_CHANNEL_CAPI_VERSION_MINOR)
+                {                                                                /* -> _capi */
+                    lua_pop(L, 1);                                               /* -> */
+                    return capi;
+                }
+                capi = (const lpugl_channel_capi*) capi->next_capi;
+            }
+            if (errorReason) {
+                *errorReason = 1;
+            }
+        } else {                                                                 /* -> _capi */
+            if (errorReason) {
+                *errorReason = 2;
+            }
+        }
+        lua_pop(L, 1);                                                           /* -> */
+    } else {                                                                     /* -> */
+        if (errorReason) {
+            *errorReason = 2;
+        }
+    }
+    return NULL;
+}
+#endif /* LPUGL_CHANNEL_CAPI_IMPLEMENT_GET_CAPI */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LPUGL_CHANNEL_CAPI_H */
@@ -38,6 +38,18 @@ int lpugl_ERROR_UNKNOWN_OBJECT_world_id(lua_State* L, lua_Integer id)
     return throwErrorMessage(L, LPUGL_ERROR_UNKNOWN_OBJECT);
 }
 
+int lpugl_ERROR_UNKNOWN_OBJECT_channel_id(lua_State* L, lua_Integer id)
+{
+    lua_pushfstring(L, "channel id %d", (int)id);
+    return throwErrorMessage(L, LPUGL_ERROR_UNKNOWN_OBJECT);
+}
+
+int lpugl_ERROR_UNKNOWN_OBJECT_triplebuffer_id(lua_State* L, lua_Integer id)
+{
+    lua_pushfstring(L, "triple buffer id %d", (int)id);
+    return throwErrorMessage(L, LPUGL_ERROR_UNKNOWN_OBJECT);
+}
+
 
 int lpugl_ERROR_OUT_OF_MEMORY(lua_State* L)
 {
@@ -16,6 +16,8 @@
 #define lpugl_error(L, errorLiteral) luaL_error((L), "lpugl.error." errorLiteral)
 
 int lpugl_ERROR_UNKNOWN_OBJECT_world_id(lua_State* L, lua_Integer id);
+int lpugl_ERROR_UNKNOWN_OBJECT_channel_id(lua_State* L, lua_Integer id);
+int lpugl_ERROR_UNKNOWN_OBJECT_triplebuffer_id(lua_State* L, lua_Integer id);
 
 int lpugl_ERROR_OUT_OF_MEMORY(lua_State* L);
 int lpugl_ERROR_OUT_OF_MEMORY_bytes(lua_State* L, size_t bytes);
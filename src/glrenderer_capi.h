@@ -0,0 +1,174 @@
+#ifndef LPUGL_GLRENDERER_CAPI_H
+#define LPUGL_GLRENDERER_CAPI_H
+
+#define LPUGL_GLRENDERER_CAPI_ID_STRING     "_capi_lpugl_glrenderer"
+#define LPUGL_GLRENDERER_CAPI_VERSION_MAJOR  0
+#define LPUGL_GLRENDERER_CAPI_VERSION_MINOR  1
+#define LPUGL_GLRENDERER_CAPI_VERSION_PATCH  0
+
+#ifndef LPUGL_GLRENDERER_CAPI_IMPLEMENT_SET_CAPI
+#  define LPUGL_GLRENDERER_CAPI_IMPLEMENT_SET_CAPI 0
+#endif
+
+#ifndef LPUGL_GLRENDERER_CAPI_IMPLEMENT_GET_CAPI
+#  define LPUGL_GLRENDERER_CAPI_IMPLEMENT_GET_CAPI 0
+#endif
+
+#ifdef __cplusplus
+
+extern "C" {
+
+struct lpugl_glrenderer;
+struct lpugl_glrenderer_capi;
+struct lpugl_glframe;
+
+#else /* __cplusplus */
+
+typedef struct lpugl_glrenderer      lpugl_glrenderer;
+typedef struct lpugl_glrenderer_capi lpugl_glrenderer_capi;
+typedef struct lpugl_glframe         lpugl_glframe;
+
+#endif /* ! __cplusplus */
+
+/**
+ * Frame that is to be rendered on the render thread of an lpugl_opengl backend.
+ */
+struct lpugl_glframe
+{
+    /**
+     * Identifies the view. The same renderer may be set for several views.
+     */
+    const void* view;
+
+    /**
+     * Size of the view at the time the frame was requested.
+     */
+    int width;
+    int height;
+
+    /**
+     * Number of frames that were rendered for the view with this renderer before.
+     */
+    unsigned long counter;
+};
+
+/**
+ *  LPugl OpenGL Renderer C API.
+ *
+ *  Implemented by objects that can be set as renderer for views of an
+ *  lpugl_opengl backend with render thread. All rendering functions are
+ *  invoked on the render thread with the view's OpenGL context being current.
+ */
+struct lpugl_glrenderer_capi
+{
+    int version_major;
+    int version_minor;
+    int version_patch;
+
+    /**
+     * May point to another (incompatible) version of this API implementation.
+     * NULL if no such implementation exists.
+     */
+    void* next_capi;
+
+    /**
+     * Must return a valid pointer if the Lua object at the given stack
+     * index is a valid renderer, otherwise must return NULL.
+     *
+     * To keep the renderer beyond this call, the function retainRenderer()
+     * is called (see below).
+     */
+    lpugl_glrenderer* (*toRenderer)(lua_State* L, int index);
+
+    /**
+     * Increases the reference counter of the renderer. Must be thread safe.
+     */
+    void (*retainRenderer)(lpugl_glrenderer* r);
+
+    /**
+     * Decreases the reference counter of the renderer and destructs the
+     * renderer if no reference is left. Must be thread safe.
+     */
+    void (*releaseRenderer)(lpugl_glrenderer* r);
+
+    /**
+     * Renders a frame of the whole view. Called on the render thread, the
+     * buffers are swapped afterwards.
+     */
+    void (*renderFrame)(lpugl_glrenderer* r, const lpugl_glframe* frame);
+
+    /**
+     * Called on the render thread before the renderer is removed from the
+     * view or before the view's context is destroyed. The renderer should
+     * delete the OpenGL objects it has created for this view.
+     */
+    void (*releaseContext)(lpugl_glrenderer* r, const void* view);
+};
+
+#if LPUGL_GLRENDERER_CAPI_IMPLEMENT_SET_CAPI
+/**
+ * Sets the LPugl OpenGL Renderer C API into the metatable at the given index.
+ */
+static int lpugl_glrenderer_set_capi(lua_State* L, int index, const lpugl_glrenderer_capi* capi)
+{
+    lua_pushlstring(L, LPUGL_GLRENDERER_CAPI_ID_STRING, strlen(LPUGL_GLRENDERER_CAPI_ID_STRING));   /* -> key */
+    void** udata = (void**) lua_newuserdata(L, sizeof(void*) + strlen(LPUGL_GLRENDERER_CAPI_ID_STRING) + 1); /* -> key, value */
+    *udata = (void*)capi;
+    strcpy((char*)(udata + 1), LPUGL_GLRENDERER_CAPI_ID_STRING); /* -> key, value */
+    lua_rawset(L, (index < 0) ? (index - 2) : index);          /* -> */
+    return 0;
+}
+#endif /* LPUGL_GLRENDERER_CAPI_IMPLEMENT_SET_CAPI */
+
+#if LPUGL_GLRENDERER_CAPI_IMPLEMENT_GET_CAPI
+/**
+ * Gives the associated LPugl OpenGL Renderer C API for the object at the given stack index.
+ * Returns NULL, if the object at the given stack index does not have an
+ * associated C API or only has a C API with incompatible version number.
+ * If errorReason is not NULL it receives the error reason in this case:
+ * 1 for incompatible version nummber and 2 for no associated C API at all.
+ */
+static const lpugl_glrenderer_capi* lpugl_glrenderer_get_capi(lua_State* L, int index, int* errorReason)
+{
+    if (luaL_getmetafield(L, index, LPUGL_GLRENDERER_CAPI_ID_STRING) != LUA_TNIL)   /* -> _capi */
+    {
+        const void** udata = (const void**) lua_touserdata(L, -1);               /* -> _capi */
+
+        if (   udata
+            && (lua_rawlen(L, -1) >= sizeof(void*) + strlen(LPUGL_GLRENDERER_CAPI_ID_STRING) + 1)
+            && (memcmp((char*)(udata + 1), LPUGL_GLRENDERER_CAPI_ID_STRING,
+                       strlen(LPUGL_GLRENDERER_CAPI_ID_STRING) + 1) == 0))
+        {
+            const lpugl_glrenderer_capi* capi = (const lpugl_glrenderer_capi*) *udata; /* -> _capi */
+            while (capi) {
+                if (   capi->version_major == LPUGL_GLRENDERER_CAPI_VERSION_MAJOR
+                    && capi->version_minor >= LPUGL_GLRENDERER_CAPI_VERSION_MINOR)
+                {                                                                 /* -> _capi */
+                    lua_pop(L, 1);                                                /* -> */
+                    return capi;
+                }
+                capi = (const lpugl_glrenderer_capi*) capi->next_capi;
+            }
+            if (errorReason) {
+                *errorReason = 1;
+            }
+        } else {                                                                  /* -> _capi */
+            if (errorReason) {
+                *errorReason = 2;
+            }
+        }
+        lua_pop(L, 1);                                                            /* -> */
+    } else {                                                                      /* -> */
+        if (errorReason) {
+            *errorReason = 2;
+        }
+    }
+    return NULL;
+}
+#endif /* LPUGL_GLRENDERER_CAPI_IMPLEMENT_GET_CAPI */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LPUGL_GLRENDERER_CAPI_H */
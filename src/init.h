@@ -1,7 +1,8 @@
 #ifndef LPUGL_INIT_H
 #define LPUGL_INIT_H
 
-#if !defined(LPUGL_USE_WIN) && !defined(LPUGL_USE_X11) && !defined(LPUGL_USE_MAC)
+#if !defined(LPUGL_USE_WIN) && !defined(LPUGL_USE_X11) && !defined(LPUGL_USE_MAC) \
+ && !defined(LPUGL_USE_HEADLESS)
     #if defined(WIN32) || defined(_WIN32)
         #define LPUGL_USE_WIN
     #elif defined(__APPLE__) && defined(__MACH__)
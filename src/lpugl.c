@@ -1,6 +1,10 @@
 #include "lpugl.h"
 #include "world.h"
 #include "view.h"
+#include "snapshot.h"
+#include "channel.h"
+#include "triplebuf.h"
+#include "task.h"
 #include "error.h"
 #include "version.h"
 
@@ -11,8 +15,9 @@ static AtomicCounter initStage          = 0;
 static bool          initialized        = false;
 static int           stateCounter       = 0;
 
-Mutex*        lpugl_global_lock = NULL;
-AtomicCounter lpugl_id_counter  = 0;
+Mutex*        lpugl_global_lock         = NULL;
+AtomicCounter lpugl_id_counter          = 0;
+bool          lpugl_application_threads = false;
 
 /*static int internalError(lua_State* L, const char* text, int line) 
 {
@@ -31,6 +36,9 @@ static int Lpugl_initApplication(lua_State* L)
         }
     }
     puglInitApplication(flags);
+    if (flags & PUGL_APPLICATION_THREADS) {
+        lpugl_application_threads = true;
+    }
     return 0;
 }
 
@@ -208,6 +216,45 @@ LPUGL_DLL_PUBLIC int luaopen_lpugl(lua_State* L)
     lua_pushinteger(L, PUGL_MOD_SUPER);             /* -> integer */
     lua_setfield(L, module, "MOD_SUPER");           /* -> */
 
+    lua_pushinteger(L, PUGL_BUTTON_PRESS);      /* -> integer */
+    lua_setfield(L, module, "EVENT_BUTTON_PRESS");/* -> */
+
+    lua_pushinteger(L, PUGL_BUTTON_RELEASE);    /* -> integer */
+    lua_setfield(L, module, "EVENT_BUTTON_RELEASE");/* -> */
+
+    lua_pushinteger(L, PUGL_KEY_PRESS);         /* -> integer */
+    lua_setfield(L, module, "EVENT_KEY_PRESS"); /* -> */
+
+    lua_pushinteger(L, PUGL_KEY_RELEASE);       /* -> integer */
+    lua_setfield(L, module, "EVENT_KEY_RELEASE");/* -> */
+
+    lua_pushinteger(L, PUGL_POINTER_IN);        /* -> integer */
+    lua_setfield(L, module, "EVENT_POINTER_IN");/* -> */
+
+    lua_pushinteger(L, PUGL_POINTER_OUT);       /* -> integer */
+    lua_setfield(L, module, "EVENT_POINTER_OUT");/* -> */
+
+    lua_pushinteger(L, PUGL_MOTION);            /* -> integer */
+    lua_setfield(L, module, "EVENT_MOTION");    /* -> */
+
+    lua_pushinteger(L, PUGL_SCROLL);            /* -> integer */
+    lua_setfield(L, module, "EVENT_SCROLL");    /* -> */
+
+    lua_pushinteger(L, PUGL_FOCUS_IN);          /* -> integer */
+    lua_setfield(L, module, "EVENT_FOCUS_IN");  /* -> */
+
+    lua_pushinteger(L, PUGL_FOCUS_OUT);         /* -> integer */
+    lua_setfield(L, module, "EVENT_FOCUS_OUT"); /* -> */
+
+    lua_pushinteger(L, PUGL_EXPOSE);            /* -> integer */
+    lua_setfield(L, module, "EVENT_EXPOSE");    /* -> */
+
+    lua_pushinteger(L, PUGL_CONFIGURE);         /* -> integer */
+    lua_setfield(L, module, "EVENT_CONFIGURE"); /* -> */
+
+    lua_pushinteger(L, PUGL_CLOSE);             /* -> integer */
+    lua_setfield(L, module, "EVENT_CLOSE");     /* -> */
+
     lua_pushvalue(L, errorModule);
     lua_setfield(L, module, "error");
     
@@ -218,6 +265,10 @@ LPUGL_DLL_PUBLIC int luaopen_lpugl(lua_State* L)
     
     lpugl_world_init_module  (L, module);
     lpugl_view_init_module   (L, module);
+    lpugl_snapshot_init_module(L, module);
+    lpugl_channel_init_module (L, module);
+    lpugl_triplebuf_init_module(L, module);
+    lpugl_task_init_module    (L, module);
     lpugl_error_init_module  (L, errorModule);
 
     lua_newtable(L);                                /* -> meta */
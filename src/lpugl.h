@@ -6,6 +6,7 @@
 
 extern Mutex*        lpugl_global_lock;
 extern AtomicCounter lpugl_id_counter;
+extern bool          lpugl_application_threads;
 
 LPUGL_DLL_PUBLIC int luaopen_lpugl(lua_State* L);
 
@@ -1,3 +1,4 @@
+#include <math.h>
 #include <cairo.h>
 
 #include "init.h"
@@ -24,11 +25,21 @@
 #include "version.h"
 #include "backend.h"
 #include "error.h"
+#include "async_util.h"
+
+#define LPUGL_CAIROPAINTER_CAPI_IMPLEMENT_GET_CAPI 1
+#include "cairopainter_capi.h"
+
+#define LPUGL_CHANNEL_CAPI_IMPLEMENT_GET_CAPI 1
+#include "channel_capi.h"
 
 /* ============================================================================================ */
 
-#define LPUGL_CAIRO_BACKEND_UV_WORLD      0
-#define LPUGL_CAIRO_BACKEND_UV_LAYOUT_CTX 1
+#define LPUGL_CAIRO_BACKEND_UV_WORLD        0
+#define LPUGL_CAIRO_BACKEND_UV_LAYOUT_CTX   1
+#define LPUGL_CAIRO_BACKEND_UV_CONTEXT_META 2
+#define LPUGL_CAIRO_BACKEND_UV_IMAGE_CHANNEL 3
+#define LPUGL_CAIRO_BACKEND_UV_PENDING_IMAGES 4
 
 /* ============================================================================================ */
 
@@ -36,12 +47,17 @@ static const char* const OOCAIRO_MT_NAME_CONTEXT = "6404c570-6711-11dd-b66f-00e0
 
 static const char* const LPUGL_CAIRO_BACKEND_CLASS_NAME = "lpugl_cairo.backend";
 
+static const char* const LPUGL_CAIRO_IMAGE_CLASS_NAME = "lpugl_cairo.image";
+
 /* ============================================================================================ */
 
 typedef struct LpuglCairoBackend {
 
     LpuglBackend     base;
     cairo_surface_t* layoutSurface;
+    struct TilePool* tilePool;
+    struct ImageLoader* imageLoader;
+    size_t           imageCacheSize;
     
 #if defined(LPUGL_USE_X11)
     Pixmap           x11LayoutPixmap;
@@ -65,6 +81,38 @@ static int pushBackendMeta(lua_State* L)
 }
 
 
+/* ============================================================================================ */
+
+/*
+ * Pushes the oocairo context meta table, which is cached in the backend's uservalue.
+ */
+static void pushContextMeta(lua_State* L, int backendIdx)
+{
+    lua_getuservalue(L, backendIdx);                                   /* -> uservalue */
+    if (lua_rawgeti(L, -1, LPUGL_CAIRO_BACKEND_UV_CONTEXT_META) != LUA_TTABLE) 
+    {                                                                  /* -> uservalue, ? */
+        lua_pop(L, 1);                                                 /* -> uservalue */
+        if (luaL_getmetatable(L, OOCAIRO_MT_NAME_CONTEXT) != LUA_TTABLE) { /* -> uservalue, meta */
+            lua_pop(L, 1);                                             /* -> uservalue */
+            bool loaded = false;
+            if (lua_getglobal(L, "require") == LUA_TFUNCTION) {        /* -> uservalue, require */
+                lua_pushstring(L, "oocairo");                          /* -> uservalue, require, "oocairo" */
+                lua_call(L, 1, 0);                                     /* -> uservalue */
+        
+                if (luaL_getmetatable(L, OOCAIRO_MT_NAME_CONTEXT) == LUA_TTABLE) { /* -> uservalue, meta */
+                    loaded = true;
+                }
+            }
+            if (!loaded) {
+                lpugl_error(L, LPUGL_ERROR_FAILED_OPERATION ": error loading module \"oocairo\"");
+            }
+        }                                                              /* -> uservalue, meta */
+        lua_pushvalue(L, -1);                                          /* -> uservalue, meta, meta */
+        lua_rawseti(L, -3, LPUGL_CAIRO_BACKEND_UV_CONTEXT_META);       /* -> uservalue, meta */
+    }
+    lua_remove(L, -2);                                                 /* -> meta */
+}
+
 /* ============================================================================================ */
 
 static int Backend_getLayoutContext(lua_State* L)
@@ -85,21 +133,7 @@ static int Backend_getLayoutContext(lua_State* L)
     cairo_t** rslt = lua_newuserdata(L, sizeof(cairo_t*));             /* -> uservalue, context */
     *rslt = NULL;
 
-    if (luaL_getmetatable(L, OOCAIRO_MT_NAME_CONTEXT) != LUA_TTABLE) { /* -> uservalue, context, meta */
-        lua_pop(L, 1);                                                 /* -> uservalue, context */
-        bool loaded = false;
-        if (lua_getglobal(L, "require") == LUA_TFUNCTION) {            /* -> uservalue, context, require */
-            lua_pushstring(L, "oocairo");                              /* -> uservalue, context, require, "oocairo" */
-            lua_call(L, 1, 0);                                         /* -> uservalue, context */
-    
-            if (luaL_getmetatable(L, OOCAIRO_MT_NAME_CONTEXT) == LUA_TTABLE) { /* -> uservalue, context, meta */
-                loaded = true;
-            }
-        }
-        if (!loaded) { /* -> context, meta */
-            return lpugl_error(L, LPUGL_ERROR_FAILED_OPERATION ": error loading module \"oocairo\"");
-        }
-    }                                                                  /* -> uservalue, context, meta */
+    pushContextMeta(L, 1);                                             /* -> uservalue, context, meta */
     lua_setmetatable(L, -2);                                           /* -> uservalue, context */
     lua_pushvalue(L, -1);                                              /* -> uservalue, context, context */
     lua_rawseti(L, -3, LPUGL_CAIRO_BACKEND_UV_LAYOUT_CTX);             /* -> uservalue, context */
@@ -127,6 +161,9 @@ static int Backend_getLayoutContext(lua_State* L)
         udata->layoutSurface = cairo_surface_create_similar(tmp, CAIRO_CONTENT_COLOR_ALPHA, 10, 10);
         cairo_surface_destroy(tmp);
     }
+
+#elif defined(LPUGL_USE_HEADLESS)
+    udata->layoutSurface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 10, 10);
 #endif
 
     *rslt = cairo_create(udata->layoutSurface);
@@ -135,37 +172,30 @@ static int Backend_getLayoutContext(lua_State* L)
 
 /* ============================================================================================ */
 
-static int newDrawContext(lua_State* L, void* nativeContext)           /* -> viewUserValue */
+static int newDrawContext(lua_State* L)
 {
-    cairo_t** rslt = lua_newuserdata(L, sizeof(cairo_t*));             /* -> viewUV, context */
+    cairo_t** rslt = lua_newuserdata(L, sizeof(cairo_t*));             /* -> context */
     *rslt = NULL;
-    
-    if (luaL_getmetatable(L, OOCAIRO_MT_NAME_CONTEXT) != LUA_TTABLE) { /* -> viewUV, context, meta */
-        lua_pop(L, 1);                                                 /* -> viewUV, context */
-        bool loaded = false;
-        if (lua_getglobal(L, "require") == LUA_TFUNCTION) {            /* -> viewUV, context, require */
-            lua_pushstring(L, "oocairo");                              /* -> viewUV, context, require, "oocairo" */
-            lua_call(L, 1, 0);                                         /* -> viewUV, context */
-    
-            if (luaL_getmetatable(L, OOCAIRO_MT_NAME_CONTEXT) == LUA_TTABLE) { /* -> viewUV, context, meta */
-                loaded = true;
-            }
-        }
-        if (!loaded) { /* -> viewUV, context, meta */
-            return lpugl_error(L, LPUGL_ERROR_FAILED_OPERATION ": error loading module \"oocairo\"");
-        }
-    }
-    lua_setmetatable(L, -2);                    /* -> viewUV, context */
-    lua_pushvalue(L, -1);                       /* -> viewUV, context, context */
-    lua_rawseti(L, -3, LPUGL_VIEW_UV_DRAWCTX);  /* -> viewUV, context */
-    
-    *rslt = cairo_reference(nativeContext);
-    
     return 1;
 }
 
 /* ============================================================================================ */
 
+/*
+ * The draw context userdata of a view is reused for every exposure: it only gets
+ * the native context and the meta table while drawing.
+ */
+static int bindDrawContext(lua_State* L, int contextIdx, int backendIdx, void* nativeContext)
+{
+    cairo_t** context = lua_touserdata(L, contextIdx);
+    pushContextMeta(L, backendIdx);                                    /* -> meta */
+    lua_setmetatable(L, contextIdx);                                   /* -> */
+    *context = cairo_reference(nativeContext);
+    return 0;
+}
+
+/* ============================================================================================ */
+
 static int finishDrawContext(lua_State* L, int contextIdx)
 {
     cairo_t** context = lua_touserdata(L, contextIdx);   /* -> context */
@@ -178,6 +208,1239 @@ static int finishDrawContext(lua_State* L, int contextIdx)
 
 /* ============================================================================================ */
 
+typedef struct CairoSnapshot {
+
+    LpuglSnapshot    base;
+    cairo_surface_t* image;
+
+} CairoSnapshot;
+
+static bool snapshotIsReady(LpuglSnapshot* LPUGL_UNUSED(snapshot), PuglView* LPUGL_UNUSED(view), 
+                            bool LPUGL_UNUSED(drawing))
+{
+    return true;
+}
+
+static bool snapshotMap(LpuglSnapshot* snapshot, PuglView* LPUGL_UNUSED(view), 
+                        bool LPUGL_UNUSED(drawing))
+{
+    return snapshot->data != NULL;
+}
+
+static void snapshotRelease(LpuglSnapshot* snapshot, PuglView* LPUGL_UNUSED(view), 
+                            bool LPUGL_UNUSED(drawing))
+{
+    cairo_surface_destroy(((CairoSnapshot*)snapshot)->image);
+    free(snapshot);
+}
+
+/* ============================================================================================ */
+
+static LpuglSnapshot* newSnapshot(LpuglBackend* LPUGL_UNUSED(backend), PuglView* view, 
+                                  bool LPUGL_UNUSED(drawing), PuglRect rect, 
+                                  double LPUGL_UNUSED(viewHeight))
+{
+    cairo_surface_t* image = puglCairoBackendSnapshot(view, rect);
+    if (!image) {
+        return NULL;
+    }
+    CairoSnapshot* snapshot = calloc(1, sizeof(CairoSnapshot));
+    if (!snapshot) {
+        cairo_surface_destroy(image);
+        return NULL;
+    }
+    snapshot->image        = image;
+    snapshot->base.width   = cairo_image_surface_get_width(image);
+    snapshot->base.height  = cairo_image_surface_get_height(image);
+    snapshot->base.stride  = cairo_image_surface_get_stride(image);
+    snapshot->base.format  = "RGB24";
+    snapshot->base.data    = cairo_image_surface_get_data(image);
+    snapshot->base.isReady = snapshotIsReady;
+    snapshot->base.map     = snapshotMap;
+    snapshot->base.release = snapshotRelease;
+    return &snapshot->base;
+}
+
+/* ============================================================================================ */
+
+/*
+ * Painter of a view: either a C painter object or a Lua chunk that returns the
+ * painting function. The Lua chunk is loaded into one Lua state per painting
+ * thread, the states are created lazily by the thread that uses them.
+ */
+typedef struct PaintSlot {
+    PuglView*                       view;
+    struct TilePool*                pool;
+    lpugl_cairopainter*             painter;     // NULL for Lua painter
+    const lpugl_cairopainter_capi*  capi;
+    char*                           source;      // Lua painter
+    size_t                          sourceLength;
+    char*                           packagePath;
+    char*                           packageCPath;
+    lua_State**                     states;      // index 0 for the world's thread
+    bool*                           failed;
+    AtomicPtr                       error;       // first error message of the current frame
+    LpuglWorld*                     world;
+    struct PaintSlot*               next;        // only accessed on the world's thread
+} PaintSlot;
+
+typedef struct Tile {
+    int              x;
+    int              y;
+    int              width;
+    int              height;
+    cairo_surface_t* image;  // reused for every frame
+} Tile;
+
+/*
+ * Tiles of the damaged region are painted by the world's thread and the tile
+ * threads. Tiles are claimed by incrementing the lower 16 bits of the claim
+ * counter, the upper bits contain the serial of the current job or 0 while
+ * the world's thread is preparing the next job.
+ */
+typedef struct TilePool {
+    int            tileSize;
+    int            threadCount;
+    Thread*        threads;
+    Mutex          jobMutex;     // tile threads wait for the next job
+    Mutex          doneMutex;    // world's thread waits for finished tiles
+    AtomicCounter  claim;
+    AtomicCounter  tileCount;
+    AtomicCounter  done;
+    AtomicCounter  stopping;
+    int            serial;       // only accessed on the world's thread
+    PaintSlot*     jobSlot;
+    int            jobViewWidth;
+    int            jobViewHeight;
+    Tile*          tiles;
+    int            tileCapacity;
+    PaintSlot*     slots;
+} TilePool;
+
+typedef struct TileThreadArg {
+    TilePool* pool;
+    int       index;
+} TileThreadArg;
+
+#define LPUGL_CAIRO_TILE_INDEX_MASK 0xffff
+#define LPUGL_CAIRO_MAX_TILE_COUNT  0xffff
+
+/* ============================================================================================ */
+
+/*
+ * Can be called from any painting thread, the first error of a frame is passed
+ * to the world's log function after all tiles have been painted.
+ */
+static void setPaintError(PaintSlot* slot, const char* prefix, const char* msg)
+{
+    if (atomic_get_ptr(&slot->error)) {
+        return;
+    }
+    size_t prefixLength = strlen(prefix);
+    size_t msgLength    = msg ? strlen(msg) : 0;
+    char*  error        = malloc(prefixLength + msgLength + 1);
+    if (!error) {
+        return;
+    }
+    memcpy(error, prefix, prefixLength);
+    memcpy(error + prefixLength, msg, msgLength);
+    error[prefixLength + msgLength] = '\0';
+    if (!atomic_set_ptr_if_equal(&slot->error, NULL, error)) {
+        free(error);
+    }
+}
+
+/* must be called on the world's thread */
+static void reportPaintError(PaintSlot* slot)
+{
+    char* error = atomic_get_ptr(&slot->error);
+    if (error) {
+        atomic_set_ptr_if_equal(&slot->error, error, NULL);
+        slot->world->logBackendError(slot->world, error);
+        free(error);
+    }
+}
+
+static lua_State* newPaintState(PaintSlot* slot, int thread)
+{
+    lua_State* L = luaL_newstate();
+    if (!L) {
+        return NULL;
+    }
+    luaL_openlibs(L);
+    lua_getglobal(L, "package");                                   /* -> package */
+    if (lua_istable(L, -1)) {
+        if (slot->packagePath) {
+            lua_pushstring(L, slot->packagePath);                  /* -> package, path */
+            lua_setfield(L, -2, "path");                           /* -> package */
+        }
+        if (slot->packageCPath) {
+            lua_pushstring(L, slot->packageCPath);                 /* -> package, cpath */
+            lua_setfield(L, -2, "cpath");                          /* -> package */
+        }
+    }
+    lua_pop(L, 1);                                                 /* -> */
+    lua_getglobal(L, "require");                                   /* -> require */
+    lua_pushstring(L, "oocairo");                                  /* -> require, "oocairo" */
+    int rc = lua_pcall(L, 1, 0, 0);                                /* -> ? */
+    if (rc == 0) {
+        rc = luaL_loadbuffer(L, slot->source, slot->sourceLength, "=painter"); /* -> chunk */
+    }
+    if (rc == 0) {
+        lua_pushinteger(L, thread);                                /* -> chunk, thread */
+        rc = lua_pcall(L, 1, 1, 0);                                /* -> func */
+    }
+    if (rc == 0 && lua_type(L, -1) != LUA_TFUNCTION) {
+        lua_pushfstring(L, "painter chunk must return a function, got %s", 
+                           luaL_typename(L, -1));                  /* -> func, msg */
+        rc = LUA_ERRRUN;
+    }
+    if (rc == 0) {
+        cairo_t** context = lua_newuserdata(L, sizeof(cairo_t*));  /* -> func, context */
+        *context = NULL;
+        luaL_getmetatable(L, OOCAIRO_MT_NAME_CONTEXT);             /* -> func, context, meta */
+        lua_setmetatable(L, -2);                                   /* -> func, context */
+        return L;
+    }                                                              /* -> msg */
+    setPaintError(slot, "lpugl_cairo: error loading painter: ", lua_tostring(L, -1));
+    lua_close(L);
+    return NULL;
+}
+
+static void paintLuaTile(PaintSlot* slot, cairo_t* cr, const lpugl_cairotile* tile)
+{
+    lua_State* L = slot->states[tile->thread];
+    if (!L) {
+        if (slot->failed[tile->thread]) {
+            return;
+        }
+        L = newPaintState(slot, tile->thread);
+        if (!L) {
+            slot->failed[tile->thread] = true;
+            return;
+        }
+        slot->states[tile->thread] = L;
+    }                                                              /* -> func, context */
+    cairo_t** context = lua_touserdata(L, 2);
+    *context = cairo_reference(cr);
+    lua_pushvalue(L, 1);                                           /* -> func, context, func */
+    lua_pushvalue(L, 2);                                           /* -> func, context, func, context */
+    lua_pushinteger(L, tile->x);
+    lua_pushinteger(L, tile->y);
+    lua_pushinteger(L, tile->width);
+    lua_pushinteger(L, tile->height);
+    lua_pushinteger(L, tile->viewWidth);
+    lua_pushinteger(L, tile->viewHeight);                          /* -> func, context, func, args... */
+    if (lua_pcall(L, 7, 0, 0) != 0) {                              /* -> func, context, msg */
+        setPaintError(slot, "lpugl_cairo: error in painter: ", lua_tostring(L, -1));
+        lua_pop(L, 1);                                             /* -> func, context */
+    }
+    cairo_destroy(*context);
+    *context = NULL;
+}
+
+/* ============================================================================================ */
+
+static void paintTile(TilePool* pool, PaintSlot* slot, Tile* tile, int thread)
+{
+    lpugl_cairotile t;
+    t.view       = slot->view;
+    t.x          = tile->x;
+    t.y          = tile->y;
+    t.width      = tile->width;
+    t.height     = tile->height;
+    t.viewWidth  = pool->jobViewWidth;
+    t.viewHeight = pool->jobViewHeight;
+    t.thread     = thread;
+
+    cairo_t* cr = cairo_create(tile->image);
+    cairo_translate(cr, -tile->x, -tile->y);
+    cairo_rectangle(cr, tile->x, tile->y, tile->width, tile->height);
+    cairo_clip(cr);
+    if (slot->capi) {
+        slot->capi->paintTile(slot->painter, cr, &t);
+    } else {
+        paintLuaTile(slot, cr, &t);
+    }
+    cairo_destroy(cr);
+    cairo_surface_flush(tile->image);
+
+    if (atomic_inc(&pool->done) == atomic_get(&pool->tileCount)) {
+        async_mutex_lock(&pool->doneMutex);
+        async_mutex_notify(&pool->doneMutex);
+        async_mutex_unlock(&pool->doneMutex);
+    }
+}
+
+/* paints tiles of the current job until no unclaimed tile is left */
+static void paintClaimedTiles(TilePool* pool, int thread)
+{
+    while (true) {
+        int claim = atomic_get(&pool->claim);
+        int index = claim & LPUGL_CAIRO_TILE_INDEX_MASK;
+        if ((claim >> 16) == 0 || index >= atomic_get(&pool->tileCount)) {
+            return;
+        }
+        if (atomic_set_if_equal(&pool->claim, claim, claim + 1)) {
+            paintTile(pool, pool->jobSlot, &pool->tiles[index], thread);
+        }
+    }
+}
+
+static void tileThreadMain(void* arg)
+{
+    TilePool* pool   = ((TileThreadArg*)arg)->pool;
+    int       thread = ((TileThreadArg*)arg)->index;
+    free(arg);
+    int seen = 0;
+    while (true) {
+        async_mutex_lock(&pool->jobMutex);
+        int serial;
+        while (((serial = atomic_get(&pool->claim) >> 16) == 0 || serial == seen)
+               && !atomic_get(&pool->stopping)) {
+            async_mutex_wait(&pool->jobMutex);
+        }
+        async_mutex_unlock(&pool->jobMutex);
+        if (atomic_get(&pool->stopping)) {
+            return;
+        }
+        seen = serial;
+        paintClaimedTiles(pool, thread);
+    }
+}
+
+/* ============================================================================================ */
+
+static bool addTile(TilePool* pool, int count, int x0, int y0, int x1, int y1)
+{
+    if (count >= LPUGL_CAIRO_MAX_TILE_COUNT) {
+        return false;
+    }
+    if (count >= pool->tileCapacity) {
+        int   newCapacity = pool->tileCapacity ? 2 * pool->tileCapacity : 64;
+        Tile* newTiles    = realloc(pool->tiles, newCapacity * sizeof(Tile));
+        if (!newTiles) {
+            return false;
+        }
+        memset(newTiles + pool->tileCapacity, 0, (newCapacity - pool->tileCapacity) * sizeof(Tile));
+        pool->tiles        = newTiles;
+        pool->tileCapacity = newCapacity;
+    }
+    Tile* tile = &pool->tiles[count];
+    if (!tile->image) {
+        tile->image = cairo_image_surface_create(CAIRO_FORMAT_RGB24, pool->tileSize, pool->tileSize);
+    }
+    tile->x      = x0;
+    tile->y      = y0;
+    tile->width  = x1 - x0;
+    tile->height = y1 - y0;
+    return true;
+}
+
+/* splits the damaged region into grid cells, a tile is the damaged part of a cell */
+static int prepareTiles(TilePool* pool, const PuglRect* rects, int numRects)
+{
+    int size  = pool->tileSize;
+    int count = 0;
+    for (int cy = 0; cy < pool->jobViewHeight; cy += size) {
+        for (int cx = 0; cx < pool->jobViewWidth; cx += size) {
+            int x0 = INT_MAX, y0 = INT_MAX, x1 = INT_MIN, y1 = INT_MIN;
+            for (int i = 0; i < numRects; ++i) {
+                int rx0 = (int)floor(rects[i].x);
+                int ry0 = (int)floor(rects[i].y);
+                int rx1 = (int)ceil(rects[i].x + rects[i].width);
+                int ry1 = (int)ceil(rects[i].y + rects[i].height);
+                if (rx0 < cx) rx0 = cx;
+                if (ry0 < cy) ry0 = cy;
+                if (rx1 > cx + size) rx1 = cx + size;
+                if (ry1 > cy + size) ry1 = cy + size;
+                if (rx0 < rx1 && ry0 < ry1) {
+                    if (rx0 < x0) x0 = rx0;
+                    if (ry0 < y0) y0 = ry0;
+                    if (rx1 > x1) x1 = rx1;
+                    if (ry1 > y1) y1 = ry1;
+                }
+            }
+            if (x0 < x1 && y0 < y1) {
+                if (!addTile(pool, count, x0, y0, x1, y1)) {
+                    return count;
+                }
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+/* called by pugl on the world's thread when leaving the exposure, see puglSetCairoPaintFunc() */
+static void paintView(PuglView* view, void* data, void* cairoContext, 
+                      const PuglRect* rects, int numRects, PuglRect frame)
+{
+    PaintSlot* slot = data;
+    TilePool*  pool = slot->pool;
+
+    atomic_set(&pool->claim, 0);
+    pool->jobViewWidth  = (int)frame.width;
+    pool->jobViewHeight = (int)frame.height;
+    int count = prepareTiles(pool, rects, numRects);
+    if (count == 0) {
+        return;
+    }
+    pool->jobSlot = slot;
+    atomic_set(&pool->tileCount, count);
+    atomic_set(&pool->done, 0);
+    pool->serial = (pool->serial % 0x7fff) + 1;
+
+    async_mutex_lock(&pool->jobMutex);
+    atomic_set(&pool->claim, pool->serial << 16);
+    for (int i = 0; i < pool->threadCount; ++i) {
+        async_mutex_notify(&pool->jobMutex);
+    }
+    async_mutex_unlock(&pool->jobMutex);
+
+    paintClaimedTiles(pool, 0);
+
+    async_mutex_lock(&pool->doneMutex);
+    while (atomic_get(&pool->done) < count) {
+        async_mutex_wait(&pool->doneMutex);
+    }
+    async_mutex_unlock(&pool->doneMutex);
+
+    reportPaintError(slot);
+
+    cairo_t* cr = cairoContext;
+    cairo_save(cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+    for (int i = 0; i < count; ++i) {
+        Tile* tile = &pool->tiles[i];
+        cairo_set_source_surface(cr, tile->image, tile->x, tile->y);
+        cairo_rectangle(cr, tile->x, tile->y, tile->width, tile->height);
+        cairo_fill(cr);
+    }
+    cairo_restore(cr);
+}
+
+/* ============================================================================================ */
+
+static void freeSlot(PaintSlot* slot)
+{
+    if (slot->states) {
+        for (int i = 0; i <= slot->pool->threadCount; ++i) {
+            if (slot->states[i]) {
+                lua_close(slot->states[i]);
+            }
+        }
+    }
+    if (slot->painter) {
+        slot->capi->releasePainter(slot->painter);
+    }
+    free(atomic_get_ptr(&slot->error));
+    free(slot->states);
+    free(slot->failed);
+    free(slot->source);
+    free(slot->packagePath);
+    free(slot->packageCPath);
+    free(slot);
+}
+
+static char* copyString(const char* s, size_t len)
+{
+    char* rslt = malloc(len + 1);
+    if (rslt) {
+        memcpy(rslt, s, len);
+        rslt[len] = '\0';
+    }
+    return rslt;
+}
+
+/* tiles are only painted while leaving an exposure, therefore the slot is unused here */
+static void removeSlot(TilePool* pool, PaintSlot* slot)
+{
+    puglSetCairoPaintFunc(slot->view, NULL, NULL);
+    PaintSlot** ptr = &pool->slots;
+    while (*ptr != slot) {
+        ptr = &(*ptr)->next;
+    }
+    *ptr = slot->next;
+    freeSlot(slot);
+}
+
+static void stopTilePool(TilePool* pool)
+{
+    async_mutex_lock(&pool->jobMutex);
+    atomic_set(&pool->stopping, 1);
+    for (int i = 0; i < pool->threadCount; ++i) {
+        async_mutex_notify(&pool->jobMutex);
+    }
+    async_mutex_unlock(&pool->jobMutex);
+    for (int i = 0; i < pool->threadCount; ++i) {
+        async_thread_join(&pool->threads[i]);
+    }
+    for (int i = 0; i < pool->tileCapacity; ++i) {
+        if (pool->tiles[i].image) {
+            cairo_surface_destroy(pool->tiles[i].image);
+        }
+    }
+    async_mutex_destruct(&pool->doneMutex);
+    async_mutex_destruct(&pool->jobMutex);
+    free(pool->tiles);
+    free(pool->threads);
+    free(pool);
+}
+
+static TilePool* startTilePool(int threadCount, int tileSize)
+{
+    TilePool* pool = calloc(1, sizeof(TilePool));
+    if (!pool) {
+        return NULL;
+    }
+    pool->tileSize = tileSize;
+    pool->threads  = calloc(threadCount > 0 ? threadCount : 1, sizeof(Thread));
+    if (!pool->threads) {
+        free(pool);
+        return NULL;
+    }
+    async_mutex_init(&pool->jobMutex);
+    async_mutex_init(&pool->doneMutex);
+    while (pool->threadCount < threadCount) {
+        TileThreadArg* arg = malloc(sizeof(TileThreadArg));
+        if (arg) {
+            arg->pool  = pool;
+            arg->index = pool->threadCount + 1;
+        }
+        if (!arg || !async_thread_start(&pool->threads[pool->threadCount], tileThreadMain, arg)) {
+            free(arg);
+            stopTilePool(pool);
+            return NULL;
+        }
+        pool->threadCount += 1;
+    }
+    return pool;
+}
+
+/* ============================================================================================ */
+
+static void setRenderer(lua_State* L, LpuglBackend* backend, PuglView* view, int rendererIdx)
+{
+    TilePool* pool = ((LpuglCairoBackend*)backend)->tilePool;
+
+    const lpugl_cairopainter_capi* capi    = NULL;
+    lpugl_cairopainter*            painter = NULL;
+    size_t                         len     = 0;
+    const char*                    source  = NULL;
+    if (rendererIdx) {
+        if (lua_type(L, rendererIdx) == LUA_TSTRING) {
+            source = lua_tolstring(L, rendererIdx, &len);
+        } else {
+            int errorReason = 0;
+            capi    = lpugl_cairopainter_get_capi(L, rendererIdx, &errorReason);
+            painter = capi ? capi->toPainter(L, rendererIdx) : NULL;
+            if (!painter) {
+                luaL_argerror(L, rendererIdx, errorReason == 1 ? "painter C API version mismatch"
+                                                               : "painter object or Lua source expected");
+            }
+        }
+        if (!pool) {
+            lpugl_error(L, LPUGL_ERROR_ILLEGAL_STATE ": backend closed");
+        }
+    }
+    PaintSlot* slot = pool ? pool->slots : NULL;
+    while (slot && slot->view != view) {
+        slot = slot->next;
+    }
+    if (slot) {
+        removeSlot(pool, slot);
+    }
+    if (!rendererIdx) {
+        return;
+    }
+    PaintSlot* newSlot = calloc(1, sizeof(PaintSlot));
+    if (!newSlot) {
+        lpugl_error(L, LPUGL_ERROR_OUT_OF_MEMORY);
+    }
+    newSlot->view  = view;
+    newSlot->pool  = pool;
+    newSlot->world = backend->world;
+    if (source) {
+        newSlot->source       = copyString(source, len);
+        newSlot->sourceLength = len;
+        newSlot->states       = calloc(pool->threadCount + 1, sizeof(lua_State*));
+        newSlot->failed       = calloc(pool->threadCount + 1, sizeof(bool));
+        if (lua_getglobal(L, "package") == LUA_TTABLE) {                       /* -> package */
+            if (lua_getfield(L, -1, "path") == LUA_TSTRING) {                  /* -> package, path */
+                newSlot->packagePath  = copyString(lua_tostring(L, -1), lua_rawlen(L, -1));
+            }
+            lua_pop(L, 1);                                                     /* -> package */
+            if (lua_getfield(L, -1, "cpath") == LUA_TSTRING) {                 /* -> package, cpath */
+                newSlot->packageCPath = copyString(lua_tostring(L, -1), lua_rawlen(L, -1));
+            }
+            lua_pop(L, 1);                                                     /* -> package */
+        }
+        lua_pop(L, 1);                                                         /* -> */
+        if (!newSlot->source || !newSlot->states || !newSlot->failed) {
+            freeSlot(newSlot);
+            lpugl_error(L, LPUGL_ERROR_OUT_OF_MEMORY);
+        }
+    } else {
+        capi->retainPainter(painter);
+        newSlot->painter = painter;
+        newSlot->capi    = capi;
+    }
+    PuglStatus rc = puglSetCairoPaintFunc(view, paintView, newSlot);
+    if (rc != PUGL_SUCCESS) {
+        freeSlot(newSlot);
+        if (rc == PUGL_UNSUPPORTED_TYPE) {
+            lpugl_error(L, LPUGL_ERROR_FAILED_OPERATION ": painter not supported on this platform");
+        } else {
+            lpugl_error(L, LPUGL_ERROR_ILLEGAL_STATE ": view not realized");
+        }
+    }
+    newSlot->next = pool->slots;
+    pool->slots   = newSlot;  // view:setRenderer() posts a redisplay
+}
+
+/* ============================================================================================ */
+
+#define IMAGE_LOADING 0
+#define IMAGE_READY   1
+#define IMAGE_FAILED  2
+#define IMAGE_CLOSED  3   // backend was closed
+
+static const char PNG_SIGNATURE[8] = { '\x89', 'P', 'N', 'G', '\r', '\n', '\x1a', '\n' };
+
+/*
+ * Cached image, shared by all image objects that were loaded with the same source 
+ * and scale. Only accessed on the world's thread.
+ */
+typedef struct ImageEntry {
+    char*               key;       // scale and path or PNG bytes
+    size_t              keyLength;
+    unsigned long       keyHash;
+    int                 state;
+    cairo_surface_t*    surface;
+    char*               error;
+    size_t              bytes;
+    int                 refs;      // image objects
+    bool                pending;   // IMAGE_READY is to be delivered
+    struct ImageLoader* loader;    // NULL if backend was closed or loading failed
+    struct ImageEntry*  prev;      // in LRU list, most recently used first
+    struct ImageEntry*  next;
+} ImageEntry;
+
+typedef struct ImageJob {
+    ImageEntry*      entry;
+    char*            data;         // path or PNG bytes, NULL for already loaded entry
+    size_t           length;
+    bool             isPath;
+    double           scale;
+    cairo_surface_t* result;
+    const char*      error;        // cairo's static status string
+    struct ImageJob* next;
+} ImageJob;
+
+/*
+ * PNG images are decoded on the loader thread, finished jobs are handed over without 
+ * locking and the world's event loop is awakened through a channel.
+ */
+typedef struct ImageLoader {
+    Thread                     thread;
+    Mutex                      mutex;       // loader thread waits for queued jobs
+    ImageJob*                  queue;
+    ImageJob**                 queueTail;
+    AtomicPtr                  done;        // finished jobs, most recent first
+    AtomicCounter              stopping;
+    lpugl_channel*             channel;
+    const lpugl_channel_capi*  channelCapi;
+    LpuglBackend*              backend;
+    ImageEntry*                first;       // LRU list
+    ImageEntry*                last;
+    size_t                     cacheBytes;
+    size_t                     maxCacheBytes;
+} ImageLoader;
+
+typedef struct ImageUserData {
+    ImageEntry* entry;
+} ImageUserData;
+
+/* ============================================================================================ */
+
+typedef struct PngBytes {
+    const unsigned char* data;
+    size_t               length;
+    size_t               pos;
+} PngBytes;
+
+static cairo_status_t readPngBytes(void* closure, unsigned char* data, unsigned int length)
+{
+    PngBytes* png = closure;
+    if (png->length - png->pos < length) {
+        return CAIRO_STATUS_READ_ERROR;
+    }
+    memcpy(data, png->data + png->pos, length);
+    png->pos += length;
+    return CAIRO_STATUS_SUCCESS;
+}
+
+static void decodeImage(ImageJob* job)
+{
+    cairo_surface_t* image;
+    if (job->isPath) {
+        image = cairo_image_surface_create_from_png(job->data);
+    } else {
+        PngBytes png = { (const unsigned char*)job->data, job->length, 0 };
+        image = cairo_image_surface_create_from_png_stream(readPngBytes, &png);
+    }
+    if (cairo_surface_status(image) == CAIRO_STATUS_SUCCESS && job->scale != 1) {
+        int width  = (int)ceil(cairo_image_surface_get_width(image)  * job->scale);
+        int height = (int)ceil(cairo_image_surface_get_height(image) * job->scale);
+        cairo_surface_t* scaled = cairo_image_surface_create(cairo_image_surface_get_format(image), 
+                                                             width, height);
+        cairo_t* cr = cairo_create(scaled);
+        cairo_scale(cr, job->scale, job->scale);
+        cairo_set_source_surface(cr, image, 0, 0);
+        cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_GOOD);
+        cairo_paint(cr);
+        cairo_destroy(cr);
+        cairo_surface_destroy(image);
+        image = scaled;
+    }
+    cairo_status_t status = cairo_surface_status(image);
+    if (status == CAIRO_STATUS_SUCCESS) {
+        cairo_surface_flush(image);
+        job->result = image;
+    } else {
+        job->error = cairo_status_to_string(status);
+        cairo_surface_destroy(image);
+    }
+}
+
+static void pushDoneJob(ImageLoader* loader, ImageJob* job)
+{
+    while (true) {
+        ImageJob* first = atomic_get_ptr(&loader->done);
+        job->next = first;
+        if (atomic_set_ptr_if_equal(&loader->done, first, job)) {
+            break;
+        }
+    }
+    loader->channelCapi->push(loader->channel, "", 0);
+}
+
+static void loaderThreadMain(void* arg)
+{
+    ImageLoader* loader = arg;
+    while (true) {
+        async_mutex_lock(&loader->mutex);
+        while (!loader->queue && !atomic_get(&loader->stopping)) {
+            async_mutex_wait(&loader->mutex);
+        }
+        ImageJob* job = NULL;
+        if (!atomic_get(&loader->stopping)) {
+            job = loader->queue;
+            loader->queue = job->next;
+            if (!loader->queue) {
+                loader->queueTail = &loader->queue;
+            }
+        }
+        async_mutex_unlock(&loader->mutex);
+        if (!job) {
+            return; // stopping
+        }
+        decodeImage(job);
+        pushDoneJob(loader, job);
+    }
+}
+
+/* ============================================================================================ */
+
+static void freeJob(ImageJob* job)
+{
+    if (job->result) {
+        cairo_surface_destroy(job->result);
+    }
+    free(job->data);
+    free(job);
+}
+
+static void freeEntry(ImageEntry* entry)
+{
+    if (entry->surface) {
+        cairo_surface_destroy(entry->surface);
+    }
+    free(entry->error);
+    free(entry->key);
+    free(entry);
+}
+
+static void unlinkEntry(ImageLoader* loader, ImageEntry* entry)
+{
+    if (entry->prev) entry->prev->next = entry->next; else loader->first = entry->next;
+    if (entry->next) entry->next->prev = entry->prev; else loader->last  = entry->prev;
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+static void touchEntry(ImageLoader* loader, ImageEntry* entry)
+{
+    if (loader->first != entry) {
+        unlinkEntry(loader, entry);
+        entry->next = loader->first;
+        if (loader->first) loader->first->prev = entry; else loader->last = entry;
+        loader->first = entry;
+    }
+}
+
+/* evicts least recently used entries that are not referenced by image objects */
+static void evictEntries(ImageLoader* loader)
+{
+    ImageEntry* entry = loader->last;
+    while (entry && loader->cacheBytes > loader->maxCacheBytes) {
+        ImageEntry* prev = entry->prev;
+        if (entry->refs == 0 && !entry->pending && entry->state != IMAGE_LOADING) {
+            unlinkEntry(loader, entry);
+            loader->cacheBytes -= entry->bytes;
+            freeEntry(entry);
+        }
+        entry = prev;
+    }
+}
+
+static ImageJob* takeDoneJobs(ImageLoader* loader)
+{
+    ImageJob* jobs;
+    while (true) {
+        jobs = atomic_get_ptr(&loader->done);
+        if (!jobs || atomic_set_ptr_if_equal(&loader->done, jobs, NULL)) {
+            break;
+        }
+    }
+    ImageJob* reversed = NULL;
+    while (jobs) {
+        ImageJob* next = jobs->next;
+        jobs->next = reversed;
+        reversed   = jobs;
+        jobs       = next;
+    }
+    return reversed;
+}
+
+/* 
+ * Channel function of the image loader: upvalue 1 is the loader as light userdata, 
+ * upvalue 2 is the table of image objects waiting for IMAGE_READY by entry and
+ * upvalue 3 is a weak table containing the backend.
+ */
+static int deliverLoadedImages(lua_State* L)
+{
+    ImageLoader* loader  = lua_touserdata(L, lua_upvalueindex(1));
+    int          pending = lua_upvalueindex(2);
+    lua_settop(L, 0);                                                          /* -> */
+    lua_rawgeti(L, lua_upvalueindex(3), 1);                                    /* -> backend */
+    LpuglBackend* backend = lua_touserdata(L, 1);
+    if (!backend || !backend->world) {
+        return 0;
+    }
+    lua_newtable(L);                                                           /* -> backend, events */
+    int events = 0;
+    ImageJob* job = takeDoneJobs(loader);
+    while (job) {
+        ImageJob*   next  = job->next;
+        ImageEntry* entry = job->entry;
+        if (job->data) {
+            if (job->result) {
+                entry->state   = IMAGE_READY;
+                entry->surface = job->result;
+                entry->bytes   = (size_t)cairo_image_surface_get_stride(job->result)
+                               * cairo_image_surface_get_height(job->result)
+                               + entry->keyLength;
+                loader->cacheBytes += entry->bytes;
+                job->result = NULL;
+            } else {
+                // failed entries are not cached, they are freed with the last image object
+                entry->state  = IMAGE_FAILED;
+                entry->error  = copyString(job->error, strlen(job->error));
+                entry->loader = NULL;
+                unlinkEntry(loader, entry);
+            }
+        }
+        freeJob(job);
+        entry->pending = false;
+        if (lua_rawgetp(L, pending, entry) == LUA_TTABLE) {                    /* -> backend, events, images */
+            lua_pushnil(L);                                                    /* -> backend, events, images, nil */
+            lua_rawsetp(L, pending, entry);                                    /* -> backend, events, images */
+            int count = (int)lua_rawlen(L, 3);
+            for (int i = 1; i <= count; ++i) {
+                lua_rawgeti(L, 3, i);                                          /* -> backend, events, images, image */
+                if (!((ImageUserData*)lua_touserdata(L, -1))->entry) {
+                    lua_pop(L, 1);                                             /* -> backend, events, images */
+                    continue; // image was closed while loading
+                }
+                lua_rawseti(L, 2, ++events);                                   /* -> backend, events, images */
+                if (entry->error) {
+                    lua_pushstring(L, entry->error);                           /* -> backend, events, images, error */
+                } else {
+                    lua_pushboolean(L, false);                                 /* -> backend, events, images, false */
+                }
+                lua_rawseti(L, 2, ++events);                                   /* -> backend, events, images */
+            }
+        }
+        lua_settop(L, 2);                                                      /* -> backend, events */
+        if (entry->state == IMAGE_FAILED && entry->refs == 0) {
+            freeEntry(entry);
+        }
+        job = next;
+    }
+    evictEntries(loader);
+
+    // the loader must not be accessed from here on: event handling functions may close the backend
+    for (int i = 1; i < events && backend->world; i += 2) {
+        lua_rawgeti(L, 2, i);                                                  /* -> backend, events, image */
+        if (!((ImageUserData*)lua_touserdata(L, -1))->entry) {
+            lua_settop(L, 2);                                                  /* -> backend, events */
+            continue; // image was closed by a previous event handling function
+        }
+        if (lua_rawgeti(L, 2, i + 1) == LUA_TBOOLEAN) {                        /* -> backend, events, image, error */
+            lua_pop(L, 1);                                                     /* -> backend, events, image */
+            lua_pushnil(L);                                                    /* -> backend, events, image, nil */
+        }
+        backend->world->deliverBackendEvent(L, backend->world, backend, "IMAGE_READY", 3, 2);
+        lua_settop(L, 2);                                                      /* -> backend, events */
+    }
+    return 0;
+}
+
+/* ============================================================================================ */
+
+static void stopImageLoader(lua_State* L, ImageLoader* loader, int channelIdx)
+{
+    async_mutex_lock(&loader->mutex);
+    atomic_set(&loader->stopping, 1);
+    async_mutex_notify(&loader->mutex);
+    async_mutex_unlock(&loader->mutex);
+    async_thread_join(&loader->thread);
+
+    ImageJob* job = loader->queue;
+    while (job) {
+        ImageJob* next = job->next;
+        freeJob(job);
+        job = next;
+    }
+    job = takeDoneJobs(loader);
+    while (job) {
+        ImageJob* next = job->next;
+        freeJob(job);
+        job = next;
+    }
+    if (channelIdx && lua_getfield(L, channelIdx, "close") == LUA_TFUNCTION) { /* -> close */
+        lua_pushvalue(L, channelIdx);                                          /* -> close, channel */
+        lua_call(L, 1, 0);                                                     /* -> */
+    } else {                                                                   /* -> ? */
+        lua_pop(L, 1);                                                         /* -> */
+    }
+    loader->channelCapi->releaseChannel(loader->channel);
+
+    // entries that are still referenced by image objects are freed with the last object
+    ImageEntry* entry = loader->first;
+    while (entry) {
+        ImageEntry* next = entry->next;
+        if (entry->refs > 0) {
+            if (entry->surface) {
+                cairo_surface_destroy(entry->surface);
+                entry->surface = NULL;
+            }
+            entry->state  = IMAGE_CLOSED;
+            entry->loader = NULL;
+            entry->prev   = NULL;
+            entry->next   = NULL;
+        } else {
+            freeEntry(entry);
+        }
+        entry = next;
+    }
+    async_mutex_destruct(&loader->mutex);
+    free(loader);
+}
+
+/*
+ * Creates the image loader with its channel, which is stored in the backend's 
+ * uservalue together with the table of pending image objects.
+ */
+static ImageLoader* startImageLoader(lua_State* L, LpuglCairoBackend* udata, int backendIdx)
+{
+    ImageLoader* loader = calloc(1, sizeof(ImageLoader));
+    if (!loader) {
+        lpugl_error(L, LPUGL_ERROR_OUT_OF_MEMORY);
+    }
+    loader->queueTail     = &loader->queue;
+    loader->backend       = &udata->base;
+    loader->maxCacheBytes = udata->imageCacheSize;
+
+    lua_getuservalue(L, backendIdx);                                   /* -> uservalue */
+    lua_newtable(L);                                                   /* -> uservalue, pending */
+    lua_pushvalue(L, -1);                                              /* -> uservalue, pending, pending */
+    lua_rawseti(L, -3, LPUGL_CAIRO_BACKEND_UV_PENDING_IMAGES);         /* -> uservalue, pending */
+    lua_rawgeti(L, -2, LPUGL_CAIRO_BACKEND_UV_WORLD);                  /* -> uservalue, pending, world */
+    lua_getfield(L, -1, "newChannel");                                 /* -> uservalue, pending, world, newChannel */
+    lua_insert(L, -2);                                                 /* -> uservalue, pending, newChannel, world */
+    lua_pushlightuserdata(L, loader);                                  /* -> uservalue, pending, newChannel, world, loader */
+    lua_pushvalue(L, -4);                                              /* -> uservalue, pending, newChannel, world, loader, pending */
+    lua_newtable(L);                                                   /* -> uservalue, pending, newChannel, world, loader, pending, weak */
+    lua_newtable(L);                                                   /* -> ..., weak, meta */
+    lua_pushliteral(L, "v");                                           /* -> ..., weak, meta, "v" */
+    lua_setfield(L, -2, "__mode");                                     /* -> ..., weak, meta */
+    lua_setmetatable(L, -2);                                           /* -> ..., weak */
+    lua_pushvalue(L, backendIdx);                                      /* -> ..., weak, backend */
+    lua_rawseti(L, -2, 1);                                             /* -> ..., weak */
+    lua_pushcclosure(L, deliverLoadedImages, 3);                       /* -> uservalue, pending, newChannel, world, func */
+    int rc = lua_pcall(L, 2, 1, 0);                                    /* -> uservalue, pending, channel */
+
+    int errorReason = 0;
+    const lpugl_channel_capi* capi = (rc == 0) ? lpugl_channel_get_capi(L, -1, &errorReason) : NULL;
+    if (!capi) {
+        free(loader);
+        if (rc != 0) {
+            lua_error(L);
+        }
+        lpugl_error(L, LPUGL_ERROR_FAILED_OPERATION ": cannot create channel for image loader");
+    }
+    loader->channelCapi = capi;
+    loader->channel     = capi->toChannel(L, -1);
+    capi->retainChannel(loader->channel);
+    lua_rawseti(L, -3, LPUGL_CAIRO_BACKEND_UV_IMAGE_CHANNEL);          /* -> uservalue, pending */
+    lua_pop(L, 2);                                                     /* -> */
+
+    async_mutex_init(&loader->mutex);
+    if (!async_thread_start(&loader->thread, loaderThreadMain, loader)) {
+        lua_getuservalue(L, backendIdx);                               /* -> uservalue */
+        lua_rawgeti(L, -1, LPUGL_CAIRO_BACKEND_UV_IMAGE_CHANNEL);      /* -> uservalue, channel */
+        if (lua_getfield(L, -1, "close") == LUA_TFUNCTION) {           /* -> uservalue, channel, close */
+            lua_insert(L, -2);                                         /* -> uservalue, close, channel */
+            lua_call(L, 1, 0);                                         /* -> uservalue */
+        }
+        lua_settop(L, backendIdx);
+        capi->releaseChannel(loader->channel);
+        async_mutex_destruct(&loader->mutex);
+        free(loader);
+        lpugl_error(L, LPUGL_ERROR_FAILED_OPERATION ": cannot start image loader thread");
+    }
+    return loader;
+}
+
+/* ============================================================================================ */
+
+/* 
+ * The key contains the complete path or PNG bytes, the hash only speeds up
+ * the lookup of cached entries.
+ */
+static char* imageKey(const char* data, size_t length, bool isPath, double scale,
+                      size_t* keyLength, unsigned long* keyHash)
+{
+    char prefix[64];
+    snprintf(prefix, sizeof(prefix), "%c%.17g:", isPath ? 'p' : 'b', scale);
+    size_t prefixLength = strlen(prefix);
+    char*  key          = malloc(prefixLength + length + 1);
+    if (key) {
+        memcpy(key, prefix, prefixLength);
+        memcpy(key + prefixLength, data, length);
+        key[prefixLength + length] = '\0';
+        *keyLength = prefixLength + length;
+
+        unsigned long h = 2166136261UL; // FNV-1a
+        for (size_t i = 0; i < *keyLength; ++i) {
+            h = ((h ^ (unsigned char)key[i]) * 16777619UL) & 0xffffffffUL;
+        }
+        *keyHash = h;
+    }
+    return key;
+}
+
+static int Backend_loadImageAsync(lua_State* L)
+{
+    LpuglCairoBackend* udata = luaL_checkudata(L, 1, LPUGL_CAIRO_BACKEND_CLASS_NAME);
+    size_t      length;
+    const char* data   = luaL_checklstring(L, 2, &length);
+    double      scale  = luaL_optnumber(L, 3, 1.0);
+    bool        isPath = (length < sizeof(PNG_SIGNATURE) 
+                          || memcmp(data, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) != 0);
+    if (!(scale > 0)) {
+        return luaL_argerror(L, 3, "positive number expected");
+    }
+    if (isPath && strlen(data) != length) {
+        return luaL_argerror(L, 2, "invalid path");
+    }
+    if (!udata->base.world) {
+        return lpugl_error(L, LPUGL_ERROR_ILLEGAL_STATE ": lpugl_cairo.backend closed");
+    }
+    lua_settop(L, 3);
+    if (!udata->imageLoader) {
+        udata->imageLoader = startImageLoader(L, udata, 1);
+    }
+    ImageLoader* loader = udata->imageLoader;
+
+    ImageUserData* image = lua_newuserdata(L, sizeof(ImageUserData));  /* -> image */
+    image->entry = NULL;
+    luaL_setmetatable(L, LPUGL_CAIRO_IMAGE_CLASS_NAME);
+
+    size_t        keyLength;
+    unsigned long keyHash;
+    char* key = imageKey(data, length, isPath, scale, &keyLength, &keyHash);
+    if (!key) {
+        return lpugl_error(L, LPUGL_ERROR_OUT_OF_MEMORY);
+    }
+    ImageEntry* entry = loader->first;
+    while (entry && (   entry->keyHash != keyHash || entry->keyLength != keyLength 
+                     || memcmp(entry->key, key, keyLength) != 0)) 
+    {
+        entry = entry->next;
+    }
+    ImageJob* job = NULL;
+    if (!entry || !entry->pending) {
+        job = calloc(1, sizeof(ImageJob));
+        if (!job) {
+            free(key);
+            return lpugl_error(L, LPUGL_ERROR_OUT_OF_MEMORY);
+        }
+    }
+    if (entry) {
+        free(key);
+    } else {
+        entry = calloc(1, sizeof(ImageEntry));
+        job->data = malloc(length + 1);
+        if (!entry || !job->data) {
+            free(entry);
+            free(key);
+            freeJob(job);
+            return lpugl_error(L, LPUGL_ERROR_OUT_OF_MEMORY);
+        }
+        memcpy(job->data, data, length);
+        job->data[length] = '\0';
+        job->length = length;
+        job->isPath = isPath;
+        job->scale  = scale;
+        entry->key       = key;
+        entry->keyLength = keyLength;
+        entry->keyHash   = keyHash;
+        entry->state     = IMAGE_LOADING;
+        entry->loader    = loader;
+        entry->next      = loader->first;
+        if (loader->first) loader->first->prev = entry; else loader->last = entry;
+        loader->first = entry;
+    }
+    touchEntry(loader, entry);
+    image->entry = entry;
+    entry->refs += 1;
+
+    lua_getuservalue(L, 1);                                            /* -> image, uservalue */
+    lua_rawgeti(L, -1, LPUGL_CAIRO_BACKEND_UV_PENDING_IMAGES);         /* -> image, uservalue, pending */
+    if (lua_rawgetp(L, -1, entry) != LUA_TTABLE) {                     /* -> image, uservalue, pending, ? */
+        lua_pop(L, 1);                                                 /* -> image, uservalue, pending */
+        lua_newtable(L);                                               /* -> image, uservalue, pending, images */
+        lua_pushvalue(L, -1);                                          /* -> image, uservalue, pending, images, images */
+        lua_rawsetp(L, -3, entry);                                     /* -> image, uservalue, pending, images */
+    }
+    lua_pushvalue(L, 4);                                               /* -> image, uservalue, pending, images, image */
+    lua_rawseti(L, -2, (lua_Integer)lua_rawlen(L, -2) + 1);            /* -> image, uservalue, pending, images */
+    lua_settop(L, 4);                                                  /* -> image */
+
+    if (job) {
+        // IMAGE_READY is also delivered asynchronously for images that are already loaded
+        job->entry     = entry;
+        entry->pending = true;
+        if (job->data) {
+            async_mutex_lock(&loader->mutex);
+            *loader->queueTail = job;
+            loader->queueTail  = &job->next;
+            async_mutex_notify(&loader->mutex);
+            async_mutex_unlock(&loader->mutex);
+        } else {
+            pushDoneJob(loader, job);
+        }
+    }
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static ImageUserData* checkImage(lua_State* L, int arg)
+{
+    ImageUserData* image = luaL_checkudata(L, arg, LPUGL_CAIRO_IMAGE_CLASS_NAME);
+    if (!image->entry) {
+        lpugl_error(L, LPUGL_ERROR_ILLEGAL_STATE ": image closed");
+    }
+    return image;
+}
+
+static int Image_release(lua_State* L)
+{
+    ImageUserData* image = luaL_checkudata(L, 1, LPUGL_CAIRO_IMAGE_CLASS_NAME);
+    ImageEntry*    entry = image->entry;
+    if (entry) {
+        image->entry = NULL;
+        entry->refs -= 1;
+        if (!entry->loader && entry->refs == 0) {
+            freeEntry(entry);
+        } else if (entry->refs == 0) {
+            evictEntries(entry->loader);
+        }
+    }
+    return 0;
+}
+
+static int Image_isClosed(lua_State* L)
+{
+    ImageUserData* image = luaL_checkudata(L, 1, LPUGL_CAIRO_IMAGE_CLASS_NAME);
+    lua_pushboolean(L, image->entry == NULL);
+    return 1;
+}
+
+static int Image_isReady(lua_State* L)
+{
+    ImageUserData* image = checkImage(L, 1);
+    lua_pushboolean(L, image->entry->state == IMAGE_READY);
+    return 1;
+}
+
+static int Image_getError(lua_State* L)
+{
+    ImageUserData* image = checkImage(L, 1);
+    if (image->entry->state == IMAGE_CLOSED) {
+        lua_pushliteral(L, "backend closed");
+    } else {
+        lua_pushstring(L, image->entry->error);
+    }
+    return 1;
+}
+
+static int Image_getSize(lua_State* L)
+{
+    ImageUserData* image = checkImage(L, 1);
+    if (image->entry->state != IMAGE_READY) {
+        return 0;
+    }
+    lua_pushinteger(L, cairo_image_surface_get_width(image->entry->surface));
+    lua_pushinteger(L, cairo_image_surface_get_height(image->entry->surface));
+    return 2;
+}
+
+static int Image_setSource(lua_State* L)
+{
+    ImageUserData* image   = checkImage(L, 1);
+    cairo_t**      context = luaL_checkudata(L, 2, OOCAIRO_MT_NAME_CONTEXT);
+    double         x       = luaL_optnumber(L, 3, 0);
+    double         y       = luaL_optnumber(L, 4, 0);
+    ImageEntry*    entry   = image->entry;
+    if (!*context) {
+        return luaL_argerror(L, 2, "cairo context not valid");
+    }
+    if (entry->state != IMAGE_READY) {
+        return lpugl_error(L, LPUGL_ERROR_ILLEGAL_STATE ": image not ready");
+    }
+    touchEntry(entry->loader, entry);
+    cairo_set_source_surface(*context, entry->surface, x, y);
+    return 0;
+}
+
+/* ============================================================================================ */
+
 static void closeBackend(lua_State* L, int backendIdx)
 {
     LpuglCairoBackend* udata = lua_touserdata(L, backendIdx);
@@ -199,6 +1462,23 @@ static void closeBackend(lua_State* L, int backendIdx)
     }                                                          /* -> ? */
     lua_pop(L, 1);                                             /* -> */
 
+    if (udata->imageLoader) {
+        if (lua_getuservalue(L, backendIdx) == LUA_TTABLE) {       /* -> uservalue */
+            lua_rawgeti(L, -1, LPUGL_CAIRO_BACKEND_UV_IMAGE_CHANNEL); /* -> uservalue, channel */
+            stopImageLoader(L, udata->imageLoader, lua_gettop(L));
+            lua_pushnil(L);                                        /* -> uservalue, channel, nil */
+            lua_rawseti(L, -3, LPUGL_CAIRO_BACKEND_UV_PENDING_IMAGES); /* -> uservalue, channel */
+        } else {                                                   /* -> ? */
+            stopImageLoader(L, udata->imageLoader, 0);
+        }
+        lua_settop(L, backendIdx);                                 /* -> */
+        udata->imageLoader = NULL;
+    }
+    if (udata->tilePool) {
+        // all views are closed, therefore no slots are left
+        stopTilePool(udata->tilePool);
+        udata->tilePool = NULL;
+    }
     if (udata->layoutSurface) {
         cairo_surface_destroy(udata->layoutSurface);
         udata->layoutSurface = NULL;
@@ -275,6 +1555,35 @@ static int Lpugl_cairo_newBackend(lua_State* L)
     if (!worldUdata->world) {
         return lpugl_error(L, LPUGL_ERROR_ILLEGAL_STATE ": lpugl.world closed");
     }
+    int    tileThreads    = 0;
+    int    tileSize       = 256;
+    size_t imageCacheSize = 64 * 1024 * 1024;
+    if (!lua_isnoneornil(L, 2)) {
+        luaL_checktype(L, 2, LUA_TTABLE);
+        lua_pushnil(L);                 /* -> nil */
+        while (lua_next(L, 2)) {        /* -> key, value */
+            const char* key = (lua_type(L, -2) == LUA_TSTRING) ? lua_tostring(L, -2) : NULL;
+            if (key && strcmp(key, "tileThreads") == 0) {
+                if (!lua_isinteger(L, -1) || lua_tointeger(L, -1) < 0 || lua_tointeger(L, -1) > 256) {
+                    return luaL_argerror(L, 2, "integer between 0 and 256 expected as 'tileThreads' value");
+                }
+                tileThreads = (int)lua_tointeger(L, -1);
+            } else if (key && strcmp(key, "tileSize") == 0) {
+                if (!lua_isinteger(L, -1) || lua_tointeger(L, -1) < 64 || lua_tointeger(L, -1) > 4096) {
+                    return luaL_argerror(L, 2, "integer between 64 and 4096 expected as 'tileSize' value");
+                }
+                tileSize = (int)lua_tointeger(L, -1);
+            } else if (key && strcmp(key, "imageCacheSize") == 0) {
+                if (!lua_isinteger(L, -1) || lua_tointeger(L, -1) < 0) {
+                    return luaL_argerror(L, 2, "non-negative integer expected as 'imageCacheSize' value");
+                }
+                imageCacheSize = (size_t)lua_tointeger(L, -1);
+            } else {
+                return luaL_argerror(L, 2, lua_pushfstring(L, "unexpected table key '%s'", luaL_tolstring(L, -2, NULL)));
+            }
+            lua_pop(L, 1);              /* -> key */
+        }                               /* -> */
+    }
 
     LpuglCairoBackend* udata = lua_newuserdata(L, sizeof(LpuglCairoBackend));
     memset(udata, 0, sizeof(LpuglCairoBackend));
@@ -283,8 +1592,12 @@ static int Lpugl_cairo_newBackend(lua_State* L)
     strcpy(udata->base.versionId, "lpugl.backend-" LPUGL_PLATFORM_STRING "-" LPUGL_VERSION_STRING);
     udata->base.puglBackend       = puglCairoBackend();
     udata->base.newDrawContext    = newDrawContext;
+    udata->base.bindDrawContext   = bindDrawContext;
     udata->base.finishDrawContext = finishDrawContext;
     udata->base.closeBackend      = closeBackend;
+    udata->base.newSnapshot       = newSnapshot;
+    udata->base.setRenderer       = setRenderer;
+    udata->imageCacheSize         = imageCacheSize;
 
     pushBackendMeta(L);      /* -> udata, meta */
     lua_setmetatable(L, -2); /* -> udata */
@@ -295,7 +1608,11 @@ static int Lpugl_cairo_newBackend(lua_State* L)
     lua_pushvalue(L, 1);                                       /* -> udata, uservalue, world */
     lua_rawseti(L, -2, LPUGL_CAIRO_BACKEND_UV_WORLD);          /* -> udata, uservalue */
     lua_setuservalue(L, -2);                                   /* -> udata */
-    
+
+    udata->tilePool = startTilePool(tileThreads, tileSize);
+    if (!udata->tilePool) {
+        return lpugl_error(L, LPUGL_ERROR_FAILED_OPERATION ": cannot start tile threads");
+    }
     return 1;
 }
 
@@ -338,6 +1655,7 @@ static const luaL_Reg BackendMethods[] =
     { "close",            Backend_close            },
     { "isClosed",         Backend_isClosed         },
     { "getLayoutContext", Backend_getLayoutContext },
+    { "loadImageAsync",   Backend_loadImageAsync   },
     { NULL,               NULL } /* sentinel */
 };
 
@@ -347,6 +1665,23 @@ static const luaL_Reg BackendMetaMethods[] =
     { NULL,           NULL           } /* sentinel */
 };
 
+static const luaL_Reg ImageMethods[] = 
+{
+    { "isReady",          Image_isReady    },
+    { "getError",         Image_getError   },
+    { "getSize",          Image_getSize    },
+    { "setSource",        Image_setSource  },
+    { "close",            Image_release    },
+    { "isClosed",         Image_isClosed   },
+    { NULL,               NULL } /* sentinel */
+};
+
+static const luaL_Reg ImageMetaMethods[] = 
+{
+    { "__gc",         Image_release  },
+    { NULL,           NULL           } /* sentinel */
+};
+
 static const luaL_Reg ModuleFunctions[] = 
 {
     { "newBackend",   Lpugl_cairo_newBackend },
@@ -378,6 +1713,16 @@ LPUGL_DLL_PUBLIC int luaopen_lpugl_cairo(lua_State* L)
     }
     lua_pop(L, 1);
 
+    if (luaL_newmetatable(L, LPUGL_CAIRO_IMAGE_CLASS_NAME)) {
+        lua_pushstring(L, LPUGL_CAIRO_IMAGE_CLASS_NAME);
+        lua_setfield(L, -2, "__metatable");
+        luaL_setfuncs(L, ImageMetaMethods, 0);
+        lua_newtable(L);  /* ImageClass */
+            luaL_setfuncs(L, ImageMethods, 0);
+        lua_setfield (L, -2, "__index");
+    }
+    lua_pop(L, 1);
+
     int n = lua_gettop(L);
     
     int module = ++n; lua_newtable(L);                      /* -> module */
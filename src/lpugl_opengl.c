@@ -2,11 +2,55 @@
 #include "init.h"
 #include "pugl/gl.h"
 
+#if defined(LPUGL_USE_X11)
+    #include <GL/glx.h>
+
+#elif defined(LPUGL_USE_WIN)
+    #include <Windows.h>
+    #include <GL/gl.h>
+
+#elif defined(LPUGL_USE_MAC)
+    #include <OpenGL/OpenGL.h>
+    #include <OpenGL/gl.h>
+#endif
+
 #include "lpugl_opengl.h"
 #include "world.h"
 #include "version.h"
 #include "backend.h"
 #include "error.h"
+#include "async_util.h"
+
+#define LPUGL_GLRENDERER_CAPI_IMPLEMENT_GET_CAPI 1
+#include "glrenderer_capi.h"
+
+#ifndef APIENTRY
+    #define APIENTRY
+#endif
+#ifndef GL_PIXEL_PACK_BUFFER
+    #define GL_PIXEL_PACK_BUFFER            0x88EB
+#endif
+#ifndef GL_STREAM_READ
+    #define GL_STREAM_READ                  0x88E1
+#endif
+#ifndef GL_READ_ONLY
+    #define GL_READ_ONLY                    0x88B8
+#endif
+#ifndef GL_BGRA
+    #define GL_BGRA                         0x80E1
+#endif
+#ifndef GL_UNSIGNED_INT_8_8_8_8_REV
+    #define GL_UNSIGNED_INT_8_8_8_8_REV     0x8367
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GL_SYNC_GPU_COMMANDS_COMPLETE   0x9117
+#endif
+#ifndef GL_ALREADY_SIGNALED
+    #define GL_ALREADY_SIGNALED             0x911A
+#endif
+#ifndef GL_CONDITION_SATISFIED
+    #define GL_CONDITION_SATISFIED          0x911C
+#endif
 
 /* ============================================================================================ */
 
@@ -18,9 +62,68 @@ static const char* const LPUGL_OPENGL_BACKEND_CLASS_NAME = "lpugl_opengl.backend
 
 /* ============================================================================================ */
 
+typedef void      (APIENTRY *GenBuffersFunc)    (GLsizei n, GLuint* buffers);
+typedef void      (APIENTRY *DeleteBuffersFunc) (GLsizei n, const GLuint* buffers);
+typedef void      (APIENTRY *BindBufferFunc)    (GLenum target, GLuint buffer);
+typedef void      (APIENTRY *BufferDataFunc)    (GLenum target, ptrdiff_t size, const void* data, GLenum usage);
+typedef void*     (APIENTRY *MapBufferFunc)     (GLenum target, GLenum access);
+typedef GLboolean (APIENTRY *UnmapBufferFunc)   (GLenum target);
+typedef void*     (APIENTRY *FenceSyncFunc)     (GLenum condition, GLbitfield flags);
+typedef GLenum    (APIENTRY *ClientWaitSyncFunc)(void* sync, GLbitfield flags, uint64_t timeout);
+typedef void      (APIENTRY *DeleteSyncFunc)    (void* sync);
+
+typedef struct SnapshotGlFuncs {
+    bool               loaded;
+    GenBuffersFunc     genBuffers;     // NULL if pixel buffer objects are not supported
+    DeleteBuffersFunc  deleteBuffers;
+    BindBufferFunc     bindBuffer;
+    BufferDataFunc     bufferData;
+    MapBufferFunc      mapBuffer;
+    UnmapBufferFunc    unmapBuffer;
+    FenceSyncFunc      fenceSync;      // NULL if sync objects are not supported
+    ClientWaitSyncFunc clientWaitSync;
+    DeleteSyncFunc     deleteSync;
+} SnapshotGlFuncs;
+
+/* ============================================================================================ */
+
+/*
+ * Renderer of a view that is invoked on the backend's render thread. The world's
+ * thread requests frames without locking by pushing the slot to the render thread's
+ * queue, a slot that is already queued is not pushed again.
+ */
+typedef struct RenderSlot {
+    PuglView*                     view;
+    lpugl_glrenderer*             renderer;
+    const lpugl_glrenderer_capi*  capi;
+    AtomicCounter                 queued;
+    AtomicCounter                 width;
+    AtomicCounter                 height;
+    AtomicCounter                 releasing;  // renderer is to be removed from the view
+    AtomicCounter                 released;
+    unsigned long                 counter;    // only accessed by the render thread
+    struct RenderSlot*            nextQueued;
+    struct RenderSlot*            next;       // in list of all slots, only accessed on the world's thread
+} RenderSlot;
+
+typedef struct RenderThread {
+    Thread         thread;
+    Mutex          mutex;         // render thread waits for queued slots
+    Mutex          releaseMutex;  // world's thread waits for released slots
+    AtomicPtr      queue;         // queued slots, most recent first
+    AtomicCounter  waiting;       // render thread is waiting or about to wait
+    AtomicCounter  stopping;
+    RenderSlot*    slots;
+} RenderThread;
+
+/* ============================================================================================ */
+
 typedef struct LpuglOpenglBackend {
 
-    LpuglBackend base;
+    LpuglBackend       base;
+    PuglGlConfigCache* configCache;
+    SnapshotGlFuncs    snapshotFuncs;
+    RenderThread*      renderThread;
 
 } LpuglOpenglBackend;
 
@@ -37,6 +140,476 @@ static int pushBackendMeta(lua_State* L)
 }
 
 
+/* ============================================================================================ */
+
+typedef struct OpenglSnapshot {
+
+    LpuglSnapshot    base;
+    SnapshotGlFuncs  gl;
+    GLuint           pbo;
+    void*            fence;
+    unsigned char*   pixels;
+
+} OpenglSnapshot;
+
+/* ============================================================================================ */
+
+/*
+ * The snapshot functions may be called for a view while another view is drawing,
+ * therefore the current context is restored afterwards.
+ */
+typedef struct SavedContext {
+#if defined(LPUGL_USE_X11)
+    Display*      display;
+    GLXDrawable   drawable;
+    GLXContext    context;
+#elif defined(LPUGL_USE_WIN)
+    HDC           hdc;
+    HGLRC         context;
+#elif defined(LPUGL_USE_MAC)
+    CGLContextObj context;
+#endif
+} SavedContext;
+
+static bool enterContext(PuglView* view, bool drawing, SavedContext* saved)
+{
+    if (drawing) {
+        return true;
+    }
+#if defined(LPUGL_USE_X11)
+    saved->display  = glXGetCurrentDisplay();
+    saved->drawable = glXGetCurrentDrawable();
+    saved->context  = glXGetCurrentContext();
+#elif defined(LPUGL_USE_WIN)
+    saved->hdc      = wglGetCurrentDC();
+    saved->context  = wglGetCurrentContext();
+#elif defined(LPUGL_USE_MAC)
+    saved->context  = CGLGetCurrentContext();
+#endif
+    return puglEnterContext(view) == PUGL_SUCCESS;
+}
+
+static void leaveContext(PuglView* view, bool drawing, SavedContext* saved)
+{
+    if (drawing) {
+        return;
+    }
+    puglLeaveContext(view);
+#if defined(LPUGL_USE_X11)
+    if (saved->context) {
+        glXMakeCurrent(saved->display, saved->drawable, saved->context);
+    }
+#elif defined(LPUGL_USE_WIN)
+    if (saved->context) {
+        wglMakeCurrent(saved->hdc, saved->context);
+    }
+#elif defined(LPUGL_USE_MAC)
+    if (saved->context) {
+        CGLSetCurrentContext(saved->context);
+    }
+#endif
+}
+
+/* ============================================================================================ */
+
+static bool hasGlVersion(int major, int minor, const char* extension)
+{
+    const char* version  = (const char*)glGetString(GL_VERSION);
+    int         vMajor   = 0;
+    int         vMinor   = 0;
+    if (version && sscanf(version, "%d.%d", &vMajor, &vMinor) == 2
+                && (vMajor > major || (vMajor == major && vMinor >= minor))) {
+        return true;
+    }
+    const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+    size_t      len        = strlen(extension);
+    for (const char* p = extensions; p && (p = strstr(p, extension)) != NULL; p += len) {
+        if ((p == extensions || p[-1] == ' ') && (p[len] == ' ' || p[len] == '\0')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* must be called with current context */
+static void loadSnapshotGlFuncs(SnapshotGlFuncs* gl)
+{
+    if (gl->loaded) {
+        return;
+    }
+    gl->loaded = true;
+    if (hasGlVersion(2, 1, "GL_ARB_pixel_buffer_object")) {
+        gl->genBuffers     = (GenBuffersFunc)    puglGetProcAddress("glGenBuffers");
+        gl->deleteBuffers  = (DeleteBuffersFunc) puglGetProcAddress("glDeleteBuffers");
+        gl->bindBuffer     = (BindBufferFunc)    puglGetProcAddress("glBindBuffer");
+        gl->bufferData     = (BufferDataFunc)    puglGetProcAddress("glBufferData");
+        gl->mapBuffer      = (MapBufferFunc)     puglGetProcAddress("glMapBuffer");
+        gl->unmapBuffer    = (UnmapBufferFunc)   puglGetProcAddress("glUnmapBuffer");
+        if (!gl->genBuffers || !gl->deleteBuffers || !gl->bindBuffer || !gl->bufferData
+                            || !gl->mapBuffer     || !gl->unmapBuffer) {
+            gl->genBuffers = NULL;
+        }
+    }
+    if (gl->genBuffers && hasGlVersion(3, 2, "GL_ARB_sync")) {
+        gl->fenceSync      = (FenceSyncFunc)     puglGetProcAddress("glFenceSync");
+        gl->clientWaitSync = (ClientWaitSyncFunc)puglGetProcAddress("glClientWaitSync");
+        gl->deleteSync     = (DeleteSyncFunc)    puglGetProcAddress("glDeleteSync");
+        if (!gl->fenceSync || !gl->clientWaitSync || !gl->deleteSync) {
+            gl->fenceSync = NULL;
+        }
+    }
+}
+
+/* ============================================================================================ */
+
+/* OpenGL rows are bottom up, snapshot rows are top down */
+static void copyFlipped(OpenglSnapshot* snapshot, const unsigned char* src)
+{
+    int stride = snapshot->base.stride;
+    int height = snapshot->base.height;
+    for (int i = 0; i < height; ++i) {
+        memcpy(snapshot->pixels + i * stride, src + (height - 1 - i) * stride, stride);
+    }
+}
+
+static void freeGlObjects(OpenglSnapshot* snapshot)
+{
+    if (snapshot->fence) {
+        snapshot->gl.deleteSync(snapshot->fence);
+        snapshot->fence = NULL;
+    }
+    if (snapshot->pbo) {
+        snapshot->gl.deleteBuffers(1, &snapshot->pbo);
+        snapshot->pbo = 0;
+    }
+}
+
+/* ============================================================================================ */
+
+static bool snapshotIsReady(LpuglSnapshot* s, PuglView* view, bool drawing)
+{
+    OpenglSnapshot* snapshot = (OpenglSnapshot*)s;
+    if (!snapshot->fence) {
+        return true;
+    }
+    SavedContext saved;
+    if (!enterContext(view, drawing, &saved)) {
+        return false;
+    }
+    GLenum rc = snapshot->gl.clientWaitSync(snapshot->fence, 0, 0);
+    leaveContext(view, drawing, &saved);
+    return rc == GL_ALREADY_SIGNALED || rc == GL_CONDITION_SATISFIED;
+}
+
+/* ============================================================================================ */
+
+static bool snapshotMap(LpuglSnapshot* s, PuglView* view, bool drawing)
+{
+    OpenglSnapshot* snapshot = (OpenglSnapshot*)s;
+    SavedContext saved;
+    if (!enterContext(view, drawing, &saved)) {
+        return false;
+    }
+    snapshot->gl.bindBuffer(GL_PIXEL_PACK_BUFFER, snapshot->pbo);
+    const unsigned char* src = snapshot->gl.mapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    if (src) {
+        copyFlipped(snapshot, src);
+        snapshot->gl.unmapBuffer(GL_PIXEL_PACK_BUFFER);
+        snapshot->base.data = snapshot->pixels;
+    }
+    snapshot->gl.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    freeGlObjects(snapshot);
+    leaveContext(view, drawing, &saved);
+    return snapshot->base.data != NULL;
+}
+
+/* ============================================================================================ */
+
+static void snapshotRelease(LpuglSnapshot* s, PuglView* view, bool drawing)
+{
+    OpenglSnapshot* snapshot = (OpenglSnapshot*)s;
+    if (view && (snapshot->pbo || snapshot->fence)) {
+        SavedContext saved;
+        if (enterContext(view, drawing, &saved)) {
+            freeGlObjects(snapshot);
+            leaveContext(view, drawing, &saved);
+        }
+    } // otherwise the objects were destroyed with the view's context
+    free(snapshot->pixels);
+    free(snapshot);
+}
+
+/* ============================================================================================ */
+
+static LpuglSnapshot* newSnapshot(LpuglBackend* backend, PuglView* view, bool drawing, 
+                                  PuglRect rect, double viewHeight)
+{
+    LpuglOpenglBackend* udata = (LpuglOpenglBackend*)backend;
+
+    OpenglSnapshot* snapshot = calloc(1, sizeof(OpenglSnapshot));
+    if (!snapshot) {
+        return NULL;
+    }
+    snapshot->base.width   = (int)rect.width;
+    snapshot->base.height  = (int)rect.height;
+    snapshot->base.stride  = 4 * snapshot->base.width;
+    snapshot->base.format  = "ARGB32";
+    snapshot->base.isReady = snapshotIsReady;
+    snapshot->base.map     = snapshotMap;
+    snapshot->base.release = snapshotRelease;
+    snapshot->pixels = malloc((size_t)snapshot->base.stride * snapshot->base.height);
+
+    SavedContext saved;
+    if (!snapshot->pixels || !enterContext(view, drawing, &saved)) {
+        free(snapshot->pixels);
+        free(snapshot);
+        return NULL;
+    }
+    loadSnapshotGlFuncs(&udata->snapshotFuncs);
+    snapshot->gl = udata->snapshotFuncs;
+
+    // within exposure the current draw buffer is read, otherwise the presented contents
+    GLint readBuffer = GL_FRONT;
+    if (drawing) {
+        glGetIntegerv(GL_DRAW_BUFFER, &readBuffer);
+    }
+    GLint oldReadBuffer;
+    GLint oldAlignment;
+    glGetIntegerv(GL_READ_BUFFER,    &oldReadBuffer);
+    glGetIntegerv(GL_PACK_ALIGNMENT, &oldAlignment);
+    glReadBuffer(readBuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    GLint x = (GLint)rect.x;
+    GLint y = (GLint)(viewHeight - rect.y - rect.height);
+    GLint w = snapshot->base.width;
+    GLint h = snapshot->base.height;
+
+    if (snapshot->gl.genBuffers) {
+        // asynchronous readback, the pixels are copied when the snapshot is mapped
+        snapshot->gl.genBuffers(1, &snapshot->pbo);
+        snapshot->gl.bindBuffer(GL_PIXEL_PACK_BUFFER, snapshot->pbo);
+        snapshot->gl.bufferData(GL_PIXEL_PACK_BUFFER, (ptrdiff_t)snapshot->base.stride * h, 
+                                NULL, GL_STREAM_READ);
+        glReadPixels(x, y, w, h, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, NULL);
+        snapshot->gl.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        if (snapshot->gl.fenceSync) {
+            snapshot->fence = snapshot->gl.fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+        }
+    } else {
+        unsigned char* tmp = malloc((size_t)snapshot->base.stride * h);
+        if (tmp) {
+            glReadPixels(x, y, w, h, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, tmp);
+            copyFlipped(snapshot, tmp);
+            free(tmp);
+            snapshot->base.data = snapshot->pixels;
+        }
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, oldAlignment);
+    glReadBuffer(oldReadBuffer);
+    leaveContext(view, drawing, &saved);
+
+    if (!snapshot->pbo && !snapshot->base.data) {
+        free(snapshot->pixels);
+        free(snapshot);
+        return NULL;
+    }
+    return &snapshot->base;
+}
+
+/* ============================================================================================ */
+
+static void renderFrame(RenderSlot* slot)
+{
+    if (puglEnterGlFrame(slot->view) == PUGL_SUCCESS) {
+        lpugl_glframe frame;
+        frame.view    = slot->view;
+        frame.width   = atomic_get(&slot->width);
+        frame.height  = atomic_get(&slot->height);
+        frame.counter = slot->counter++;
+        slot->capi->renderFrame(slot->renderer, &frame);
+        puglLeaveGlFrame(slot->view, true);
+    }
+}
+
+static void releaseContext(RenderThread* rt, RenderSlot* slot)
+{
+    if (puglEnterGlFrame(slot->view) == PUGL_SUCCESS) {
+        slot->capi->releaseContext(slot->renderer, slot->view);
+        puglLeaveGlFrame(slot->view, false);
+    }
+    async_mutex_lock(&rt->releaseMutex);
+    atomic_set(&slot->released, 1);
+    async_mutex_notify(&rt->releaseMutex);
+    async_mutex_unlock(&rt->releaseMutex);
+}
+
+static RenderSlot* takeQueuedSlots(RenderThread* rt)
+{
+    while (true) {
+        RenderSlot* slots = atomic_get_ptr(&rt->queue);
+        if (!slots || atomic_set_ptr_if_equal(&rt->queue, slots, NULL)) {
+            return slots;
+        }
+    }
+}
+
+static void renderThreadMain(void* arg)
+{
+    RenderThread* rt = arg;
+    while (true) {
+        RenderSlot* slot = takeQueuedSlots(rt);
+        if (!slot) {
+            async_mutex_lock(&rt->mutex);
+            atomic_set(&rt->waiting, 1);
+            while (!atomic_get_ptr(&rt->queue) && !atomic_get(&rt->stopping)) {
+                async_mutex_wait(&rt->mutex);
+            }
+            atomic_set(&rt->waiting, 0);
+            async_mutex_unlock(&rt->mutex);
+            if (!atomic_get_ptr(&rt->queue)) {
+                return; // stopping
+            }
+            continue;
+        }
+        while (slot) {
+            RenderSlot* next = slot->nextQueued;
+            atomic_set(&slot->queued, 0); // frames requested from now on are rendered again
+            if (atomic_get(&slot->releasing)) {
+                releaseContext(rt, slot); // slot may be freed afterwards
+            } else {
+                renderFrame(slot);
+            }
+            slot = next;
+        }
+    }
+}
+
+/* ============================================================================================ */
+
+static void queueSlot(RenderThread* rt, RenderSlot* slot)
+{
+    if (!atomic_set_if_equal(&slot->queued, 0, 1)) {
+        return; // render thread has not yet taken the slot
+    }
+    while (true) {
+        RenderSlot* first = atomic_get_ptr(&rt->queue);
+        slot->nextQueued = first;
+        if (atomic_set_ptr_if_equal(&rt->queue, first, slot)) {
+            break;
+        }
+    }
+    if (atomic_get(&rt->waiting)) {
+        async_mutex_lock(&rt->mutex);
+        async_mutex_notify(&rt->mutex);
+        async_mutex_unlock(&rt->mutex);
+    }
+}
+
+static RenderSlot* findSlot(RenderThread* rt, PuglView* view)
+{
+    RenderSlot* slot = rt->slots;
+    while (slot && slot->view != view) {
+        slot = slot->next;
+    }
+    return slot;
+}
+
+/* waits until the render thread has finished using the slot */
+static void removeSlot(RenderThread* rt, RenderSlot* slot)
+{
+    atomic_set(&slot->releasing, 1);
+    queueSlot(rt, slot);
+    async_mutex_lock(&rt->releaseMutex);
+    while (!atomic_get(&slot->released)) {
+        async_mutex_wait(&rt->releaseMutex);
+    }
+    async_mutex_unlock(&rt->releaseMutex);
+
+    RenderSlot** ptr = &rt->slots;
+    while (*ptr != slot) {
+        ptr = &(*ptr)->next;
+    }
+    *ptr = slot->next;
+    slot->capi->releaseRenderer(slot->renderer);
+    free(slot);
+}
+
+/* called by pugl on the world's thread, see puglSetGlFrameFunc() */
+static void requestFrame(PuglView* view, void* data, const PuglEventExpose* expose, PuglRect frame)
+{
+    RenderThread* rt   = data;
+    RenderSlot*   slot = findSlot(rt, view);
+    if (slot) {
+        if (expose) {
+            atomic_set(&slot->width,  (int)frame.width);
+            atomic_set(&slot->height, (int)frame.height);
+            queueSlot(rt, slot);
+        } else {
+            removeSlot(rt, slot);
+        }
+    }
+}
+
+static void stopRenderThread(RenderThread* rt)
+{
+    async_mutex_lock(&rt->mutex);
+    atomic_set(&rt->stopping, 1);
+    async_mutex_notify(&rt->mutex);
+    async_mutex_unlock(&rt->mutex);
+    async_thread_join(&rt->thread);
+    async_mutex_destruct(&rt->releaseMutex);
+    async_mutex_destruct(&rt->mutex);
+    free(rt);
+}
+
+/* ============================================================================================ */
+
+static void setRenderer(lua_State* L, LpuglBackend* backend, PuglView* view, int rendererIdx)
+{
+    RenderThread* rt = ((LpuglOpenglBackend*)backend)->renderThread;
+
+    const lpugl_glrenderer_capi* capi     = NULL;
+    lpugl_glrenderer*            renderer = NULL;
+    RenderSlot*                  newSlot  = NULL;
+    if (rendererIdx) {
+        int errorReason = 0;
+        capi     = lpugl_glrenderer_get_capi(L, rendererIdx, &errorReason);
+        renderer = capi ? capi->toRenderer(L, rendererIdx) : NULL;
+        if (!renderer) {
+            luaL_argerror(L, rendererIdx, errorReason == 1 ? "renderer C API version mismatch"
+                                                           : "renderer object expected");
+        }
+        if (!rt) {
+            lpugl_error(L, LPUGL_ERROR_ILLEGAL_STATE ": backend closed");
+        }
+        newSlot = calloc(1, sizeof(RenderSlot));
+        if (!newSlot) {
+            lpugl_error(L, LPUGL_ERROR_OUT_OF_MEMORY);
+        }
+    }
+    RenderSlot* slot = rt ? findSlot(rt, view) : NULL;
+    if (slot) {
+        removeSlot(rt, slot);
+    }
+    if (newSlot) {
+        // from now on the view's context is only used on the render thread
+        if (puglSetGlFrameFunc(view, requestFrame, rt) != PUGL_SUCCESS) {
+            free(newSlot);
+            lpugl_error(L, LPUGL_ERROR_FAILED_OPERATION ": cannot detach OpenGL context");
+        }
+        capi->retainRenderer(renderer);
+        newSlot->view     = view;
+        newSlot->renderer = renderer;
+        newSlot->capi     = capi;
+        newSlot->next     = rt->slots;
+        rt->slots         = newSlot;  // first frame is requested with the next exposure
+    } else if (slot) {
+        puglSetGlFrameFunc(view, NULL, NULL); // view is drawn on the world's thread again
+    }
+}
+
 /* ============================================================================================ */
 
 static void closeBackend(lua_State* L, int backendIdx)
@@ -53,6 +626,16 @@ static void closeBackend(lua_State* L, int backendIdx)
         lua_pop(L, 1);                                      /* -> */
     }
     udata->base.world = NULL;
+    if (udata->renderThread) {
+        // all views are closed, therefore no slots are left
+        stopRenderThread(udata->renderThread);
+        udata->renderThread = NULL;
+    }
+    if (udata->configCache) {
+        puglFreeGlConfigCache(udata->configCache);
+        udata->configCache = NULL;
+        udata->base.puglBackendData = NULL;
+    }
 }
 
 /* ============================================================================================ */
@@ -112,6 +695,24 @@ static int Lpugl_opengl_newBackend(lua_State* L)
     if (!worldUdata->world) {
         return lpugl_error(L, LPUGL_ERROR_ILLEGAL_STATE ": lpugl.world closed");
     }
+    bool renderThread = false;
+    if (!lua_isnoneornil(L, 2)) {
+        luaL_checktype(L, 2, LUA_TTABLE);
+        lua_pushnil(L);                 /* -> nil */
+        while (lua_next(L, 2)) {        /* -> key, value */
+            const char* key = (lua_type(L, -2) == LUA_TSTRING) ? lua_tostring(L, -2) : NULL;
+            if (key && strcmp(key, "renderThread") == 0) {
+                if (lua_type(L, -1) != LUA_TBOOLEAN) {
+                    return luaL_argerror(L, 2, lua_pushfstring(L, "boolean expected as 'renderThread' value, got %s",
+                                                               luaL_typename(L, -1)));
+                }
+                renderThread = lua_toboolean(L, -1);
+            } else {
+                return luaL_argerror(L, 2, lua_pushfstring(L, "unexpected table key '%s'", luaL_tolstring(L, -2, NULL)));
+            }
+            lua_pop(L, 1);              /* -> key */
+        }                               /* -> */
+    }
 
     LpuglOpenglBackend* udata = lua_newuserdata(L, sizeof(LpuglOpenglBackend));
     memset(udata, 0, sizeof(LpuglOpenglBackend));
@@ -119,7 +720,10 @@ static int Lpugl_opengl_newBackend(lua_State* L)
     udata->base.magic = LPUGL_BACKEND_MAGIC;
     strcpy(udata->base.versionId, "lpugl.backend-" LPUGL_PLATFORM_STRING "-" LPUGL_VERSION_STRING);
     udata->base.puglBackend       = puglGlBackend();
+    udata->configCache            = puglNewGlConfigCache();
+    udata->base.puglBackendData   = udata->configCache;
     udata->base.closeBackend      = closeBackend;
+    udata->base.newSnapshot       = newSnapshot;
 
     pushBackendMeta(L);      /* -> udata, meta */
     lua_setmetatable(L, -2); /* -> udata */
@@ -130,7 +734,29 @@ static int Lpugl_opengl_newBackend(lua_State* L)
     lua_pushvalue(L, 1);                                       /* -> udata, uservalue, world */
     lua_rawseti(L, -2, LPUGL_OPENGL_BACKEND_UV_WORLD);         /* -> udata, uservalue */
     lua_setuservalue(L, -2);                                   /* -> udata */
-    
+
+    if (renderThread) {
+#if !defined(LPUGL_USE_X11)
+        return lpugl_error(L, LPUGL_ERROR_FAILED_OPERATION ": render thread not supported on this platform");
+#endif
+        if (!worldUdata->world->threads) {
+            return lpugl_error(L, LPUGL_ERROR_ILLEGAL_STATE ": lpugl.initApplication(true) not called before creating lpugl.world");
+        }
+        RenderThread* rt = calloc(1, sizeof(RenderThread));
+        if (!rt) {
+            return lpugl_error(L, LPUGL_ERROR_OUT_OF_MEMORY);
+        }
+        async_mutex_init(&rt->mutex);
+        async_mutex_init(&rt->releaseMutex);
+        if (!async_thread_start(&rt->thread, renderThreadMain, rt)) {
+            async_mutex_destruct(&rt->releaseMutex);
+            async_mutex_destruct(&rt->mutex);
+            free(rt);
+            return lpugl_error(L, LPUGL_ERROR_FAILED_OPERATION ": cannot start render thread");
+        }
+        udata->renderThread     = rt;
+        udata->base.setRenderer = setRenderer;
+    }
     return 1;
 }
 
@@ -139,6 +765,27 @@ static int Lpugl_opengl_newBackend(lua_State* L)
 static int Lpugl_opengl_newWorld(lua_State* L)
 {
     luaL_checkstring(L, 1); /* for puglSetClassName */
+    bool renderThread = false;
+    if (!lua_isnoneornil(L, 2)) {
+        luaL_checktype(L, 2, LUA_TTABLE);
+        lua_newtable(L);                                         /* -> options */
+        lua_pushnil(L);                                          /* -> options, nil */
+        while (lua_next(L, 2)) {                                 /* -> options, key, value */
+            if (lua_type(L, -2) == LUA_TSTRING && strcmp(lua_tostring(L, -2), "renderThread") == 0) {
+                if (lua_type(L, -1) != LUA_TBOOLEAN) {
+                    return luaL_argerror(L, 2, lua_pushfstring(L, "boolean expected as 'renderThread' value, got %s",
+                                                               luaL_typename(L, -1)));
+                }
+                renderThread = lua_toboolean(L, -1);
+                lua_pop(L, 1);                                   /* -> options, key */
+            } else {
+                lua_pushvalue(L, -2);                            /* -> options, key, value, key */
+                lua_insert(L, -2);                               /* -> options, key, key, value */
+                lua_rawset(L, -4);                               /* -> options, key */
+            }
+        }                                                        /* -> options */
+        lua_replace(L, 2);                                       /* -> */
+    }
     int nargs = lua_gettop(L);
     bool loaded = false;
     if (lua_getglobal(L, "require") == LUA_TFUNCTION) {          /* -> require */
@@ -154,7 +801,12 @@ static int Lpugl_opengl_newWorld(lua_State* L)
                 lua_pushvalue(L, -2);                            /* -> lpugl, world, setDefaultBackend(), world */
                 lua_pushcfunction(L, Lpugl_opengl_newBackend);   /* -> lpugl, world, setDefaultBackend(), world, newBackend() */
                 lua_pushvalue(L, -2);                            /* -> lpugl, world, setDefaultBackend(), world, newBackend(), world */
-                lua_call(L, 1, 1);                               /* -> lpugl, world, setDefaultBackend(), world, backend */
+                if (renderThread) {
+                    lua_newtable(L);                             /* -> lpugl, world, setDefaultBackend(), world, newBackend(), world, options */
+                    lua_pushboolean(L, true);                    /* -> lpugl, world, setDefaultBackend(), world, newBackend(), world, options, true */
+                    lua_setfield(L, -2, "renderThread");         /* -> lpugl, world, setDefaultBackend(), world, newBackend(), world, options */
+                }
+                lua_call(L, renderThread ? 2 : 1, 1);            /* -> lpugl, world, setDefaultBackend(), world, backend */
                 lua_call(L, 2, 0);                               /* -> lpugl, world */
                 loaded = true;
             }
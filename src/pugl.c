@@ -11,6 +11,9 @@
 #elif defined(LPUGL_USE_X11)
     #include "pugl-repo/src/x11.c"
 
+#elif defined(LPUGL_USE_HEADLESS)
+    #include "pugl-repo/src/headless.c"
+
 #else
     #error missing platform definition
 #endif 
@@ -11,6 +11,10 @@
     #include "pugl-repo/src/x11_cairo.c"
     #include "pugl-repo/src/x11_stub.c"
 
+#elif defined(LPUGL_USE_HEADLESS)
+    #include "pugl-repo/src/headless_cairo.c"
+    #include "pugl-repo/src/headless_stub.c"
+
 #else
     #error missing platform definition
 #endif 
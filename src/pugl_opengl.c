@@ -11,6 +11,9 @@
     #include "pugl-repo/src/x11_gl.c"
     #include "pugl-repo/src/x11_stub.c"
 
+#elif defined(LPUGL_USE_HEADLESS)
+    #error OpenGL is not supported for headless platform
+
 #else
     #error missing platform definition
 #endif 
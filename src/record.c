@@ -0,0 +1,300 @@
+#include "base.h"
+
+#include "pugl/pugl.h"
+
+#include "record.h"
+#include "world.h"
+#include "view.h"
+#include "error.h"
+
+/* ============================================================================================ */
+
+typedef struct LpuglRecorder {
+    FILE*       file;
+    PuglWorld*  puglWorld;
+    double      startTime;
+    PuglView**  views;
+    int         viewCount;
+    int         viewCapacity;
+    bool        failed;
+} LpuglRecorder;
+
+/* ============================================================================================ */
+
+static void writeRecord(LpuglRecorder* rec, double time, int32_t viewIndex, int32_t type,
+                        const double* a)
+{
+    char record[LPUGL_RECORD_SIZE];
+    memcpy(record,      &time,      sizeof(double));
+    memcpy(record + 8,  &viewIndex, sizeof(int32_t));
+    memcpy(record + 12, &type,      sizeof(int32_t));
+    memcpy(record + 16, a,          4 * sizeof(double));
+
+    if (fwrite(record, LPUGL_RECORD_SIZE, 1, rec->file) != 1) {
+        rec->failed = true;
+    }
+}
+
+static void writeText(LpuglRecorder* rec, const char* text, size_t length)
+{
+    if (fwrite(text, length, 1, rec->file) != 1) {
+        rec->failed = true;
+    }
+}
+
+/* ============================================================================================ */
+
+static bool isKeyEvent(int type)
+{
+    return type == PUGL_KEY_PRESS || type == PUGL_KEY_RELEASE;
+}
+
+/* ============================================================================================ */
+
+static int getViewIndex(LpuglRecorder* rec, PuglView* view, double time)
+{
+    for (int i = 0; i < rec->viewCount; ++i) {
+        if (rec->views[i] == view) {
+            return i + 1;
+        }
+    }
+    if (rec->viewCount >= rec->viewCapacity) {
+        int        newCapacity = rec->viewCapacity > 0 ? 2 * rec->viewCapacity : 8;
+        PuglView** newViews    = realloc(rec->views, newCapacity * sizeof(PuglView*));
+        if (!newViews) {
+            return 0;
+        }
+        rec->views        = newViews;
+        rec->viewCapacity = newCapacity;
+    }
+    rec->views[rec->viewCount++] = view;
+    int viewIndex = rec->viewCount;
+
+    // view geometry at the time the view appears first in the record
+    PuglRect frame = puglGetFrame(view);
+    double   a[4]  = { frame.x, frame.y, frame.width, frame.height };
+    writeRecord(rec, time, viewIndex, PUGL_CONFIGURE, a);
+
+    return viewIndex;
+}
+
+/* ============================================================================================ */
+
+static void recordEvent(PuglView* view, const PuglEvent* event, void* userData)
+{
+    LpuglRecorder* rec = userData;
+    double         a[4];
+
+    if (rec->failed || !lpugl_view_get_injected_args(event, a)) {
+        return;
+    }
+    double time      = puglGetTime(rec->puglWorld) - rec->startTime;
+    int    viewIndex = getViewIndex(rec, view, time);
+    if (viewIndex > 0) {
+        size_t textLength = 0;
+        if (isKeyEvent(event->type) && event->key.inputLength <= LPUGL_RECORD_MAX_TEXT) {
+            textLength = event->key.inputLength;
+            a[2]       = (double)textLength;
+        }
+        writeRecord(rec, time, viewIndex, event->type, a);
+        if (textLength > 0 && !rec->failed) {
+            writeText(rec, textLength > 8 ? event->key.input.ptr : event->key.input.data, 
+                      textLength);
+        }
+    }
+}
+
+/* ============================================================================================ */
+
+int lpugl_record_start(lua_State* L, LpuglWorld* world, const char* path)
+{
+    if (world->recorder) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "already recording");
+    }
+    LpuglRecorder* rec = calloc(1, sizeof(LpuglRecorder));
+    if (!rec) {
+        return lpugl_ERROR_OUT_OF_MEMORY(L);
+    }
+    rec->file = fopen(path, "wb");
+    if (!rec->file) {
+        free(rec);
+        lua_pushfstring(L, "cannot open file '%s': %s", path, strerror(errno));
+        return lpugl_ERROR_FAILED_OPERATION_ex(L, lua_tostring(L, -1));
+    }
+    char    header[LPUGL_RECORD_HEADER_SIZE];
+    int32_t version    = LPUGL_RECORD_VERSION;
+    int32_t recordSize = LPUGL_RECORD_SIZE;
+    memcpy(header,      LPUGL_RECORD_MAGIC, 8);
+    memcpy(header + 8,  &version,           sizeof(int32_t));
+    memcpy(header + 12, &recordSize,        sizeof(int32_t));
+    if (fwrite(header, LPUGL_RECORD_HEADER_SIZE, 1, rec->file) != 1) {
+        lua_pushfstring(L, "cannot write file '%s': %s", path, strerror(errno));
+        fclose(rec->file);
+        free(rec);
+        return lpugl_ERROR_FAILED_OPERATION_ex(L, lua_tostring(L, -1));
+    }
+
+    rec->puglWorld = world->puglWorld;
+    rec->startTime = puglGetTime(world->puglWorld);
+    world->recorder = rec;
+    puglSetRecordFunc(world->puglWorld, recordEvent, rec);
+    return 0;
+}
+
+/* ============================================================================================ */
+
+void lpugl_record_stop(LpuglWorld* world)
+{
+    LpuglRecorder* rec = world->recorder;
+    if (rec) {
+        if (world->puglWorld) {
+            puglSetRecordFunc(world->puglWorld, NULL, NULL);
+        }
+        fclose(rec->file);
+        free(rec->views);
+        free(rec);
+        world->recorder = NULL;
+    }
+}
+
+/* ============================================================================================ */
+
+void lpugl_record_forget_view(LpuglWorld* world, PuglView* view)
+{
+    LpuglRecorder* rec = world->recorder;
+    for (int i = 0; i < rec->viewCount; ++i) {
+        if (rec->views[i] == view) {
+            rec->views[i] = NULL; // keep indices of other views
+        }
+    }
+}
+
+/* ============================================================================================ */
+
+int lpugl_record_replay(lua_State* L, LpuglWorld* world, int pathIdx, int viewsIdx, bool realTime)
+{
+    const char* path = luaL_checkstring(L, pathIdx);
+    bool viewsTable  = lua_istable(L, viewsIdx);
+    if (!viewsTable && !lpugl_view_get_pugl_view(L, viewsIdx)) {
+        return luaL_argerror(L, viewsIdx, "view or list of views expected");
+    }
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        lua_pushfstring(L, "cannot open file '%s': %s", path, strerror(errno));
+        return lpugl_ERROR_FAILED_OPERATION_ex(L, lua_tostring(L, -1));
+    }
+    char    header[LPUGL_RECORD_HEADER_SIZE];
+    int32_t version    = 0;
+    int32_t recordSize = 0;
+    if (fread(header, LPUGL_RECORD_HEADER_SIZE, 1, file) == 1) {
+        memcpy(&version,    header + 8,  sizeof(int32_t));
+        memcpy(&recordSize, header + 12, sizeof(int32_t));
+    }
+    if (   memcmp(header, LPUGL_RECORD_MAGIC, 8) != 0
+        || version != LPUGL_RECORD_VERSION || recordSize != LPUGL_RECORD_SIZE)
+    {
+        fclose(file);
+        lua_pushfstring(L, "invalid record file '%s'", path);
+        return lpugl_ERROR_FAILED_OPERATION_ex(L, lua_tostring(L, -1));
+    }
+
+    bool wasInCallback = world->inCallback;
+    world->inCallback = true;
+
+    lua_Integer count     = 0;
+    double      startTime = puglGetTime(world->puglWorld);
+    double      lastTime  = 0;
+    int         failure   = 0;  // 1: invalid file, 2: out of memory
+    char        record[LPUGL_RECORD_SIZE];
+
+    while (fread(record, LPUGL_RECORD_SIZE, 1, file) == 1) {
+        if (world->weakWorldRef == LUA_REFNIL) {
+            break; // world was closed during event handling
+        }
+        double  time;
+        int32_t viewIndex;
+        int32_t type;
+        double  a[4];
+        memcpy(&time,      record,      sizeof(double));
+        memcpy(&viewIndex, record + 8,  sizeof(int32_t));
+        memcpy(&type,      record + 12, sizeof(int32_t));
+        memcpy(a,          record + 16, sizeof(a));
+
+        size_t textLength = 0;
+        char*  text       = NULL;
+        char   textData[8];
+        if (isKeyEvent(type) && a[2] != 0) {
+            if (!(a[2] > 0 && a[2] <= LPUGL_RECORD_MAX_TEXT && a[2] == (size_t)a[2])) {
+                failure = 1;
+                break;
+            }
+            textLength = (size_t)a[2];
+            text       = (textLength > 8) ? malloc(textLength) : textData;
+            if (!text) {
+                failure = 2;
+                break;
+            }
+            if (fread(text, textLength, 1, file) != 1) {
+                if (text != textData) free(text);
+                failure = 1;
+                break;
+            }
+        }
+        if (realTime) {
+            double timeout;
+            while ((timeout = startTime + time - puglGetTime(world->puglWorld)) > 0
+                   && world->weakWorldRef != LUA_REFNIL)
+            {
+                puglUpdate(world->puglWorld, timeout);
+            }
+        } else if (time != lastTime) {
+            puglUpdate(world->puglWorld, 0);
+        }
+        lastTime = time;
+        if (world->weakWorldRef == LUA_REFNIL) {
+            if (text != textData) free(text);
+            break;
+        }
+        PuglView* view = NULL;
+        if (viewsTable) {
+            lua_rawgeti(L, viewsIdx, viewIndex);                /* -> view */
+            view = lpugl_view_get_pugl_view(L, -1);
+            lua_pop(L, 1);                                      /* -> */
+        } else if (viewIndex == 1) {
+            view = lpugl_view_get_pugl_view(L, viewsIdx);
+        }
+        PuglInjectedEvent e;
+        e.view = view;
+        if (view && lpugl_view_init_injected_event(view, type, a, &e.event)) {
+            if (textLength > 8) {
+                e.event.key.input.ptr = text; // freed by Pugl after dispatching
+            } else if (textLength > 0) {
+                memcpy(e.event.key.input.data, text, textLength);
+            }
+            if (textLength > 0) {
+                e.event.key.inputLength = textLength;
+            }
+            puglInjectEvents(world->puglWorld, &e, 1); 
+            ++count;
+        } else if (text != textData) {
+            free(text); // records for closed or missing views are skipped
+        }
+    }
+    fclose(file);
+
+    world->inCallback = wasInCallback;
+    if (!wasInCallback && world->mustClosePugl) {
+        lpugl_world_close_pugl(world);
+    }
+    if (failure == 2) {
+        return lpugl_ERROR_OUT_OF_MEMORY(L);
+    }
+    if (failure == 1) {
+        lua_pushfstring(L, "invalid record file '%s'", path);
+        return lpugl_ERROR_FAILED_OPERATION_ex(L, lua_tostring(L, -1));
+    }
+    lua_pushinteger(L, count);
+    return 1;
+}
+
+/* ============================================================================================ */
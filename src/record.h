@@ -0,0 +1,40 @@
+#ifndef LPUGL_RECORD_H
+#define LPUGL_RECORD_H
+
+#include "base.h"
+
+#include "pugl/pugl.h"
+
+struct LpuglWorld;
+
+/* ============================================================================================ */
+
+/*
+ * Record file format (native byte order):
+ *
+ *   header: "LPUGLREC", int32 version, int32 record size
+ *   record: double time, int32 view index, int32 event type, 4 doubles event data
+ *
+ * The record without time has the same layout as the records for world:injectEvents().
+ * For key events the third double is the length of the text input, the UTF-8 bytes
+ * of the text input follow directly after the record.
+ */
+#define LPUGL_RECORD_MAGIC        "LPUGLREC"
+#define LPUGL_RECORD_VERSION      2
+#define LPUGL_RECORD_HEADER_SIZE  16
+#define LPUGL_RECORD_SIZE         48
+#define LPUGL_RECORD_MAX_TEXT     4096
+
+/* ============================================================================================ */
+
+int lpugl_record_start(lua_State* L, struct LpuglWorld* world, const char* path);
+
+void lpugl_record_stop(struct LpuglWorld* world);
+
+void lpugl_record_forget_view(struct LpuglWorld* world, PuglView* view);
+
+int lpugl_record_replay(lua_State* L, struct LpuglWorld* world, int pathIdx, int viewsIdx, bool realTime);
+
+/* ============================================================================================ */
+
+#endif /* LPUGL_RECORD_H */
@@ -0,0 +1,230 @@
+#include "base.h"
+
+#include "pugl/pugl.h"
+
+#include "snapshot.h"
+#include "backend.h"
+#include "view.h"
+#include "error.h"
+
+/* ============================================================================================ */
+
+#define LPUGL_SNAPSHOT_UV_VIEW 1
+
+static const char* const LPUGL_SNAPSHOT_CLASS_NAME = "lpugl.snapshot";
+
+/* ============================================================================================ */
+
+typedef struct SnapshotUserData {
+    LpuglSnapshot* snapshot;
+} SnapshotUserData;
+
+/* ============================================================================================ */
+
+static void setupSnapshotMeta(lua_State* L);
+
+static int pushSnapshotMeta(lua_State* L)
+{
+    if (luaL_newmetatable(L, LPUGL_SNAPSHOT_CLASS_NAME)) {
+        setupSnapshotMeta(L);
+    }
+    return 1;
+}
+
+/* ============================================================================================ */
+
+int lpugl_snapshot_new(lua_State* L, int viewIdx, LpuglSnapshot* snapshot)
+{
+    SnapshotUserData* udata = lua_newuserdata(L, sizeof(SnapshotUserData)); /* -> udata */
+    udata->snapshot = snapshot;
+    pushSnapshotMeta(L);                                                    /* -> udata, meta */
+    lua_setmetatable(L, -2);                                                /* -> udata */
+    lua_newtable(L);                                                        /* -> udata, uservalue */
+    lua_pushvalue(L, viewIdx);                                              /* -> udata, uservalue, view */
+    lua_rawseti(L, -2, LPUGL_SNAPSHOT_UV_VIEW);                             /* -> udata, uservalue */
+    lua_setuservalue(L, -2);                                                /* -> udata */
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static PuglView* getView(lua_State* L, int udataIdx, bool* drawing)
+{
+    *drawing = false;
+    PuglView* view = NULL;
+    if (lua_getuservalue(L, udataIdx) == LUA_TTABLE) {  /* -> uservalue */
+        lua_rawgeti(L, -1, LPUGL_SNAPSHOT_UV_VIEW);     /* -> uservalue, view */
+        view = lpugl_view_get_pugl_view(L, -1);
+        *drawing = view && lpugl_view_is_drawing(L, -1);
+        lua_pop(L, 1);                                  /* -> uservalue */
+    }                                                   /* -> ? */
+    lua_pop(L, 1);                                      /* -> */
+    return view;
+}
+
+/* ============================================================================================ */
+
+static LpuglSnapshot* checkSnapshot(lua_State* L)
+{
+    SnapshotUserData* udata = luaL_checkudata(L, 1, LPUGL_SNAPSHOT_CLASS_NAME);
+    if (!udata->snapshot) {
+        lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    return udata->snapshot;
+}
+
+/* ============================================================================================ */
+
+static LpuglSnapshot* checkMappedSnapshot(lua_State* L)
+{
+    LpuglSnapshot* snapshot = checkSnapshot(L);
+    if (!snapshot->data) {
+        bool      drawing;
+        PuglView* view = getView(L, 1, &drawing);
+        if (!view) {
+            lpugl_ERROR_ILLEGAL_STATE(L, "view closed");
+        }
+        if (!snapshot->map(snapshot, view, drawing)) {
+            lpugl_ERROR_FAILED_OPERATION(L);
+        }
+    }
+    return snapshot;
+}
+
+/* ============================================================================================ */
+
+static int Snapshot_close(lua_State* L)
+{
+    SnapshotUserData* udata = luaL_checkudata(L, 1, LPUGL_SNAPSHOT_CLASS_NAME);
+    if (udata->snapshot) {
+        bool      drawing;
+        PuglView* view = getView(L, 1, &drawing);
+        udata->snapshot->release(udata->snapshot, view, drawing);
+        udata->snapshot = NULL;
+    }
+    return 0;
+}
+
+/* ============================================================================================ */
+
+static int Snapshot_isClosed(lua_State* L)
+{
+    SnapshotUserData* udata = luaL_checkudata(L, 1, LPUGL_SNAPSHOT_CLASS_NAME);
+    lua_pushboolean(L, udata->snapshot == NULL);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int Snapshot_toString(lua_State* L)
+{
+    SnapshotUserData* udata = luaL_checkudata(L, 1, LPUGL_SNAPSHOT_CLASS_NAME);
+    lua_pushfstring(L, "%s: %p", LPUGL_SNAPSHOT_CLASS_NAME, udata);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int Snapshot_getSize(lua_State* L)
+{
+    LpuglSnapshot* snapshot = checkSnapshot(L);
+    lua_pushinteger(L, snapshot->width);
+    lua_pushinteger(L, snapshot->height);
+    return 2;
+}
+
+/* ============================================================================================ */
+
+static int Snapshot_getStride(lua_State* L)
+{
+    LpuglSnapshot* snapshot = checkSnapshot(L);
+    lua_pushinteger(L, snapshot->stride);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int Snapshot_getFormat(lua_State* L)
+{
+    LpuglSnapshot* snapshot = checkSnapshot(L);
+    lua_pushstring(L, snapshot->format);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int Snapshot_isReady(lua_State* L)
+{
+    LpuglSnapshot* snapshot = checkSnapshot(L);
+    bool ready = (snapshot->data != NULL);
+    if (!ready) {
+        bool      drawing;
+        PuglView* view = getView(L, 1, &drawing);
+        ready = view && snapshot->isReady(snapshot, view, drawing);
+    }
+    lua_pushboolean(L, ready);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int Snapshot_getPointer(lua_State* L)
+{
+    LpuglSnapshot* snapshot = checkMappedSnapshot(L);
+    lua_pushlightuserdata(L, snapshot->data);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int Snapshot_getData(lua_State* L)
+{
+    LpuglSnapshot* snapshot = checkMappedSnapshot(L);
+    lua_pushlstring(L, snapshot->data, (size_t)snapshot->stride * snapshot->height);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static const luaL_Reg SnapshotMethods[] = 
+{
+    { "close",        Snapshot_close      },
+    { "isClosed",     Snapshot_isClosed   },
+    { "getSize",      Snapshot_getSize    },
+    { "getStride",    Snapshot_getStride  },
+    { "getFormat",    Snapshot_getFormat  },
+    { "isReady",      Snapshot_isReady    },
+    { "getPointer",   Snapshot_getPointer },
+    { "getData",      Snapshot_getData    },
+    { NULL,           NULL } /* sentinel */
+};
+
+static const luaL_Reg SnapshotMetaMethods[] = 
+{
+    { "__tostring",   Snapshot_toString },
+    { "__gc",         Snapshot_close    },
+    { NULL,           NULL              } /* sentinel */
+};
+
+static void setupSnapshotMeta(lua_State* L)
+{
+    lua_pushstring(L, LPUGL_SNAPSHOT_CLASS_NAME);
+    lua_setfield(L, -2, "__metatable");
+
+    luaL_setfuncs(L, SnapshotMetaMethods, 0);
+    
+    lua_newtable(L);  /* SnapshotClass */
+        luaL_setfuncs(L, SnapshotMethods, 0);
+    lua_setfield (L, -2, "__index");
+}
+
+int lpugl_snapshot_init_module(lua_State* L, int module)
+{
+    if (luaL_newmetatable(L, LPUGL_SNAPSHOT_CLASS_NAME)) {
+        setupSnapshotMeta(L);
+    }
+    lua_pop(L, 1);
+    return 0;
+}
+
+/* ============================================================================================ */
@@ -0,0 +1,16 @@
+#ifndef LPUGL_SNAPSHOT_H
+#define LPUGL_SNAPSHOT_H
+
+#include "base.h"
+
+struct LpuglSnapshot;
+
+/* ============================================================================================ */
+
+int lpugl_snapshot_init_module(lua_State* L, int module);
+
+int lpugl_snapshot_new(lua_State* L, int viewIdx, struct LpuglSnapshot* snapshot);
+
+/* ============================================================================================ */
+
+#endif /* LPUGL_SNAPSHOT_H */
@@ -0,0 +1,499 @@
+#include "init.h"
+
+#if defined(LPUGL_USE_X11)
+    #include <poll.h>
+    #include <sys/select.h>
+#endif
+
+#include "base.h"
+
+#include "task.h"
+#include "world.h"
+#include "error.h"
+
+/* ============================================================================================ */
+
+//  state of tasks that were closed while running or while waiting to be resumed
+#define LPUGL_TASK_CLOSED  -1
+
+/*
+ * Registry key for the table with task threads as weak keys and the tasks as
+ * lightuserdata values, used for finding the task of a running coroutine.
+ */
+static const char taskThreadsKey = 0;
+
+/* ============================================================================================ */
+
+static int resumeThread(lua_State* co, lua_State* L, int nargs, int* nres)
+{
+#if LUA_VERSION_NUM >= 504
+    return lua_resume(co, L, nargs, nres);
+#else
+    int rc = lua_resume(co, L, nargs);
+    *nres = lua_gettop(co);
+    return rc;
+#endif
+}
+
+/* ============================================================================================ */
+
+static LpuglTask* checkCurrentTask(lua_State* L)
+{
+    lua_rawgetp(L, LUA_REGISTRYINDEX, &taskThreadsKey);         /* -> threads */
+    lua_pushthread(L);                                          /* -> threads, thread */
+    lua_rawget(L, -2);                                          /* -> threads, task */
+    LpuglTask* task = lua_touserdata(L, -1);
+    lua_pop(L, 2);                                              /* -> */
+    if (!task || task->state != LPUGL_TASK_RUNNING) {
+        lpugl_ERROR_ILLEGAL_STATE(L, "not running in task");
+    }
+    return task;
+}
+
+/* ============================================================================================ */
+
+static void insertSleepingTask(LpuglWorld* world, LpuglTask* task)
+{
+    LpuglTask** p = &world->sleepingTasks;
+    while (*p && (*p)->time <= task->time) {
+        p = &(*p)->next;
+    }
+    task->next = *p;
+    *p = task;
+    if (world->sleepingTasks == task) {
+        lpugl_world_schedule_process(world);
+    }
+}
+
+static void appendTask(LpuglTask** list, LpuglTask* task)
+{
+    while (*list) {
+        list = &(*list)->next;
+    }
+    task->next = NULL;
+    *list = task;
+}
+
+/*
+ * Links a task that has yielded into the list for the state that was set by the
+ * yielding function. Tasks yielding via coroutine.yield() are resumed in the next
+ * processing cycle.
+ */
+static void scheduleTask(LpuglWorld* world, LpuglTask* task)
+{
+    double now = puglGetTime(world->puglWorld);
+    switch (task->state) {
+        case LPUGL_TASK_RUNNING: {
+            task->state = LPUGL_TASK_SLEEP;
+            task->time  = now;
+            insertSleepingTask(world, task);
+            break;
+        }
+        case LPUGL_TASK_SLEEP: {
+            task->time = now + task->time; // yielding function has set relative time
+            insertSleepingTask(world, task);
+            break;
+        }
+        case LPUGL_TASK_EVENT: {
+            appendTask(&world->eventTasks, task);
+            break;
+        }
+        case LPUGL_TASK_FD: {
+            puglWatchFd(world->puglWorld, task->fd, true);
+            appendTask(&world->fdTasks, task);
+            break;
+        }
+    }
+}
+
+/* ============================================================================================ */
+
+static void removeTask(lua_State* L, int worldUservalueIdx, LpuglTask* task, int threadIdx)
+{
+    lua_rawgetp(L, LUA_REGISTRYINDEX, &taskThreadsKey);         /* -> threads */
+    lua_pushvalue(L, threadIdx);                                /* -> threads, thread */
+    lua_pushnil(L);                                             /* -> threads, thread, nil */
+    lua_rawset(L, -3);                                          /* -> threads */
+    lua_pop(L, 1);                                              /* -> */
+    if (lua_rawgeti(L, worldUservalueIdx, LPUGL_WORLD_UV_TASKS) == LUA_TTABLE) { /* -> tasks */
+        lua_pushnil(L);                                         /* -> tasks, nil */
+        lua_rawsetp(L, -2, task);                               /* -> tasks */
+    }
+    lua_pop(L, 1);                                              /* -> */
+    free(task);
+}
+
+/*
+ * Resumes the task with the nargs values on top of the stack. Must be called on
+ * the world's thread with the world's uservalue at the given index.
+ */
+static void resumeTask(lua_State* L, LpuglWorld* world, int worldUservalueIdx, LpuglTask* task,
+                       int nargs, int msgh)
+{                                                                       /* -> args */
+    if (task->state == LPUGL_TASK_CLOSED) {
+        lua_pop(L, nargs);                                              /* -> */
+        free(task);
+        return;
+    }
+    lua_rawgeti(L, worldUservalueIdx, LPUGL_WORLD_UV_TASKS);            /* -> args, tasks */
+    lua_rawgetp(L, -1, task);                                           /* -> args, tasks, thread */
+    lua_replace(L, -2);                                                 /* -> args, thread */
+    lua_insert(L, -(nargs + 1));                                        /* -> thread, args */
+    int threadIdx = lua_gettop(L) - nargs;
+    lua_State* co = lua_tothread(L, threadIdx);
+
+    lua_checkstack(co, nargs + LUA_MINSTACK);
+    lua_xmove(L, co, nargs);                                            /* -> thread */
+    nargs += task->startArgs;
+    task->startArgs = 0;
+    task->state = LPUGL_TASK_RUNNING;
+    int nres;
+    int rc = resumeThread(co, L, nargs, &nres);
+
+    if (task->state == LPUGL_TASK_CLOSED) {
+        free(task);                                                     /* world was closed by task */
+    }
+    else if (rc == LUA_YIELD) {
+        lua_pop(co, nres);
+        scheduleTask(world, task);
+    }
+    else if (rc == LUA_OK) {
+        removeTask(L, worldUservalueIdx, task, threadIdx);
+    }
+    else {
+        lua_newtable(L);                                                /* -> thread, error */
+        lua_xmove(co, L, 1);                                            /* -> thread, error, errobj */
+        int errobj = lua_gettop(L);
+        const char* msg = lua_tostring(L, errobj);
+        if (!msg) {
+            if (luaL_callmeta(L, errobj, "__tostring") && lua_type(L, -1) == LUA_TSTRING) {
+                msg = lua_tostring(L, -1);                              /* -> thread, error, errobj, msg */
+            } else {
+                msg = lua_pushfstring(L, "(error object is a %s value)",/* -> thread, error, errobj, ..., msg */
+                                         luaL_typename(L, errobj));
+            }
+        }
+        luaL_traceback(L, co, msg, 0);                                  /* -> thread, error, errobj, ..., traceback */
+        lua_rawseti(L, errobj - 1, 1);                                  /* -> thread, error, errobj, ... */
+        lua_settop(L, errobj);                                          /* -> thread, error, errobj */
+        lua_rawseti(L, errobj - 1, 2);                                  /* -> thread, error */
+        removeTask(L, worldUservalueIdx, task, threadIdx);
+        lpugl_world_handle_error(L, worldUservalueIdx, msgh);           /* -> thread */
+    }
+    lua_pop(L, 1);                                                      /* -> */
+}
+
+/* ============================================================================================ */
+
+int lpugl_task_spawn(lua_State* L, LpuglWorld* world, int worldIdx, int funcIdx)
+{
+    int nargs = lua_gettop(L) - funcIdx;
+    LpuglTask* task = calloc(1, sizeof(LpuglTask));
+    if (!task) {
+        return lpugl_ERROR_OUT_OF_MEMORY(L);
+    }
+    lua_getuservalue(L, worldIdx);                                      /* -> uservalue */
+    if (lua_rawgeti(L, -1, LPUGL_WORLD_UV_TASKS) != LUA_TTABLE) {       /* -> uservalue, ? */
+        lua_pop(L, 1);                                                  /* -> uservalue */
+        lua_newtable(L);                                                /* -> uservalue, tasks */
+        lua_pushvalue(L, -1);                                           /* -> uservalue, tasks, tasks */
+        lua_rawseti(L, -3, LPUGL_WORLD_UV_TASKS);                       /* -> uservalue, tasks */
+    }
+    lua_State* co = lua_newthread(L);                                   /* -> uservalue, tasks, thread */
+    lua_pushvalue(L, -1);                                               /* -> uservalue, tasks, thread, thread */
+    lua_rawsetp(L, -3, task);                                           /* -> uservalue, tasks, thread */
+    lua_rawgetp(L, LUA_REGISTRYINDEX, &taskThreadsKey);                 /* -> uservalue, tasks, thread, threads */
+    lua_pushvalue(L, -2);                                               /* -> uservalue, tasks, thread, threads, thread */
+    lua_pushlightuserdata(L, task);                                     /* -> uservalue, tasks, thread, threads, thread, task */
+    lua_rawset(L, -3);                                                  /* -> uservalue, tasks, thread, threads */
+    lua_pop(L, 1);                                                      /* -> uservalue, tasks, thread */
+
+    lua_checkstack(co, nargs + 1 + LUA_MINSTACK);
+    for (int i = 0; i <= nargs; ++i) {
+        lua_pushvalue(L, funcIdx + i);
+    }                                                                   /* -> uservalue, tasks, thread, func, args */
+    lua_xmove(L, co, nargs + 1);                                        /* -> uservalue, tasks, thread */
+
+    task->state     = LPUGL_TASK_SLEEP;
+    task->time      = puglGetTime(world->puglWorld);
+    task->startArgs = nargs;
+    insertSleepingTask(world, task);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+int lpugl_task_sleep(lua_State* L, int arg)
+{
+    double seconds = luaL_optnumber(L, arg, 0);
+    LpuglTask* task = checkCurrentTask(L);
+    task->state = LPUGL_TASK_SLEEP;
+    task->time  = (seconds > 0) ? seconds : 0;
+    return lua_yield(L, 0);
+}
+
+int lpugl_task_wait_event(lua_State* L, int arg)
+{
+    const void* view = luaL_checkudata(L, arg, "lpugl.view");
+    size_t len = 0;
+    const char* eventName = luaL_optlstring(L, arg + 1, "", &len);
+    luaL_argcheck(L, len < sizeof(((LpuglTask*)NULL)->eventName), arg + 1, "invalid event type");
+    LpuglTask* task = checkCurrentTask(L);
+    task->state = LPUGL_TASK_EVENT;
+    task->view  = view;
+    memcpy(task->eventName, eventName, len + 1);
+    return lua_yield(L, 0);
+}
+
+int lpugl_task_wait_fd(lua_State* L, int arg)
+{
+    lua_Integer fd = luaL_checkinteger(L, arg);
+#if defined(LPUGL_USE_X11)
+    luaL_argcheck(L, 0 <= fd && fd < FD_SETSIZE, arg, "invalid file descriptor");
+    LpuglTask* task = checkCurrentTask(L);
+    task->state = LPUGL_TASK_FD;
+    task->fd    = (int)fd;
+    return lua_yield(L, 0);
+#else
+    (void)fd;
+    return lpugl_ERROR_FAILED_OPERATION_ex(L, "waiting for file descriptors is not supported on this platform");
+#endif
+}
+
+/* ============================================================================================ */
+
+double lpugl_task_next_time(LpuglWorld* world)
+{
+    return world->sleepingTasks ? world->sleepingTasks->time : -1;
+}
+
+/* ============================================================================================ */
+
+#if defined(LPUGL_USE_X11)
+/*
+ * Takes the tasks whose file descriptors are readable, stops watching file
+ * descriptors without remaining tasks.
+ */
+static LpuglTask* takeReadableFdTasks(LpuglWorld* world)
+{
+    size_t n = 0;
+    for (LpuglTask* t = world->fdTasks; t; t = t->next) {
+        n += 1;
+    }
+    struct pollfd* fds = malloc(n * sizeof(struct pollfd));
+    if (!fds) {
+        return NULL;
+    }
+    n = 0;
+    for (LpuglTask* t = world->fdTasks; t; t = t->next) {
+        fds[n].fd      = t->fd;
+        fds[n].events  = POLLIN;
+        fds[n].revents = 0;
+        n += 1;
+    }
+    LpuglTask*  rslt  = NULL;
+    LpuglTask** rlast = &rslt;
+    if (poll(fds, n, 0) > 0) {
+        LpuglTask** p = &world->fdTasks;
+        n = 0;
+        while (*p) {
+            LpuglTask* t = *p;
+            if (fds[n++].revents) {
+                *p = t->next;
+                t->next = NULL;
+                *rlast = t;
+                rlast = &t->next;
+            } else {
+                p = &t->next;
+            }
+        }
+    }
+    free(fds);
+    for (LpuglTask* t = rslt; t; t = t->next) {
+        bool stillWatched = false;
+        for (LpuglTask* w = world->fdTasks; w && !stillWatched; w = w->next) {
+            stillWatched = (w->fd == t->fd);
+        }
+        if (!stillWatched) {
+            puglWatchFd(world->puglWorld, t->fd, false);
+        }
+    }
+    return rslt;
+}
+#endif
+
+/*
+ * Resumes all tasks whose sleeping time has elapsed or whose file descriptors are
+ * readable. Must be called on the world's thread with the world's uservalue at the
+ * given index.
+ */
+void lpugl_task_resume_all(lua_State* L, LpuglWorld* world, int worldUservalueIdx, int msgh)
+{
+    double now = puglGetTime(world->puglWorld);
+
+    // tasks that are scheduled while resuming are resumed in the next cycle
+    LpuglTask*  ready = NULL;
+    LpuglTask** last  = &ready;
+    while (world->sleepingTasks && world->sleepingTasks->time <= now) {
+        LpuglTask* t = world->sleepingTasks;
+        world->sleepingTasks = t->next;
+        t->state = LPUGL_TASK_RUNNING;
+        t->next  = NULL;
+        *last    = t;
+        last     = &t->next;
+    }
+#if defined(LPUGL_USE_X11)
+    LpuglTask* readable = world->fdTasks ? takeReadableFdTasks(world) : NULL;
+    for (LpuglTask* t = readable; t; t = t->next) {
+        t->state = LPUGL_TASK_RUNNING;
+    }
+#endif
+    lua_checkstack(L, LUA_MINSTACK);
+    while (ready) {
+        LpuglTask* t = ready;
+        ready = t->next;
+        resumeTask(L, world, worldUservalueIdx, t, 0, msgh);
+    }
+#if defined(LPUGL_USE_X11)
+    while (readable) {
+        LpuglTask* t = readable;
+        readable = t->next;
+        lua_pushboolean(L, true);
+        resumeTask(L, world, worldUservalueIdx, t, 1, msgh);
+    }
+#endif
+}
+
+/* ============================================================================================ */
+
+/*
+ * Resumes all tasks that are waiting for the event. The event name and the event
+ * parameters are the values 1..nargs in the table at argsIdx.
+ */
+void lpugl_task_deliver_event(lua_State* L, LpuglWorld* world, const void* view,
+                              const char* eventName, int argsIdx, int nargs)
+{
+    LpuglTask*  ready = NULL;
+    LpuglTask** last  = &ready;
+    LpuglTask** p     = &world->eventTasks;
+    while (*p) {
+        LpuglTask* t = *p;
+        if (t->view == view && (!t->eventName[0] || strcmp(t->eventName, eventName) == 0)) {
+            *p = t->next;
+            t->state = LPUGL_TASK_RUNNING;
+            t->next  = NULL;
+            *last    = t;
+            last     = &t->next;
+        } else {
+            p = &t->next;
+        }
+    }
+    if (!ready) {
+        return;
+    }
+    bool wasInCallback = world->inCallback;
+    world->inCallback = true;
+
+    int oldTop = lua_gettop(L);
+    lua_checkstack(L, nargs + LUA_MINSTACK);
+    lua_pushcfunction(L, lpugl_world_errormsghandler);                  /* -> msgh */
+    int msgh = lua_gettop(L);
+    if (   lua_rawgeti(L, LUA_REGISTRYINDEX, world->weakWorldRef) != LUA_TTABLE /* -> msgh, weakWorld */
+        || lua_rawgeti(L, -1, 0) != LUA_TUSERDATA                               /* -> msgh, weakWorld, worldUdata */
+        || lua_getuservalue(L, -1) != LUA_TTABLE)                               /* -> msgh, weakWorld, worldUdata, worldUservalue */
+    {
+        fprintf(stderr, "lpugl: internal error in task.c:%d\n", __LINE__);
+        abort();
+    }
+    int worldUservalue = lua_gettop(L);
+    while (ready) {
+        LpuglTask* t = ready;
+        ready = t->next;
+        for (int i = 1; i <= nargs; ++i) {
+            lua_rawgeti(L, argsIdx, i);                                 /* -> ..., args */
+        }
+        resumeTask(L, world, worldUservalue, t, nargs, msgh);
+    }
+    lua_settop(L, oldTop);
+
+    world->inCallback = wasInCallback;
+    if (!wasInCallback && world->mustClosePugl) {
+        lpugl_world_close_pugl(world);
+    }
+}
+
+/* ============================================================================================ */
+
+/*
+ * Tasks waiting for events of a closed view are resumed without values.
+ */
+void lpugl_task_view_closed(LpuglWorld* world, const void* view)
+{
+    LpuglTask** p = &world->eventTasks;
+    while (*p) {
+        LpuglTask* t = *p;
+        if (t->view == view) {
+            *p = t->next;
+            t->state = LPUGL_TASK_SLEEP;
+            t->time  = 0;
+            t->view  = NULL;
+            insertSleepingTask(world, t);
+        } else {
+            p = &t->next;
+        }
+    }
+}
+
+/* ============================================================================================ */
+
+void lpugl_task_close_all(lua_State* L, LpuglWorld* world, int worldUservalueIdx)
+{
+    if (world->puglWorld) {
+        for (LpuglTask* t = world->fdTasks; t; t = t->next) {
+            puglWatchFd(world->puglWorld, t->fd, false);
+        }
+    }
+    world->sleepingTasks = NULL;
+    world->eventTasks    = NULL;
+    world->fdTasks       = NULL;
+
+    if (lua_rawgeti(L, worldUservalueIdx, LPUGL_WORLD_UV_TASKS) == LUA_TTABLE) { /* -> tasks */
+        lua_rawgetp(L, LUA_REGISTRYINDEX, &taskThreadsKey);             /* -> tasks, threads */
+        lua_pushnil(L);                                                 /* -> tasks, threads, nil */
+        while (lua_next(L, -3)) {                                       /* -> tasks, threads, task, thread */
+            LpuglTask* t = lua_touserdata(L, -2);
+            lua_pushnil(L);                                             /* -> tasks, threads, task, thread, nil */
+            lua_rawset(L, -4);                                          /* -> tasks, threads, task */
+            if (t->state == LPUGL_TASK_RUNNING) {
+                t->state = LPUGL_TASK_CLOSED; // freed after resuming, see resumeTask()
+            } else {
+                free(t);
+            }
+        }                                                               /* -> tasks, threads */
+        lua_pop(L, 1);                                                  /* -> tasks */
+    }
+    lua_pop(L, 1);                                                      /* -> */
+    lua_pushnil(L);                                                     /* -> nil */
+    lua_rawseti(L, worldUservalueIdx, LPUGL_WORLD_UV_TASKS);            /* -> */
+}
+
+/* ============================================================================================ */
+
+int lpugl_task_init_module(lua_State* L, int LPUGL_UNUSED(module))
+{
+    if (lua_rawgetp(L, LUA_REGISTRYINDEX, &taskThreadsKey) != LUA_TTABLE) { /* -> ? */
+        lua_pop(L, 1);                                                  /* -> */
+        lua_newtable(L);                                                /* -> threads */
+        lua_newtable(L);                                                /* -> threads, meta */
+        lua_pushstring(L, "__mode");                                    /* -> threads, meta, key */
+        lua_pushstring(L, "k");                                         /* -> threads, meta, key, value */
+        lua_rawset(L, -3);                                              /* -> threads, meta */
+        lua_setmetatable(L, -2);                                        /* -> threads */
+        lua_pushvalue(L, -1);                                           /* -> threads, threads */
+        lua_rawsetp(L, LUA_REGISTRYINDEX, &taskThreadsKey);             /* -> threads */
+    }
+    lua_pop(L, 1);                                                      /* -> */
+    return 0;
+}
+
+/* ============================================================================================ */
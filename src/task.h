@@ -0,0 +1,58 @@
+#ifndef LPUGL_TASK_H
+#define LPUGL_TASK_H
+
+#include "base.h"
+
+struct LpuglWorld;
+
+/* ============================================================================================ */
+
+//  task states
+#define LPUGL_TASK_RUNNING  0
+#define LPUGL_TASK_SLEEP    1   // in world's list of sleeping tasks, also for ready tasks
+#define LPUGL_TASK_EVENT    2   // in world's list of tasks waiting for view events
+#define LPUGL_TASK_FD       3   // in world's list of tasks waiting for file descriptors
+
+/* ============================================================================================ */
+
+/*
+ * Coroutine that is managed by a world. The coroutine itself is stored in the
+ * world's uservalue table LPUGL_WORLD_UV_TASKS with the task as lightuserdata key.
+ * A task is in at most one of the world's lists, depending on its state.
+ */
+typedef struct LpuglTask {
+    int                 state;
+    double              time;           // LPUGL_TASK_SLEEP: world time for resuming
+    const void*         view;           // LPUGL_TASK_EVENT: view, NULL if view was closed
+    char                eventName[24];  // LPUGL_TASK_EVENT: empty string for any event
+    int                 fd;             // LPUGL_TASK_FD
+    int                 startArgs;      // arguments on the coroutine's stack for the first resume
+    struct LpuglTask*   next;
+} LpuglTask;
+
+/* ============================================================================================ */
+
+int lpugl_task_init_module(lua_State* L, int module);
+
+int lpugl_task_spawn(lua_State* L, struct LpuglWorld* world, int worldIdx, int funcIdx);
+
+int lpugl_task_sleep(lua_State* L, int arg);
+
+int lpugl_task_wait_event(lua_State* L, int arg);
+
+int lpugl_task_wait_fd(lua_State* L, int arg);
+
+double lpugl_task_next_time(struct LpuglWorld* world);
+
+void lpugl_task_resume_all(lua_State* L, struct LpuglWorld* world, int worldUservalueIdx, int msgh);
+
+void lpugl_task_deliver_event(lua_State* L, struct LpuglWorld* world, const void* view,
+                              const char* eventName, int argsIdx, int nargs);
+
+void lpugl_task_view_closed(struct LpuglWorld* world, const void* view);
+
+void lpugl_task_close_all(lua_State* L, struct LpuglWorld* world, int worldUservalueIdx);
+
+/* ============================================================================================ */
+
+#endif /* LPUGL_TASK_H */
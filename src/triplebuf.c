@@ -0,0 +1,540 @@
+#define LPUGL_TRIPLEBUF_CAPI_IMPLEMENT_SET_CAPI 1
+
+#include "base.h"
+
+#include "lpugl.h"
+#include "triplebuf.h"
+#include "world.h"
+#include "error.h"
+#include "triplebuf_capi.h"
+
+/* ============================================================================================ */
+
+static const char* const LPUGL_TRIPLEBUF_CLASS_NAME = "lpugl.triplebuffer";
+
+static LpuglTripleBuffer* global_buffer_list = NULL;
+
+/* ============================================================================================ */
+
+typedef struct TripleBufUserData {
+    LpuglTripleBuffer* buffer;
+    bool               restricted;
+} TripleBufUserData;
+
+/* ============================================================================================ */
+
+static void setupTripleBufMeta(lua_State* L);
+
+static int pushTripleBufMeta(lua_State* L)
+{
+    if (luaL_newmetatable(L, LPUGL_TRIPLEBUF_CLASS_NAME)) {
+        setupTripleBufMeta(L);
+    }
+    return 1;
+}
+
+/* ============================================================================================ */
+
+/*
+ * Can be called from the writer thread. Does not allocate memory and never blocks. 
+ * Only if the buffer has an update function and the reader has taken the previous 
+ * values, the world is awakened. If the world's lock is held by another thread, 
+ * the awake is retried by the next publish.
+ * Returns 0 on success and 1 if the buffer is closed.
+ */
+static int publishArray(LpuglTripleBuffer* buffer)
+{
+    if (atomic_get(&buffer->closed)) {
+        return 1;
+    }
+    int old = atomic_set(&buffer->state, buffer->writeIdx | LPUGL_TRIPLEBUF_NEW);
+    buffer->writeIdx = old & 3;
+
+    // only awake if the reader has taken the previous values
+    if (buffer->hasFunc && (!(old & LPUGL_TRIPLEBUF_NEW) || buffer->awakePending)) {
+        buffer->awakePending =    atomic_get(&buffer->world->awakeSent) == 0
+                               && lpugl_world_try_awake(buffer->world) == 2;
+    }
+    return 0;
+}
+
+/*
+ * Must be called from the reader thread. Returns true if newer values are available
+ * in the read array.
+ */
+static bool takeNewestArray(LpuglTripleBuffer* buffer)
+{
+    if (!(atomic_get(&buffer->state) & LPUGL_TRIPLEBUF_NEW)) {
+        return false;
+    }
+    int old = atomic_set(&buffer->state, buffer->readIdx);
+    buffer->readIdx = old & 3;
+    return true;
+}
+
+/* ============================================================================================ */
+
+static void retainBuffer(LpuglTripleBuffer* buffer)
+{
+    atomic_inc(&buffer->used);
+}
+
+static void releaseBuffer(LpuglTripleBuffer* buffer)
+{
+    if (atomic_dec(&buffer->used) <= 0) {
+        lpugl_world_release(buffer->world);
+        free(buffer);
+    }
+}
+
+/* ============================================================================================ */
+
+/*
+ * Must be called on the world's thread.
+ */
+static bool closeBuffer(LpuglTripleBuffer* buffer)
+{
+    if (!atomic_set_if_equal(&buffer->closed, 0, 1)) {
+        return false;
+    }
+    async_mutex_lock(lpugl_global_lock);
+        LpuglTripleBuffer** b = &global_buffer_list;
+        while (*b && *b != buffer) {
+            b = &(*b)->nextGlobal;
+        }
+        if (*b) {
+            *b = buffer->nextGlobal;
+        }
+    async_mutex_unlock(lpugl_global_lock);
+
+    LpuglWorld* world = buffer->world;
+    LpuglTripleBuffer** b2 = &world->tripleBuffers;
+    while (*b2 && *b2 != buffer) {
+        b2 = &(*b2)->nextBuffer;
+    }
+    if (*b2) {
+        *b2 = buffer->nextBuffer;
+    }
+    world->tripleBuffersChanged += 1;
+    return true;
+}
+
+/* ============================================================================================ */
+
+int lpugl_triplebuf_new(lua_State* L, LpuglWorld* world, int worldIdx, lua_Integer count, int funcIdx)
+{
+    TripleBufUserData* udata = lua_newuserdata(L, sizeof(TripleBufUserData)); /* -> udata */
+    memset(udata, 0, sizeof(TripleBufUserData));
+    pushTripleBufMeta(L);                                                      /* -> udata, meta */
+    lua_setmetatable(L, -2);                                                   /* -> udata */
+
+    // one allocation for all arrays, the writer never allocates
+    LpuglTripleBuffer* buffer = calloc(1, sizeof(LpuglTripleBuffer) + 3 * count * sizeof(double));
+    if (!buffer) {
+        return lpugl_ERROR_OUT_OF_MEMORY(L);
+    }
+    udata->buffer = buffer;
+    atomic_set(&buffer->used, 1);
+    atomic_set(&buffer->state, 1);
+    buffer->writeIdx = 0;
+    buffer->readIdx  = 2;
+    buffer->count    = count;
+    for (int i = 0; i < 3; ++i) {
+        buffer->arrays[i] = ((double*)(buffer + 1)) + i * count;
+    }
+    buffer->id    = atomic_inc(&lpugl_id_counter);
+    buffer->world = world;
+    atomic_inc(&world->used);
+
+    if (funcIdx) {
+        buffer->hasFunc = true;
+        lua_newtable(L);                                                       /* -> udata, uservalue */
+        lua_pushvalue(L, funcIdx);                                             /* -> udata, uservalue, func */
+        lua_rawseti(L, -2, LPUGL_TRIPLEBUF_UV_FUNC);                           /* -> udata, uservalue */
+        lua_setuservalue(L, -2);                                               /* -> udata */
+
+        lua_getuservalue(L, worldIdx);                                         /* -> udata, worldUservalue */
+        if (lua_rawgeti(L, -1, LPUGL_WORLD_UV_TRIPLEBUFS) != LUA_TTABLE) {     /* -> udata, worldUservalue, ? */
+            lua_pop(L, 1);                                                     /* -> udata, worldUservalue */
+            lua_newtable(L);                                                   /* -> udata, worldUservalue, buffers */
+            lua_pushvalue(L, -1);                                              /* -> udata, worldUservalue, buffers, buffers */
+            lua_rawseti(L, -3, LPUGL_WORLD_UV_TRIPLEBUFS);                     /* -> udata, worldUservalue, buffers */
+        }                                                                      /* -> udata, worldUservalue, buffers */
+        lua_pushvalue(L, -3);                                                  /* -> udata, worldUservalue, buffers, udata */
+        lua_rawsetp(L, -2, buffer);                                            /* -> udata, worldUservalue, buffers */
+        lua_pop(L, 2);                                                         /* -> udata */
+    }
+
+    buffer->nextBuffer           = world->tripleBuffers;
+    world->tripleBuffers         = buffer;
+    world->tripleBuffersChanged += 1;
+
+    async_mutex_lock(lpugl_global_lock);
+        buffer->nextGlobal = global_buffer_list;
+        global_buffer_list = buffer;
+    async_mutex_unlock(lpugl_global_lock);
+
+    return 1;
+}
+
+/* ============================================================================================ */
+
+void lpugl_triplebuf_close_all(lua_State* L, LpuglWorld* world, int worldUservalueIdx)
+{
+    while (world->tripleBuffers) {
+        closeBuffer(world->tripleBuffers);
+    }
+    lua_pushnil(L);                                                            /* -> nil */
+    lua_rawseti(L, worldUservalueIdx, LPUGL_WORLD_UV_TRIPLEBUFS);              /* -> */
+}
+
+/* ============================================================================================ */
+
+/*
+ * Invokes the update functions of all buffers with new values. Must be called on the
+ * world's thread with the world's uservalue at the given index.
+ */
+void lpugl_triplebuf_deliver_all(lua_State* L, LpuglWorld* world, int worldUservalueIdx, int msgh)
+{
+    int pass = ++world->tripleBuffersPass;
+again:
+    for (LpuglTripleBuffer* buffer = world->tripleBuffers; buffer; buffer = buffer->nextBuffer) {
+        if (   !buffer->hasFunc || buffer->deliverPass == pass
+            || !(atomic_get(&buffer->state) & LPUGL_TRIPLEBUF_NEW))
+        {
+            continue;
+        }
+        buffer->deliverPass = pass;
+        int changed = world->tripleBuffersChanged;
+
+        lua_rawgeti(L, worldUservalueIdx, LPUGL_WORLD_UV_TRIPLEBUFS);          /* -> buffers */
+        lua_rawgetp(L, -1, buffer);                                            /* -> buffers, udata */
+        lua_getuservalue(L, -1);                                               /* -> buffers, udata, uservalue */
+        lua_rawgeti(L, -1, LPUGL_TRIPLEBUF_UV_FUNC);                           /* -> buffers, udata, uservalue, func */
+        lua_pushvalue(L, -3);                                                  /* -> buffers, udata, uservalue, func, udata */
+        if (lua_pcall(L, 1, 0, msgh) != 0) {                                   /* -> buffers, udata, uservalue, ? */
+            lpugl_world_handle_error(L, worldUservalueIdx, msgh);              /* -> buffers, udata, uservalue */
+        }
+        lua_pop(L, 3);                                                         /* -> */
+
+        if (world->tripleBuffersChanged != changed) {
+            goto again; // buffer list was modified by the update function
+        }
+    }
+}
+
+/* ============================================================================================ */
+
+static int Lpugl_tripleBuffer(lua_State* L)
+{
+    lua_Integer id = luaL_checkinteger(L, 1);
+
+    TripleBufUserData* udata = lua_newuserdata(L, sizeof(TripleBufUserData)); /* -> udata */
+    memset(udata, 0, sizeof(TripleBufUserData));
+    pushTripleBufMeta(L);                                                      /* -> udata, meta */
+    lua_setmetatable(L, -2);                                                   /* -> udata */
+    udata->restricted = true;
+
+    async_mutex_lock(lpugl_global_lock);
+        LpuglTripleBuffer* b = global_buffer_list;
+        while (b && b->id != id) {
+            b = b->nextGlobal;
+        }
+        if (b) {
+            atomic_inc(&b->used);
+        }
+    async_mutex_unlock(lpugl_global_lock);
+
+    if (b) {
+        udata->buffer = b;
+        return 1;
+    } else {
+        return lpugl_ERROR_UNKNOWN_OBJECT_triplebuffer_id(L, id);
+    }
+}
+
+/* ============================================================================================ */
+
+static TripleBufUserData* checkReaderUdata(lua_State* L)
+{
+    TripleBufUserData* udata = luaL_checkudata(L, 1, LPUGL_TRIPLEBUF_CLASS_NAME);
+    if (udata->restricted) {
+        lpugl_ERROR_RESTRICTED_ACCESS(L);
+        return NULL;
+    }
+    if (!udata->buffer || atomic_get(&udata->buffer->closed)) {
+        lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+        return NULL;
+    }
+    return udata;
+}
+
+/* ============================================================================================ */
+
+static int TripleBuf_release(lua_State* L)
+{
+    TripleBufUserData* udata = luaL_checkudata(L, 1, LPUGL_TRIPLEBUF_CLASS_NAME);
+    if (udata->buffer) {
+        if (!udata->restricted) {
+            closeBuffer(udata->buffer);
+        }
+        releaseBuffer(udata->buffer);
+        udata->buffer = NULL;
+    }
+    return 0;
+}
+
+/* ============================================================================================ */
+
+static int TripleBuf_close(lua_State* L)
+{
+    TripleBufUserData* udata = luaL_checkudata(L, 1, LPUGL_TRIPLEBUF_CLASS_NAME);
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    LpuglTripleBuffer* buffer = udata->buffer;
+    if (buffer && closeBuffer(buffer) && buffer->hasFunc) {
+        LpuglWorld* world = buffer->world;
+        if (world->weakWorldRef != LUA_REFNIL) {
+            if (lua_rawgeti(L, LUA_REGISTRYINDEX, world->weakWorldRef)
+                                                    == LUA_TTABLE) {    /* -> weakWorld */
+                if (   lua_rawgeti(L, -1, 0) == LUA_TUSERDATA           /* -> weakWorld, world */
+                    && lua_getuservalue(L, -1) == LUA_TTABLE            /* -> weakWorld, world, worldUservalue */
+                    && lua_rawgeti(L, -1, LPUGL_WORLD_UV_TRIPLEBUFS) == LUA_TTABLE)
+                {                                                       /* -> weakWorld, world, worldUservalue, buffers */
+                    lua_pushnil(L);                                     /* -> weakWorld, world, worldUservalue, buffers, nil */
+                    lua_rawsetp(L, -2, buffer);                         /* -> weakWorld, world, worldUservalue, buffers */
+                }
+            }
+            lua_settop(L, 1);                                           /* -> */
+        }
+    }
+    return 0;
+}
+
+/* ============================================================================================ */
+
+static int TripleBuf_isClosed(lua_State* L)
+{
+    TripleBufUserData* udata = luaL_checkudata(L, 1, LPUGL_TRIPLEBUF_CLASS_NAME);
+    lua_pushboolean(L, !udata->buffer || atomic_get(&udata->buffer->closed));
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int TripleBuf_id(lua_State* L)
+{
+    TripleBufUserData* udata = luaL_checkudata(L, 1, LPUGL_TRIPLEBUF_CLASS_NAME);
+    if (!udata->buffer) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    lua_pushinteger(L, udata->buffer->id);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int TripleBuf_count(lua_State* L)
+{
+    TripleBufUserData* udata = luaL_checkudata(L, 1, LPUGL_TRIPLEBUF_CLASS_NAME);
+    if (!udata->buffer) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    lua_pushinteger(L, udata->buffer->count);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int TripleBuf_write(lua_State* L)
+{
+    TripleBufUserData* udata = luaL_checkudata(L, 1, LPUGL_TRIPLEBUF_CLASS_NAME);
+    LpuglTripleBuffer* buffer = udata->buffer;
+    if (!buffer || atomic_get(&buffer->closed)) {
+        lua_pushboolean(L, false);
+        return 1;
+    }
+    double* array = buffer->arrays[buffer->writeIdx];
+    size_t  count = buffer->count;
+    if (lua_type(L, 2) == LUA_TTABLE) {
+        for (size_t i = 0; i < count; ++i) {
+            lua_rawgeti(L, 2, i + 1);
+            array[i] = lua_tonumber(L, -1);
+            lua_pop(L, 1);
+        }
+    } else {
+        size_t n = lua_gettop(L) - 1;
+        for (size_t i = 0; i < count; ++i) {
+            array[i] = (i < n) ? luaL_checknumber(L, i + 2) : 0;
+        }
+    }
+    lua_pushboolean(L, publishArray(buffer) == 0);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int TripleBuf_update(lua_State* L)
+{
+    TripleBufUserData* udata = checkReaderUdata(L);
+    lua_pushboolean(L, takeNewestArray(udata->buffer));
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int TripleBuf_read(lua_State* L)
+{
+    TripleBufUserData* udata = checkReaderUdata(L);
+    LpuglTripleBuffer* buffer = udata->buffer;
+    bool isNew = takeNewestArray(buffer);
+    if (lua_isnoneornil(L, 2)) {
+        lua_settop(L, 1);
+        lua_createtable(L, buffer->count, 0);                   /* -> udata, t */
+    } else {
+        luaL_checktype(L, 2, LUA_TTABLE);
+        lua_settop(L, 2);                                       /* -> udata, t */
+    }
+    const double* array = buffer->arrays[buffer->readIdx];
+    for (size_t i = 0; i < buffer->count; ++i) {
+        lua_pushnumber(L, array[i]);                            /* -> udata, t, value */
+        lua_rawseti(L, 2, i + 1);                               /* -> udata, t */
+    }
+    lua_pushboolean(L, isNew);                                  /* -> udata, t, isNew */
+    return 2;
+}
+
+/* ============================================================================================ */
+
+static int TripleBuf_getPointer(lua_State* L)
+{
+    TripleBufUserData* udata = checkReaderUdata(L);
+    LpuglTripleBuffer* buffer = udata->buffer;
+    lua_pushlightuserdata(L, buffer->arrays[buffer->readIdx]);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int TripleBuf_toString(lua_State* L)
+{
+    TripleBufUserData* udata = luaL_checkudata(L, 1, LPUGL_TRIPLEBUF_CLASS_NAME);
+    if (udata->buffer) {
+        lua_pushfstring(L, "%s: %p (id=%d)", LPUGL_TRIPLEBUF_CLASS_NAME, udata, (int)udata->buffer->id);
+    } else {
+        lua_pushfstring(L, "%s: %p (closed)", LPUGL_TRIPLEBUF_CLASS_NAME, udata);
+    }
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static lpugl_triplebuf* triplebuf_capi_toBuffer(lua_State* L, int index)
+{
+    TripleBufUserData* udata = luaL_testudata(L, index, LPUGL_TRIPLEBUF_CLASS_NAME);
+    return udata ? (lpugl_triplebuf*)udata->buffer : NULL;
+}
+
+static void triplebuf_capi_retainBuffer(lpugl_triplebuf* b)
+{
+    retainBuffer((LpuglTripleBuffer*)b);
+}
+
+static void triplebuf_capi_releaseBuffer(lpugl_triplebuf* b)
+{
+    if (b) {
+        releaseBuffer((LpuglTripleBuffer*)b);
+    }
+}
+
+static size_t triplebuf_capi_getCount(lpugl_triplebuf* b)
+{
+    return ((LpuglTripleBuffer*)b)->count;
+}
+
+static double* triplebuf_capi_getWriteArray(lpugl_triplebuf* b)
+{
+    LpuglTripleBuffer* buffer = (LpuglTripleBuffer*)b;
+    return buffer->arrays[buffer->writeIdx];
+}
+
+static int triplebuf_capi_publish(lpugl_triplebuf* b)
+{
+    return publishArray((LpuglTripleBuffer*)b);
+}
+
+static const lpugl_triplebuf_capi triplebuf_capi_impl =
+{
+    LPUGL_TRIPLEBUF_CAPI_VERSION_MAJOR,
+    LPUGL_TRIPLEBUF_CAPI_VERSION_MINOR,
+    LPUGL_TRIPLEBUF_CAPI_VERSION_PATCH,
+    NULL, // next_capi
+
+    triplebuf_capi_toBuffer,
+
+    triplebuf_capi_retainBuffer,
+    triplebuf_capi_releaseBuffer,
+
+    triplebuf_capi_getCount,
+    triplebuf_capi_getWriteArray,
+    triplebuf_capi_publish
+};
+
+/* ============================================================================================ */
+
+static const luaL_Reg TripleBufMethods[] =
+{
+    { "id",          TripleBuf_id         },
+    { "count",       TripleBuf_count      },
+    { "write",       TripleBuf_write      },
+    { "update",      TripleBuf_update     },
+    { "read",        TripleBuf_read       },
+    { "getPointer",  TripleBuf_getPointer },
+    { "close",       TripleBuf_close      },
+    { "isClosed",    TripleBuf_isClosed   },
+    { NULL,          NULL } /* sentinel */
+};
+
+static const luaL_Reg TripleBufMetaMethods[] =
+{
+    { "__tostring", TripleBuf_toString },
+    { "__gc",       TripleBuf_release  },
+    { NULL,         NULL } /* sentinel */
+};
+
+static const luaL_Reg ModuleFunctions[] =
+{
+    { "tripleBuffer", Lpugl_tripleBuffer },
+    { NULL,           NULL } /* sentinel */
+};
+
+static void setupTripleBufMeta(lua_State* L)
+{                                                           /* -> meta */
+    lua_pushstring(L, LPUGL_TRIPLEBUF_CLASS_NAME);          /* -> meta, className */
+    lua_setfield(L, -2, "__metatable");                     /* -> meta */
+
+    luaL_setfuncs(L, TripleBufMetaMethods, 0);              /* -> meta */
+
+    lua_newtable(L);  /* TripleBufClass */                  /* -> meta, TripleBufClass */
+    luaL_setfuncs(L, TripleBufMethods, 0);                  /* -> meta, TripleBufClass */
+    lua_setfield (L, -2, "__index");                        /* -> meta */
+
+    lpugl_triplebuf_set_capi(L, -1, &triplebuf_capi_impl);  /* -> meta */
+}
+
+int lpugl_triplebuf_init_module(lua_State* L, int module)
+{
+    if (luaL_newmetatable(L, LPUGL_TRIPLEBUF_CLASS_NAME)) {
+        setupTripleBufMeta(L);
+    }
+    lua_pop(L, 1);
+
+    lua_pushvalue(L, module);
+        luaL_setfuncs(L, ModuleFunctions, 0);
+    lua_pop(L, 1);
+
+    return 0;
+}
+
+/* ============================================================================================ */
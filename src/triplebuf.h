@@ -0,0 +1,53 @@
+#ifndef LPUGL_TRIPLEBUF_H
+#define LPUGL_TRIPLEBUF_H
+
+#include "base.h"
+#include "async_util.h"
+
+struct LpuglWorld;
+
+/* ============================================================================================ */
+
+//  triple buffer uservalue indices
+#define LPUGL_TRIPLEBUF_UV_FUNC  1
+
+//  flag in LpuglTripleBuffer.state: the back array contains newer values than the read array
+#define LPUGL_TRIPLEBUF_NEW      4
+
+/* ============================================================================================ */
+
+/*
+ * Three arrays of numbers for one writer and one reader. The writer fills its own
+ * array and exchanges it with the back array, the reader exchanges its array with
+ * the back array if this contains newer values. Both sides never wait.
+ */
+typedef struct LpuglTripleBuffer {
+    lua_Integer                 id;
+    AtomicCounter               used;
+    AtomicCounter               closed;
+    AtomicCounter               state;       // index of back array | LPUGL_TRIPLEBUF_NEW
+    int                         writeIdx;    // only accessed by the writer
+    int                         readIdx;     // only accessed by the reader
+    size_t                      count;
+    double*                     arrays[3];
+    bool                        hasFunc;
+    bool                        awakePending; // only accessed by the writer
+    int                         deliverPass; // only accessed on the world's thread
+    struct LpuglWorld*          world;       // retained until buffer is destructed
+    struct LpuglTripleBuffer*   nextBuffer;  // in list of world's open buffers
+    struct LpuglTripleBuffer*   nextGlobal;  // in global list of open buffers
+} LpuglTripleBuffer;
+
+/* ============================================================================================ */
+
+int lpugl_triplebuf_init_module(lua_State* L, int module);
+
+int lpugl_triplebuf_new(lua_State* L, struct LpuglWorld* world, int worldIdx, lua_Integer count, int funcIdx);
+
+void lpugl_triplebuf_close_all(lua_State* L, struct LpuglWorld* world, int worldUservalueIdx);
+
+void lpugl_triplebuf_deliver_all(lua_State* L, struct LpuglWorld* world, int worldUservalueIdx, int msgh);
+
+/* ============================================================================================ */
+
+#endif /* LPUGL_TRIPLEBUF_H */
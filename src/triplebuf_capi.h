@@ -0,0 +1,163 @@
+#ifndef LPUGL_TRIPLEBUF_CAPI_H
+#define LPUGL_TRIPLEBUF_CAPI_H
+
+#define LPUGL_TRIPLEBUF_CAPI_ID_STRING     "_capi_lpugl_triplebuf"
+#define LPUGL_TRIPLEBUF_CAPI_VERSION_MAJOR  0
+#define LPUGL_TRIPLEBUF_CAPI_VERSION_MINOR  1
+#define LPUGL_TRIPLEBUF_CAPI_VERSION_PATCH  0
+
+#ifndef LPUGL_TRIPLEBUF_CAPI_IMPLEMENT_SET_CAPI
+#  define LPUGL_TRIPLEBUF_CAPI_IMPLEMENT_SET_CAPI 0
+#endif
+
+#ifndef LPUGL_TRIPLEBUF_CAPI_IMPLEMENT_GET_CAPI
+#  define LPUGL_TRIPLEBUF_CAPI_IMPLEMENT_GET_CAPI 0
+#endif
+
+#ifdef __cplusplus
+
+extern "C" {
+
+struct lpugl_triplebuf;
+struct lpugl_triplebuf_capi;
+
+#else /* __cplusplus */
+
+typedef struct lpugl_triplebuf      lpugl_triplebuf;
+typedef struct lpugl_triplebuf_capi lpugl_triplebuf_capi;
+
+#endif /* ! __cplusplus */
+
+/**
+ *  LPugl Triple Buffer C API.
+ *
+ *  Allows one producer thread, e.g. a real-time audio thread, to publish arrays
+ *  of numbers to an lpugl world without blocking and without memory allocation.
+ *  The reader always obtains the most recently published array.
+ */
+struct lpugl_triplebuf_capi
+{
+    int version_major;
+    int version_minor;
+    int version_patch;
+
+    /**
+     * May point to another (incompatible) version of this API implementation.
+     * NULL if no such implementation exists.
+     */
+    void* next_capi;
+
+    /**
+     * Returns a valid pointer if the Lua object at the given stack
+     * index is a triple buffer object, otherwise returns NULL.
+     *
+     * The returned buffer is valid as long as the Lua object at the given
+     * stack index remains valid. To keep the buffer beyond this call, the
+     * function retainBuffer() must be called (see below).
+     */
+    lpugl_triplebuf* (*toBuffer)(lua_State* L, int index);
+
+    /**
+     * Increases the reference counter of the buffer. Thread safe.
+     */
+    void (*retainBuffer)(lpugl_triplebuf* b);
+
+    /**
+     * Decreases the reference counter of the buffer and destructs the
+     * buffer if no reference is left. Thread safe.
+     */
+    void (*releaseBuffer)(lpugl_triplebuf* b);
+
+    /**
+     * Returns the number of values in each array of the buffer.
+     */
+    size_t (*getCount)(lpugl_triplebuf* b);
+
+    /**
+     * Returns the array that is to be filled by the writer. Only one thread
+     * may write to the buffer. The returned array is only valid until the
+     * next call of publish(). It does not contain previously written values.
+     */
+    double* (*getWriteArray)(lpugl_triplebuf* b);
+
+    /**
+     * Makes the array obtained by getWriteArray() the newest array for the
+     * reader. Does not allocate memory and never blocks. If the buffer has an
+     * update function, the world's event loop is awakened once until the update
+     * function has been invoked. If the world's lock is held by another thread,
+     * awakening is retried by the next call.
+     *
+     * Returns 0 - on success
+     *         1 - if the buffer is closed. The caller is expected to release the buffer.
+     *             Subsequent calls will always result this return code again.
+     */
+    int (*publish)(lpugl_triplebuf* b);
+};
+
+#if LPUGL_TRIPLEBUF_CAPI_IMPLEMENT_SET_CAPI
+/**
+ * Sets the LPugl Triple Buffer C API into the metatable at the given index.
+ */
+static int lpugl_triplebuf_set_capi(lua_State* L, int index, const lpugl_triplebuf_capi* capi)
+{
+    lua_pushlstring(L, LPUGL_TRIPLEBUF_CAPI_ID_STRING, strlen(LPUGL_TRIPLEBUF_CAPI_ID_STRING));   /* -> key */
+    void** udata = (void**) lua_newuserdata(L, sizeof(void*) + strlen(LPUGL_TRIPLEBUF_CAPI_ID_STRING) + 1); /* -> key, value */
+    *udata = (void*)capi;
+    strcpy((char*)(udata + 1), LPUGL_TRIPLEBUF_CAPI_ID_STRING); /* -> key, value */
+    lua_rawset(L, (index < 0) ? (index - 2) : index);         /* -> */
+    return 0;
+}
+#endif /* LPUGL_TRIPLEBUF_CAPI_IMPLEMENT_SET_CAPI */
+
+#if LPUGL_TRIPLEBUF_CAPI_IMPLEMENT_GET_CAPI
+/**
+ * Gives the associated LPugl Triple Buffer C API for the object at the given stack index.
+ * Returns NULL, if the object at the given stack index does not have an
+ * associated C API or only has a C API with incompatible version number.
+ * If errorReason is not NULL it receives the error reason in this case:
+ * 1 for incompatible version nummber and 2 for no associated C API at all.
+ */
+static const lpugl_triplebuf_capi* lpugl_triplebuf_get_capi(lua_State* L, int index, int* errorReason)
+{
+    if (luaL_getmetafield(L, index, LPUGL_TRIPLEBUF_CAPI_ID_STRING) != LUA_TNIL)   /* -> _capi */
+    {
+        const void** udata = (const void**) lua_touserdata(L, -1);              /* -> _capi */
+
+        if (   udata
+            && (lua_rawlen(L, -1) >= sizeof(void*) + strlen(LPUGL_TRIPLEBUF_CAPI_ID_STRING) + 1)
+            && (memcmp((char*)(udata + 1), LPUGL_TRIPLEBUF_CAPI_ID_STRING,
+                       strlen(LPUGL_TRIPLEBUF_CAPI_ID_STRING) + 1) == 0))
+        {
+            const lpugl_triplebuf_capi* capi = (const lpugl_triplebuf_capi*) *udata; /* -> _capi */
+            while (capi) {
+                if (   capi->version_major == LPUGL_TRIPLEBUF_CAPI_VERSION_MAJOR
+                    && capi->version_minor >= LPUGL_TRIPLEBUF_CAPI_VERSION_MINOR)
+                {                                                                /* -> _capi */
+                    lua_pop(L, 1);                                               /* -> */
+                    return capi;
+                }
+                capi = (const lpugl_triplebuf_capi*) capi->next_capi;
+            }
+            if (errorReason) {
+                *errorReason = 1;
+            }
+        } else {                                                                 /* -> _capi */
+            if (errorReason) {
+                *errorReason = 2;
+            }
+        }
+        lua_pop(L, 1);                                                           /* -> */
+    } else {                                                                     /* -> */
+        if (errorReason) {
+            *errorReason = 2;
+        }
+    }
+    return NULL;
+}
+#endif /* LPUGL_TRIPLEBUF_CAPI_IMPLEMENT_GET_CAPI */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LPUGL_TRIPLEBUF_CAPI_H */
@@ -23,6 +23,8 @@
     #define LPUGL_PLATFORM MAC
 #elif defined(LPUGL_USE_X11)
     #define LPUGL_PLATFORM X11
+#elif defined(LPUGL_USE_HEADLESS)
+    #define LPUGL_PLATFORM HEADLESS
 #endif
 
 #define LPUGL_PLATFORM_STRING LPUGL_TOSTRING(LPUGL_PLATFORM)
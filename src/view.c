@@ -12,19 +12,31 @@
 #include "error.h"
 #include "version.h"
 #include "backend.h"
+#include "record.h"
+#include "snapshot.h"
+#include "viewpool.h"
+#include "task.h"
 
 /* ============================================================================================ */
 
 static const char* const LPUGL_VIEW_CLASS_NAME = "lpugl.view";
 
 typedef struct ViewUserData {
+    lua_Integer   id;
     LpuglWorld*   world;
     LpuglBackend* backend;
     PuglView*     puglView;
     int           eventFuncNargs;
     bool          isChild;
     bool          isPopup;
+    bool          isResizable;
+    bool          useDoubleBuffer;
     bool          drawing;
+    bool          drawContextBound;
+    bool          visible;        // as reported by VISIBILITY_CHANGED
+    bool          deferHidden;    // postRedisplay is deferred while not visible
+    bool          hasDeferred;
+    PuglRect      deferredRect;
 } ViewUserData;
 
 /* ============================================================================================ */
@@ -43,6 +55,26 @@ static int pushViewMeta(lua_State* L)
 
 /* ============================================================================================ */
 
+/*
+ * View methods have the view meta table as first upvalue: comparing the meta table 
+ * identity avoids the registry lookup by class name in luaL_checkudata(), which is
+ * only used for raising the error message.
+ */
+static ViewUserData* checkViewUdata(lua_State* L, int idx)
+{
+    void* udata = lua_touserdata(L, idx);
+    if (udata && lua_getmetatable(L, idx)) {                    /* -> meta */
+        bool isView = lua_rawequal(L, -1, lua_upvalueindex(1));
+        lua_pop(L, 1);                                          /* -> */
+        if (isView) {
+            return udata;
+        }
+    }
+    return luaL_checkudata(L, idx, LPUGL_VIEW_CLASS_NAME);
+}
+
+/* ============================================================================================ */
+
 static const char* puglKeyToName(PuglKey key) 
 {
     switch (key) {
@@ -150,6 +182,63 @@ static int convertUnicodeCharToUtf8(uint32_t c, char* rsltBuffer)
 
 /* ============================================================================================ */
 
+static bool convertUtf8ToUnicodeChar(const char* s, size_t len, uint32_t* rslt)
+{
+    const unsigned char* u = (const unsigned char*)s;
+    if (len == 1 && u[0] <= 0x7F) {
+        *rslt = u[0];
+    } else if (len == 2 && (u[0] & 0xE0) == 0xC0) {
+        *rslt = ((u[0] & 0x1F) << 6) | (u[1] & 0x3F);
+    } else if (len == 3 && (u[0] & 0xF0) == 0xE0) {
+        *rslt = ((u[0] & 0x0F) << 12) | ((u[1] & 0x3F) << 6) | (u[2] & 0x3F);
+    } else if (len == 4 && (u[0] & 0xF8) == 0xF0) {
+        *rslt = ((u[0] & 0x07) << 18) | ((u[1] & 0x3F) << 12) | ((u[2] & 0x3F) << 6) | (u[3] & 0x3F);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/* ============================================================================================ */
+
+static PuglKey puglNameToKey(const char* name) 
+{
+    for (uint32_t k = 0; k <= 0x7F; ++k) {
+        const char* n = puglKeyToName(k);
+        if (n && strcmp(n, name) == 0) {
+            return k;
+        }
+    }
+    for (uint32_t k = PUGL_KEY_F1; k <= PUGL_KEY_KP_SEPARATOR; ++k) {
+        const char* n = puglKeyToName(k);
+        if (n && strcmp(n, name) == 0) {
+            return k;
+        }
+    }
+    return 0;
+}
+
+/* ============================================================================================ */
+
+/*
+ * Returns true if the visibility reported to Lua has changed. Redisplays that were 
+ * deferred while the view was not visible are posted now.
+ */
+static bool setVisible(PuglView* view, ViewUserData* udata, bool visible)
+{
+    if (visible == udata->visible) {
+        return false;
+    }
+    udata->visible = visible;
+    if (visible && udata->hasDeferred) {
+        udata->hasDeferred = false;
+        puglPostRedisplayRect(view, udata->deferredRect);
+    }
+    return true;
+}
+
+/* ============================================================================================ */
+
 static PuglStatus handleEvent(PuglView* view, const PuglEvent* event)
 {
     if (event->type == PUGL_DESTROY) {
@@ -168,6 +257,11 @@ static PuglStatus handleEvent(PuglView* view, const PuglEvent* event)
 
     int nargs = udata->eventFuncNargs;
     if (nargs < 0) { // missing event handling function
+        if (   event->type == PUGL_MAP || event->type == PUGL_UNMAP 
+            || event->type == PUGL_VISIBILITY_CHANGED)
+        {
+            setVisible(view, udata, puglGetVisible(view));
+        }
         return PUGL_SUCCESS;
     }
 
@@ -210,6 +304,12 @@ static PuglStatus handleEvent(PuglView* view, const PuglEvent* event)
         case PUGL_CLOSE:              eventName = "CLOSE"; break;
         case PUGL_MUST_FREE:          closeView(L, udata, udataIdx); break;
         case PUGL_DATA_RECEIVED:      eventName = "DATA_RECEIVED"; break;
+        case PUGL_VISIBILITY_CHANGED: {
+            if (setVisible(view, udata, event->visibility.visible)) {
+                eventName = "VISIBILITY_CHANGED"; 
+            }
+            break;
+        }
         
         case PUGL_NOTHING:
         case PUGL_DESTROY:
@@ -221,6 +321,11 @@ static PuglStatus handleEvent(PuglView* view, const PuglEvent* event)
     if (eventName) {
         world->hadEvent = true;
         
+        int taskArgs = 0; // event parameters for tasks waiting for this view, see task.c
+        if (world->eventTasks) {
+            lua_newtable(L);
+            taskArgs = lua_gettop(L);
+        }
         lua_pushcfunction(L, lpugl_world_errormsghandler);
         int msgh = lua_gettop(L);
         for (int i = 0; i <= nargs; ++i) {
@@ -228,6 +333,7 @@ static PuglStatus handleEvent(PuglView* view, const PuglEvent* event)
         }
         lua_pushvalue(L, udataIdx); ++nargs;
         lua_pushstring(L, eventName); ++nargs;
+        int eventNameIdx = lua_gettop(L);
         bool lastExposure = false;
         switch (event->type) {
             case PUGL_BUTTON_PRESS:    
@@ -317,10 +423,49 @@ static PuglStatus handleEvent(PuglView* view, const PuglEvent* event)
                                    event->received.len); ++nargs;
                 break;
             }
+            case PUGL_VISIBILITY_CHANGED: {
+                lua_pushboolean(L, udata->visible); ++nargs;
+                break;
+            }
             default: 
                 break;
         }
-        int rc = lua_pcall(L, nargs, 0, msgh);
+        int taskNargs = lua_gettop(L) - eventNameIdx + 1;
+        if (taskArgs) {
+            for (int i = 0; i < taskNargs; ++i) {
+                lua_pushvalue(L, eventNameIdx + i);
+                lua_rawseti(L, taskArgs, i + 1);
+            }
+        }
+        int rc;
+        if (event->type == PUGL_EXPOSE) {
+#ifdef LUA_GCISRUNNING
+            bool pauseGC = world->idleGCPauseInExpose && lua_gc(L, LUA_GCISRUNNING, 0);
+#else
+            bool pauseGC = world->idleGCPauseInExpose;
+#endif
+            if (pauseGC) {
+                lua_gc(L, LUA_GCSTOP, 0);
+            }
+            double startTime = puglGetTime(world->puglWorld);
+            int    startKB   = lua_gc(L, LUA_GCCOUNT, 0);
+
+            rc = lua_pcall(L, nargs, 0, msgh);
+
+            int kb = lua_gc(L, LUA_GCCOUNT, 0);
+            world->gcStats.frameTime += puglGetTime(world->puglWorld) - startTime;
+            world->gcStats.frames    += 1;
+            if (kb >= startKB) {
+                world->gcStats.frameKB += kb - startKB;
+            } else {
+                world->gcStats.frameCollections += 1;
+            }
+            if (pauseGC) {
+                lua_gc(L, LUA_GCRESTART, 0);
+            }
+        } else {
+            rc = lua_pcall(L, nargs, 0, msgh);
+        }
 
         world->inCallback = wasInCallback;
         if (!wasInCallback && world->mustClosePugl) {
@@ -329,17 +474,18 @@ static PuglStatus handleEvent(PuglView* view, const PuglEvent* event)
     
         if (udata->drawing && lastExposure) {
             udata->drawing = false;
-            if (lua_rawgeti(L, uservalue, LPUGL_VIEW_UV_DRAWCTX) == LUA_TUSERDATA)
-            {                                                     /* -> context */
-                if (udata->backend->finishDrawContext) {
-                    udata->backend->finishDrawContext(L, lua_gettop(L));
+            if (udata->drawContextBound) {
+                udata->drawContextBound = false;
+                if (lua_rawgeti(L, uservalue, LPUGL_VIEW_UV_DRAWCTX) == LUA_TUSERDATA)
+                {                                                 /* -> context */
+                    if (udata->backend->finishDrawContext) {
+                        udata->backend->finishDrawContext(L, lua_gettop(L));
+                    }
+                    lua_pushnil(L);                               /* -> context, nil */
+                    lua_setmetatable(L, -2);                      /* -> context */
                 }
-                lua_pushnil(L);                                   /* -> context, nil */
-                lua_setmetatable(L, -2);                          /* -> context */
-                lua_pushnil(L);                                   /* -> context, nil */
-                lua_rawseti(L, uservalue, LPUGL_VIEW_UV_DRAWCTX); /* -> context */
+                lua_pop(L, 1);                                    /* -> */
             }
-            lua_pop(L, 1);                                        /* -> */
         }
         
         if (rc != 0) {                                                              /* -> error */
@@ -374,9 +520,22 @@ static PuglStatus handleEvent(PuglView* view, const PuglEvent* event)
                 abort();
             }
         }
+        if (taskArgs && world->eventTasks && world->weakWorldRef != LUA_REFNIL && world->puglWorld) {
+            lpugl_task_deliver_event(L, world, udata, eventName, taskArgs, taskNargs);
+        }
     }
     
     lua_settop(L, oldTop);
+
+    // MAP and UNMAP also change the visibility on platforms without VisibilityNotify
+    if (   (event->type == PUGL_MAP || event->type == PUGL_UNMAP)
+        && udata->puglView == view && puglGetVisible(view) != udata->visible)
+    {
+        PuglEvent visibility;
+        puglClearEventStruct(&visibility, PUGL_VISIBILITY_CHANGED);
+        visibility.visibility.visible = puglGetVisible(view);
+        handleEvent(view, &visibility);
+    }
     return PUGL_SUCCESS;
 }
 
@@ -453,6 +612,36 @@ static bool checkArgTableValueUdataOrLightUdata(lua_State* L, int argTable, cons
     return false;
 }
 
+/*
+ * Popup views may reuse a hidden view from the world's view pool if backend, 
+ * double buffering and resizability match.
+ */
+static PuglView* takePooledView(lua_State* L, LpuglWorld* world, int initArg)
+{
+    if (!world->viewPool) {
+        return NULL;
+    }
+    lua_pushstring(L, "popupFor");                      /* -> key */
+    bool isPopup = (lua_rawget(L, initArg) == LUA_TUSERDATA);
+    lua_pushstring(L, "useDoubleBuffer");               /* -> popupFor, key */
+    lua_rawget(L, initArg);                             /* -> popupFor, useDoubleBuffer */
+    lua_pushstring(L, "resizable");                     /* -> popupFor, useDoubleBuffer, key */
+    lua_rawget(L, initArg);                             /* -> popupFor, useDoubleBuffer, resizable */
+    lua_pushstring(L, "backend");                       /* -> popupFor, useDoubleBuffer, resizable, key */
+    lua_rawget(L, initArg);                             /* -> popupFor, useDoubleBuffer, resizable, backend */
+    bool          useDoubleBuffer = lua_toboolean(L, -3);
+    bool          isResizable     = lua_toboolean(L, -2);
+    LpuglBackend* backend         = lua_touserdata(L, -1);
+    lua_pop(L, 4);                                      /* -> */
+    
+    if (!isPopup) {
+        return NULL;
+    }
+    return lpugl_viewpool_take(L, world, backend, useDoubleBuffer, isResizable);
+}
+
+/* ============================================================================================ */
+
 int lpugl_view_new(lua_State* L, LpuglWorld* world, int initArg, int viewLookup)
 {
     ViewUserData* udata = lua_newuserdata(L, sizeof(ViewUserData));
@@ -461,10 +650,15 @@ int lpugl_view_new(lua_State* L, LpuglWorld* world, int initArg, int viewLookup)
     pushViewMeta(L);         /* -> udata, meta */
     lua_setmetatable(L, -2); /* -> udata */
     
+    udata->id    = atomic_inc(&lpugl_id_counter);
     udata->world = world;
     world->viewCount += 1;
     
-    udata->puglView = puglNewView(world->puglWorld);
+    udata->puglView = takePooledView(L, world, initArg);
+    bool isPooled = (udata->puglView != NULL);
+    if (!isPooled) {
+        udata->puglView = puglNewView(world->puglWorld);
+    }
     if (!udata->puglView) {
         return lpugl_ERROR_FAILED_OPERATION(L);
     }
@@ -477,6 +671,8 @@ int lpugl_view_new(lua_State* L, LpuglWorld* world, int initArg, int viewLookup)
     lua_rawgeti(L, LUA_REGISTRYINDEX, world->weakWorldRef); /* -> udata, weakWorld */
     lua_pushvalue(L, -2);                                   /* -> udata, weakWorld, udata */
     lua_rawsetp(L, -2, udata);                              /* -> udata, weakWorld */
+    lua_pushvalue(L, -2);                                   /* -> udata, weakWorld, udata */
+    lua_rawseti(L, -2, udata->id);                          /* -> udata, weakWorld */
     lua_pop(L, 1);                                          /* -> udata */
     
     // uservalue[-1]  = cairo_context
@@ -527,6 +723,30 @@ int lpugl_view_new(lua_State* L, LpuglWorld* world, int initArg, int viewLookup)
                 dontMergeRects = lua_toboolean(L, -1);
                 puglSetViewHint(udata->puglView, PUGL_DONT_MERGE_RECTS, dontMergeRects);
             }
+            else if (checkArgTableValueType(L, initArg, key, "deferHiddenRedisplay", LUA_TBOOLEAN))
+            {
+                udata->deferHidden = lua_toboolean(L, -1);
+            }
+            else if (checkArgTableValueType(L, initArg, key, "skipStaleRedisplay", LUA_TBOOLEAN))
+            {
+                puglSetViewHint(udata->puglView, PUGL_SKIP_STALE_EXPOSE, lua_toboolean(L, -1));
+            }
+            else if (checkArgTableValueType(L, initArg, key, "partialPresent", LUA_TBOOLEAN))
+            {
+                puglSetViewHint(udata->puglView, PUGL_PARTIAL_PRESENT, lua_toboolean(L, -1));
+            }
+            else if (checkArgTableValueType(L, initArg, key, "swapInterval", LUA_TNUMBER))
+            {
+                puglSetSwapInterval(udata->puglView, lua_tointeger(L, -1));
+            }
+            else if (checkArgTableValueType(L, initArg, key, "maxFramesInFlight", LUA_TNUMBER))
+            {
+                int maxFrames = lua_tointeger(L, -1);
+                if (maxFrames < 0) {
+                    return luaL_argerror(L, initArg, "invalid 'maxFramesInFlight' value");
+                }
+                puglSetViewHint(udata->puglView, PUGL_MAX_FRAMES_IN_FLIGHT, maxFrames);
+            }
             else if (checkArgTableValueType(L, initArg, key, "backgroundColor", LUA_TNUMBER))
             {
                 puglSetBackgroundColor(udata->puglView, lua_tointeger(L, -1));
@@ -733,15 +953,21 @@ int lpugl_view_new(lua_State* L, LpuglWorld* world, int initArg, int viewLookup)
     if (!hasEventFunc) {
         return luaL_argerror(L, initArg, "missing 'eventFunc' parameter");
     }
-    puglSetViewHint(udata->puglView, PUGL_RESIZABLE, isResizable);
-    puglSetViewHint(udata->puglView, PUGL_DOUBLE_BUFFER, useDoubleBuffer);
-    puglSetBackend(udata->puglView, backend->puglBackend);
+    udata->isResizable     = isResizable;
+    udata->useDoubleBuffer = useDoubleBuffer;
     backend->used += 1;
     
     if (title) {
         puglSetWindowTitle(udata->puglView, title);
     }
-    bool ok = puglRealize(udata->puglView) == PUGL_SUCCESS;
+    bool ok = true;
+    if (!isPooled) {
+        puglSetViewHint(udata->puglView, PUGL_RESIZABLE, isResizable);
+        puglSetViewHint(udata->puglView, PUGL_DOUBLE_BUFFER, useDoubleBuffer);
+        puglSetBackend(udata->puglView, backend->puglBackend);
+        puglSetBackendData(udata->puglView, backend->puglBackendData);
+        ok = puglRealize(udata->puglView) == PUGL_SUCCESS;
+    }
     if (title) free(title);
     if (!ok) {
         return lpugl_ERROR_FAILED_OPERATION(L);
@@ -767,12 +993,24 @@ bool lpugl_view_close(lua_State* L, ViewUserData* udata, int udataIdx)
             }                                                   /* -> uservalue, childviews */
         }                                                       /* -> uservalue, ? */
 
-        puglFreeView(udata->puglView);
-        udata->puglView = NULL;
-
         lua_rawgeti(L, -2, LPUGL_VIEW_UV_BACKEND);              /* -> uservalue, ?, backend */
         LpuglBackend* backend = lua_touserdata(L, -1);
         if (backend) backend->used -= 1;       
+        if (backend && backend->setRenderer) {
+            backend->setRenderer(L, backend, udata->puglView, 0);
+        }
+
+        bool isPooled = udata->isPopup && !udata->drawing && backend && udata->world
+                     && lpugl_viewpool_put(L, udata->world, udata->puglView, lua_gettop(L),
+                                           udata->useDoubleBuffer, udata->isResizable);
+        if (!isPooled) {
+            if (udata->world && udata->world->recorder) {
+                lpugl_record_forget_view(udata->world, udata->puglView);
+            }
+            puglFreeView(udata->puglView);
+        }
+        udata->puglView = NULL;
+
         lua_pushnil(L);                                         /* -> uservalue, ?, backend, nil */
         lua_rawseti(L, -4, LPUGL_VIEW_UV_BACKEND);              /* -> uservalue, ?, backend */
         lua_pop(L, 3);                                          /* -> */
@@ -780,6 +1018,9 @@ bool lpugl_view_close(lua_State* L, ViewUserData* udata, int udataIdx)
         lua_newtable(L);                                        /* -> empty table */
         lua_setuservalue(L, udataIdx);                          /* -> */
     }
+    if (udata->world && udata->world->eventTasks) {
+        lpugl_task_view_closed(udata->world, udata);
+    }
     bool wasClosedNow = (udata->world != NULL);
     udata->world = NULL;
     return wasClosedNow;
@@ -787,6 +1028,22 @@ bool lpugl_view_close(lua_State* L, ViewUserData* udata, int udataIdx)
 
 /* ============================================================================================ */
 
+PuglView* lpugl_view_get_pugl_view(lua_State* L, int idx)
+{
+    ViewUserData* udata = luaL_testudata(L, idx, LPUGL_VIEW_CLASS_NAME);
+    return udata ? udata->puglView : NULL;
+}
+
+/* ============================================================================================ */
+
+bool lpugl_view_is_drawing(lua_State* L, int idx)
+{
+    ViewUserData* udata = luaL_testudata(L, idx, LPUGL_VIEW_CLASS_NAME);
+    return udata && udata->drawing;
+}
+
+/* ============================================================================================ */
+
 static void closeView(lua_State* L, ViewUserData* udata, int udataIdx)
 {
     LpuglWorld* world = udata->world;
@@ -799,6 +1056,8 @@ static void closeView(lua_State* L, ViewUserData* udata, int udataIdx)
                                                     == LUA_TTABLE) {    /* -> weakWorld */
                 lua_pushnil(L);                                         /* -> weakWorld, nil */
                 lua_rawsetp(L, -2, udata);                              /* -> weakWorld */
+                lua_pushnil(L);                                         /* -> weakWorld, nil */
+                lua_rawseti(L, -2, udata->id);                          /* -> weakWorld */
                 
                 if (lua_rawgeti(L, -1, 0) == LUA_TUSERDATA) {           /* -> weakWorld, world */
                     if (lua_getuservalue(L, -1) == LUA_TTABLE) {        /* -> weakWorld, world, worldUservalue */
@@ -823,16 +1082,25 @@ static void closeView(lua_State* L, ViewUserData* udata, int udataIdx)
 
 static int View_close(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
     closeView(L, udata, 1);
     return 0;
 }
 
 /* ============================================================================================ */
 
+static int View_id(lua_State* L)
+{
+    ViewUserData* udata = checkViewUdata(L, 1);
+    lua_pushinteger(L, udata->id);
+    return 1;
+}
+
+/* ============================================================================================ */
+
 static int View_isClosed(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
     lua_pushboolean(L, udata->puglView == NULL);
     return 1;
 }
@@ -841,7 +1109,7 @@ static int View_isClosed(lua_State* L)
 
 static int View_isVisible(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
     }
@@ -852,7 +1120,7 @@ static int View_isVisible(lua_State* L)
 
 static int View_hasFocus(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
     }
@@ -864,7 +1132,7 @@ static int View_hasFocus(lua_State* L)
 
 static int View_grabFocus(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
     }
@@ -878,7 +1146,7 @@ static int View_grabFocus(lua_State* L)
 
 static int View_show(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
     }
@@ -892,7 +1160,7 @@ static int View_show(lua_State* L)
 
 static int View_hide(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
     }
@@ -906,18 +1174,45 @@ static int View_hide(lua_State* L)
 
 static int View_getDrawContext(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
     
     if (!udata->drawing) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "only allowed within exposure event handling");
     }
     void* ctx = puglGetContext(udata->puglView);
     if (ctx && udata->backend->newDrawContext) {
+        lua_settop(L, 1);                                                       /* -> view */
         lua_getuservalue(L, 1);                                                 /* -> view, uservalue */
-        if (lua_rawgeti(L, -1, LPUGL_VIEW_UV_DRAWCTX) == LUA_TNIL) {            /* -> view, uservalue, context */
+        if (lua_rawgeti(L, 2, LPUGL_VIEW_UV_DRAWCTX) != LUA_TUSERDATA) {        /* -> view, uservalue, context */
             lua_pop(L, 1);                                                      /* -> view, uservalue */
-            udata->backend->newDrawContext(L, ctx);                             /* -> view, uservalue, context */
+            udata->backend->newDrawContext(L);                                  /* -> view, uservalue, context */
+            lua_pushvalue(L, 3);                                                /* -> view, uservalue, context, context */
+            lua_rawseti(L, 2, LPUGL_VIEW_UV_DRAWCTX);                           /* -> view, uservalue, context */
         }
+        if (!udata->drawContextBound) {
+            lua_rawgeti(L, 2, LPUGL_VIEW_UV_BACKEND);                           /* -> view, uservalue, context, backend */
+            udata->backend->bindDrawContext(L, 3, 4, ctx);                      /* -> view, uservalue, context, backend */
+            lua_pop(L, 1);                                                      /* -> view, uservalue, context */
+            udata->drawContextBound = true;
+        }
+        return 1;
+    } else {
+        return 0;
+    }
+}
+
+/* ============================================================================================ */
+
+static int View_getBufferAge(lua_State* L)
+{
+    ViewUserData* udata = checkViewUdata(L, 1);
+    
+    if (!udata->drawing) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "only allowed within exposure event handling");
+    }
+    int age = puglGetBufferAge(udata->puglView);
+    if (age >= 0) {
+        lua_pushinteger(L, age);
         return 1;
     } else {
         return 0;
@@ -928,7 +1223,7 @@ static int View_getDrawContext(lua_State* L)
 
 static int View_getLayoutContext(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
 
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
@@ -950,7 +1245,7 @@ static int View_getLayoutContext(lua_State* L)
 
 static int View_setFrame(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
 
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
@@ -971,7 +1266,7 @@ static int View_setFrame(lua_State* L)
 
 static int View_setSize(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
 
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
@@ -989,7 +1284,7 @@ static int View_setSize(lua_State* L)
 
 static int View_getSize(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
 
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
@@ -1006,7 +1301,7 @@ static int View_getSize(lua_State* L)
 
 static int View_setMinSize(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
 
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
@@ -1024,7 +1319,7 @@ static int View_setMinSize(lua_State* L)
 
 static int View_setMaxSize(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
 
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
@@ -1042,7 +1337,7 @@ static int View_setMaxSize(lua_State* L)
 
 static int View_getFrame(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
 
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
@@ -1059,40 +1354,81 @@ static int View_getFrame(lua_State* L)
 
 /* ============================================================================================ */
 
-static int View_postRedisplay(lua_State* L)
+static bool deferRedisplay(ViewUserData* udata, PuglRect rect)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
-
-    if (!udata->puglView) {
-        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    if (!udata->deferHidden || udata->visible) {
+        return false;
     }
-    PuglStatus rc = PUGL_SUCCESS;
-    
-    if (lua_gettop(L) > 1) {
-        lua_Number arg_x = luaL_checknumber(L, 2);
-        lua_Number arg_y = luaL_checknumber(L, 3);
-        lua_Number arg_w = luaL_checknumber(L, 4);
-        lua_Number arg_h = luaL_checknumber(L, 5);
-        
-        int x  = (int)floor(arg_x);
-        int y  = (int)floor(arg_y);
-        int w  = (int)ceil(arg_x + arg_w) - x;
-        int h  = (int)ceil(arg_y + arg_h) - y;
+    if (!udata->hasDeferred) {
+        udata->hasDeferred  = true;
+        udata->deferredRect = rect;
+    } else {
+        PuglRect* r = &udata->deferredRect;
+        double x2 = fmax(r->x + r->width,  rect.x + rect.width);
+        double y2 = fmax(r->y + r->height, rect.y + rect.height);
+        r->x      = fmin(r->x, rect.x);
+        r->y      = fmin(r->y, rect.y);
+        r->width  = x2 - r->x;
+        r->height = y2 - r->y;
+    }
+    return true;
+}
+
+/*
+ * Posts a redisplay for the given rectangle in view coordinates or for the whole
+ * view if rect is NULL. Returns PUGL_SUCCESS for empty rectangles.
+ */
+static PuglStatus postRedisplay(ViewUserData* udata, const double* rect)
+{
+    if (rect) {
+        int x  = (int)floor(rect[0]);
+        int y  = (int)floor(rect[1]);
+        int w  = (int)ceil(rect[0] + rect[2]) - x;
+        int h  = (int)ceil(rect[1] + rect[3]) - y;
        
         if (x < 0)  { w += x; x = 0; }
         if (y < 0)  { h += y; y = 0; }
     
         if (w > 0 && h > 0) {
-            PuglRect rect;
-            rect.x      = x;
-            rect.y      = y;
-            rect.width  = w;
-            rect.height = h;
+            PuglRect r;
+            r.x      = x;
+            r.y      = y;
+            r.width  = w;
+            r.height = h;
     
-            rc = puglPostRedisplayRect(udata->puglView, rect);
+            if (!deferRedisplay(udata, r)) {
+                return puglPostRedisplayRect(udata->puglView, r);
+            }
         }
     } else {
-        rc = puglPostRedisplay(udata->puglView);
+        PuglRect r = puglGetFrame(udata->puglView);
+        r.x = 0;
+        r.y = 0;
+        if (!deferRedisplay(udata, r)) {
+            return puglPostRedisplay(udata->puglView);
+        }
+    }
+    return PUGL_SUCCESS;
+}
+
+static int View_postRedisplay(lua_State* L)
+{
+    ViewUserData* udata = checkViewUdata(L, 1);
+
+    if (!udata->puglView) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    PuglStatus rc;
+    
+    if (lua_gettop(L) > 1) {
+        double rect[4];
+        rect[0] = luaL_checknumber(L, 2);
+        rect[1] = luaL_checknumber(L, 3);
+        rect[2] = luaL_checknumber(L, 4);
+        rect[3] = luaL_checknumber(L, 5);
+        rc = postRedisplay(udata, rect);
+    } else {
+        rc = postRedisplay(udata, NULL);
     }
     if (rc != PUGL_SUCCESS) {
         return lpugl_ERROR_FAILED_OPERATION(L);
@@ -1100,11 +1436,220 @@ static int View_postRedisplay(lua_State* L)
     return 0;
 }
 
+/*
+ * Must be called on the world's thread. Returns false if there is no open view
+ * with the given id.
+ */
+bool lpugl_view_post_redisplay_id(lua_State* L, LpuglWorld* world, lua_Integer viewId, 
+                                  const double* rect)
+{
+    bool found = false;
+    int  top   = lua_gettop(L);
+    if (   world->weakWorldRef != LUA_REFNIL
+        && lua_rawgeti(L, LUA_REGISTRYINDEX, world->weakWorldRef) == LUA_TTABLE /* -> weakWorld */
+        && lua_rawgeti(L, -1, viewId) == LUA_TUSERDATA)                         /* -> weakWorld, viewUdata */
+    {
+        ViewUserData* udata = lua_touserdata(L, -1);
+        if (udata->puglView && udata->world == world) {
+            postRedisplay(udata, rect);
+            found = true;
+        }
+    }
+    lua_settop(L, top);                                                         /* -> */
+    return found;
+}
+
+/*
+ * Must be called on the world's thread. Invokes the event handling functions of all
+ * open views that use the given backend with the event name and the nargs values 
+ * starting at argsIdx, e.g. for events of the backend that are not caused by pugl. 
+ * Tasks waiting for these views are resumed afterwards.
+ */
+void lpugl_view_deliver_backend_event(lua_State* L, LpuglWorld* world, LpuglBackend* backend,
+                                      const char* eventName, int argsIdx, int nargs)
+{
+    int top = lua_gettop(L);
+    lua_checkstack(L, nargs + LUA_MINSTACK);
+    if (   world->weakWorldRef == LUA_REFNIL
+        || lua_rawgeti(L, LUA_REGISTRYINDEX, world->weakWorldRef) != LUA_TTABLE /* -> weakWorld */
+        || lua_rawgeti(L, -1, 0) != LUA_TUSERDATA                               /* -> weakWorld, worldUdata */
+        || lua_getuservalue(L, -1) != LUA_TTABLE)                               /* -> weakWorld, worldUdata, worldUservalue */
+    {
+        lua_settop(L, top);                                                     /* -> */
+        return;
+    }
+    int worldUservalue = lua_gettop(L);
+    lua_pushcfunction(L, lpugl_world_errormsghandler);                          /* -> ..., msgh */
+    int msgh = lua_gettop(L);
+
+    // event functions may close or create views, therefore the views are collected first
+    lua_newtable(L);                                                            /* -> ..., msgh, views */
+    int views = lua_gettop(L);
+    int count = 0;
+    lua_rawgeti(L, worldUservalue, LPUGL_WORLD_UV_VIEWS);                       /* -> ..., views, viewLookup */
+    lua_pushnil(L);                                                             /* -> ..., views, viewLookup, nil */
+    while (lua_next(L, -2)) {                                                   /* -> ..., views, viewLookup, key, view */
+        ViewUserData* udata = lua_touserdata(L, -1);
+        if (udata && udata->backend == backend) {
+            lua_rawseti(L, views, ++count);                                     /* -> ..., views, viewLookup, key */
+        } else {
+            lua_pop(L, 1);                                                      /* -> ..., views, viewLookup, key */
+        }
+    }                                                                           /* -> ..., views, viewLookup */
+    lua_pop(L, 1);                                                              /* -> ..., views */
+
+    bool wasInCallback = world->inCallback;
+    world->inCallback = true;
+    world->hadEvent   = true;
+
+    for (int v = 1; v <= count && world->weakWorldRef != LUA_REFNIL; ++v) {
+        lua_rawgeti(L, views, v);                                               /* -> ..., views, view */
+        int           udataIdx = lua_gettop(L);
+        ViewUserData* udata    = lua_touserdata(L, udataIdx);
+        int           n        = udata->eventFuncNargs;
+        if (udata->puglView && udata->world == world && n >= 0) {
+            lua_getuservalue(L, udataIdx);                                      /* -> ..., view, uservalue */
+            for (int i = 0; i <= n; ++i) {
+                lua_rawgeti(L, -1 - i, LPUGL_VIEW_UV_EVENTFUNC + i);
+            }                                                                   /* -> ..., view, uservalue, func, funcArgs... */
+            lua_pushvalue(L, udataIdx);
+            lua_pushstring(L, eventName);
+            for (int i = 0; i < nargs; ++i) {
+                lua_pushvalue(L, argsIdx + i);
+            }                                                                   /* -> ..., view, uservalue, func, funcArgs..., view, eventName, args... */
+            int rc = lua_pcall(L, n + 2 + nargs, 0, msgh);                      /* -> ..., view, uservalue, ? */
+            if (rc != 0) {                                                      /* -> ..., view, uservalue, error */
+                lpugl_world_handle_error(L, worldUservalue, msgh);              /* -> ..., view, uservalue */
+            }
+            if (world->eventTasks && world->weakWorldRef != LUA_REFNIL && world->puglWorld) {
+                lua_createtable(L, nargs + 1, 0);                               /* -> ..., view, uservalue, taskArgs */
+                lua_pushstring(L, eventName);
+                lua_rawseti(L, -2, 1);
+                for (int i = 0; i < nargs; ++i) {
+                    lua_pushvalue(L, argsIdx + i);
+                    lua_rawseti(L, -2, i + 2);
+                }
+                lpugl_task_deliver_event(L, world, udata, eventName, lua_gettop(L), nargs + 1);
+            }
+        }
+        lua_settop(L, views);                                                   /* -> ..., views */
+    }
+    world->inCallback = wasInCallback;
+    if (!wasInCallback && world->mustClosePugl) {
+        lpugl_world_close_pugl(world);
+    }
+    lua_settop(L, top);                                                         /* -> */
+}
+
+/* ============================================================================================ */
+
+static int View_scrollContents(lua_State* L)
+{
+    ViewUserData* udata = checkViewUdata(L, 1);
+
+    if (!udata->puglView) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    if (udata->drawing) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "not allowed within exposure event handling");
+    }
+    int dx = (int)luaL_checkinteger(L, 2);
+    int dy = (int)luaL_checkinteger(L, 3);
+
+    PuglRect rect = puglGetFrame(udata->puglView);
+    rect.x = 0;
+    rect.y = 0;
+
+    if (lua_gettop(L) > 3) {
+        rect.x      = (int)luaL_checkinteger(L, 4);
+        rect.y      = (int)luaL_checkinteger(L, 5);
+        rect.width  = (int)luaL_checkinteger(L, 6);
+        rect.height = (int)luaL_checkinteger(L, 7);
+    }
+    if (deferRedisplay(udata, rect)) {
+        lua_pushboolean(L, false);
+        return 1;
+    }
+    PuglStatus rc = puglScrollContents(udata->puglView, rect, dx, dy);
+    if (rc != PUGL_SUCCESS && rc != PUGL_UNSUPPORTED_TYPE) {
+        return lpugl_ERROR_FAILED_OPERATION(L);
+    }
+    lua_pushboolean(L, rc == PUGL_SUCCESS);
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int View_snapshot(lua_State* L)
+{
+    ViewUserData* udata = checkViewUdata(L, 1);
+
+    if (!udata->puglView) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    if (!udata->backend->newSnapshot) {
+        return lpugl_ERROR_FAILED_OPERATION_ex(L, "snapshot not supported by backend");
+    }
+    PuglRect frame = puglGetFrame(udata->puglView);
+
+    int x = 0;
+    int y = 0;
+    int w = (int)frame.width;
+    int h = (int)frame.height;
+
+    if (lua_gettop(L) > 1) {
+        x = (int)luaL_checkinteger(L, 2);
+        y = (int)luaL_checkinteger(L, 3);
+        w = (int)luaL_checkinteger(L, 4);
+        h = (int)luaL_checkinteger(L, 5);
+
+        if (x < 0)  { w += x; x = 0; }
+        if (y < 0)  { h += y; y = 0; }
+        if (x + w > (int)frame.width)  { w = (int)frame.width  - x; }
+        if (y + h > (int)frame.height) { h = (int)frame.height - y; }
+    }
+    if (w <= 0 || h <= 0) {
+        return luaL_argerror(L, 2, "empty rectangle");
+    }
+    PuglRect rect;
+    rect.x      = x;
+    rect.y      = y;
+    rect.width  = w;
+    rect.height = h;
+
+    LpuglSnapshot* snapshot = udata->backend->newSnapshot(udata->backend, udata->puglView,
+                                                          udata->drawing, rect, frame.height);
+    if (!snapshot) {
+        return lpugl_ERROR_FAILED_OPERATION(L);
+    }
+    return lpugl_snapshot_new(L, 1, snapshot);
+}
+
+/* ============================================================================================ */
+
+static int View_setRenderer(lua_State* L)
+{
+    ViewUserData* udata = checkViewUdata(L, 1);
+
+    if (!udata->puglView) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    if (!udata->backend->setRenderer) {
+        return lpugl_ERROR_FAILED_OPERATION_ex(L, "renderer not supported by backend");
+    }
+    bool hasRenderer = !lua_isnoneornil(L, 2);
+    udata->backend->setRenderer(L, udata->backend, udata->puglView, hasRenderer ? 2 : 0);
+    if (hasRenderer) {
+        puglPostRedisplay(udata->puglView);
+    }
+    return 0;
+}
+
 /* ============================================================================================ */
 
 static int View_requestClipboard(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
 
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
@@ -1116,9 +1661,383 @@ static int View_requestClipboard(lua_State* L)
 
 /* ============================================================================================ */
 
+static PuglEventType toInjectableEventType(lua_Integer type)
+{
+    switch (type) {
+        case PUGL_BUTTON_PRESS:
+        case PUGL_BUTTON_RELEASE:
+        case PUGL_KEY_PRESS:
+        case PUGL_KEY_RELEASE:
+        case PUGL_POINTER_IN:
+        case PUGL_POINTER_OUT:
+        case PUGL_MOTION:
+        case PUGL_SCROLL:
+        case PUGL_FOCUS_IN:
+        case PUGL_FOCUS_OUT:
+        case PUGL_EXPOSE:
+        case PUGL_CONFIGURE:
+        case PUGL_CLOSE:  return (PuglEventType)type;
+        default:          return PUGL_NOTHING;
+    }
+}
+
+static PuglEventType injectableEventTypeFromName(const char* name)
+{
+    if      (strcmp(name, "BUTTON_PRESS")   == 0) return PUGL_BUTTON_PRESS;
+    else if (strcmp(name, "BUTTON_RELEASE") == 0) return PUGL_BUTTON_RELEASE;
+    else if (strcmp(name, "KEY_PRESS")      == 0) return PUGL_KEY_PRESS;
+    else if (strcmp(name, "KEY_RELEASE")    == 0) return PUGL_KEY_RELEASE;
+    else if (strcmp(name, "POINTER_IN")     == 0) return PUGL_POINTER_IN;
+    else if (strcmp(name, "POINTER_OUT")    == 0) return PUGL_POINTER_OUT;
+    else if (strcmp(name, "MOTION")         == 0) return PUGL_MOTION;
+    else if (strcmp(name, "SCROLL")         == 0) return PUGL_SCROLL;
+    else if (strcmp(name, "FOCUS_IN")       == 0) return PUGL_FOCUS_IN;
+    else if (strcmp(name, "FOCUS_OUT")      == 0) return PUGL_FOCUS_OUT;
+    else if (strcmp(name, "EXPOSE")         == 0) return PUGL_EXPOSE;
+    else if (strcmp(name, "CONFIGURE")      == 0) return PUGL_CONFIGURE;
+    else if (strcmp(name, "CLOSE")          == 0) return PUGL_CLOSE;
+    else                                          return PUGL_NOTHING;
+}
+
+/* ============================================================================================ */
+
+/*
+ * Fills the event from the arguments in the order of the event handler
+ * arguments, see doc/README.md for view:injectEvent(). Returns false if the 
+ * event type cannot be injected.
+ */
+bool lpugl_view_init_injected_event(PuglView* view, lua_Integer type, const double* a, 
+                                    PuglEvent* event)
+{
+    if (toInjectableEventType(type) == PUGL_NOTHING) {
+        return false;
+    }
+    PuglRect frame = puglGetFrame(view);
+    double   time  = puglGetTime(puglGetWorld(view));
+
+    puglClearEventStruct(event, (PuglEventType)type);
+    event->any.flags = PUGL_IS_SEND_EVENT;
+
+    switch (type) {
+        case PUGL_BUTTON_PRESS:
+        case PUGL_BUTTON_RELEASE: {
+            event->button.time   = time;
+            event->button.x      = a[0];
+            event->button.y      = a[1];
+            event->button.xRoot  = frame.x + a[0];
+            event->button.yRoot  = frame.y + a[1];
+            event->button.button = (uint32_t)a[2];
+            event->button.state  = (PuglMods)a[3];
+            break;
+        }
+        case PUGL_KEY_PRESS:
+        case PUGL_KEY_RELEASE: {
+            event->key.time  = time;
+            event->key.key   = (uint32_t)a[0];
+            event->key.state = (PuglMods)a[1];
+            break;
+        }
+        case PUGL_POINTER_IN:
+        case PUGL_POINTER_OUT: {
+            event->crossing.time  = time;
+            event->crossing.x     = a[0];
+            event->crossing.y     = a[1];
+            event->crossing.xRoot = frame.x + a[0];
+            event->crossing.yRoot = frame.y + a[1];
+            event->crossing.state = (PuglMods)a[2];
+            event->crossing.mode  = PUGL_CROSSING_NORMAL;
+            break;
+        }
+        case PUGL_MOTION: {
+            event->motion.time  = time;
+            event->motion.x     = a[0];
+            event->motion.y     = a[1];
+            event->motion.xRoot = frame.x + a[0];
+            event->motion.yRoot = frame.y + a[1];
+            event->motion.state = (PuglMods)a[2];
+            break;
+        }
+        case PUGL_SCROLL: {
+            event->scroll.time      = time;
+            event->scroll.dx        = a[0];
+            event->scroll.dy        = a[1];
+            event->scroll.x         = a[2];
+            event->scroll.y         = a[3];
+            event->scroll.xRoot     = frame.x + a[2];
+            event->scroll.yRoot     = frame.y + a[3];
+            event->scroll.direction = PUGL_SCROLL_SMOOTH;
+            break;
+        }
+        case PUGL_EXPOSE: {
+            event->expose.x      = a[0];
+            event->expose.y      = a[1];
+            event->expose.width  = a[2];
+            event->expose.height = a[3];
+            break;
+        }
+        case PUGL_CONFIGURE: {
+            event->configure.x      = a[0];
+            event->configure.y      = a[1];
+            event->configure.width  = a[2];
+            event->configure.height = a[3];
+            break;
+        }
+        default:
+            break;
+    }
+    return true;
+}
+
+/* ============================================================================================ */
+
+/*
+ * Inverse of lpugl_view_init_injected_event(), returns false if the 
+ * event type cannot be injected.
+ */
+bool lpugl_view_get_injected_args(const PuglEvent* event, double* a)
+{
+    a[0] = a[1] = a[2] = a[3] = 0;
+    
+    switch (toInjectableEventType(event->type)) {
+        case PUGL_BUTTON_PRESS:
+        case PUGL_BUTTON_RELEASE: {
+            a[0] = event->button.x;
+            a[1] = event->button.y;
+            a[2] = event->button.button;
+            a[3] = event->button.state;
+            return true;
+        }
+        case PUGL_KEY_PRESS:
+        case PUGL_KEY_RELEASE: {
+            a[0] = event->key.key;
+            a[1] = event->key.state;
+            return true;
+        }
+        case PUGL_POINTER_IN:
+        case PUGL_POINTER_OUT: {
+            a[0] = event->crossing.x;
+            a[1] = event->crossing.y;
+            a[2] = event->crossing.state;
+            return true;
+        }
+        case PUGL_MOTION: {
+            a[0] = event->motion.x;
+            a[1] = event->motion.y;
+            a[2] = event->motion.state;
+            return true;
+        }
+        case PUGL_SCROLL: {
+            a[0] = event->scroll.dx;
+            a[1] = event->scroll.dy;
+            a[2] = event->scroll.x;
+            a[3] = event->scroll.y;
+            return true;
+        }
+        case PUGL_EXPOSE: {
+            a[0] = event->expose.x;
+            a[1] = event->expose.y;
+            a[2] = event->expose.width;
+            a[3] = event->expose.height;
+            return true;
+        }
+        case PUGL_CONFIGURE: {
+            a[0] = event->configure.x;
+            a[1] = event->configure.y;
+            a[2] = event->configure.width;
+            a[3] = event->configure.height;
+            return true;
+        }
+        case PUGL_FOCUS_IN:
+        case PUGL_FOCUS_OUT:
+        case PUGL_CLOSE: {
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+/* ============================================================================================ */
+
+static void injectEvents(LpuglWorld* world, const PuglInjectedEvent* events, size_t count)
+{
+    bool wasInCallback = world->inCallback;
+    world->inCallback = true;
+
+    puglInjectEvents(world->puglWorld, events, count);
+
+    world->inCallback = wasInCallback;
+    if (!wasInCallback && world->mustClosePugl) {
+        lpugl_world_close_pugl(world);
+    }
+}
+
+/* ============================================================================================ */
+
+static int View_injectEvent(lua_State* L)
+{
+    ViewUserData* udata = checkViewUdata(L, 1);
+
+    if (!udata->puglView) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    if (udata->drawing) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "not allowed within exposure event handling");
+    }
+    const char*   typeName = luaL_checkstring(L, 2);
+    PuglEventType type     = injectableEventTypeFromName(typeName);
+    if (type == PUGL_NOTHING) {
+        return luaL_argerror(L, 2, lua_pushfstring(L, "invalid event type '%s'", typeName));
+    }
+    double      a[4] = {0};
+    size_t      inputLength = 0;
+    const char* input = NULL;
+    
+    switch (type) {
+        case PUGL_BUTTON_PRESS:
+        case PUGL_BUTTON_RELEASE: {
+            a[0] = luaL_checknumber(L, 3);
+            a[1] = luaL_checknumber(L, 4);
+            a[2] = luaL_checkinteger(L, 5);
+            a[3] = luaL_optinteger(L, 6, 0);
+            break;
+        }
+        case PUGL_KEY_PRESS:
+        case PUGL_KEY_RELEASE: {
+            if (!lua_isnil(L, 3)) {
+                size_t      len;
+                const char* key = luaL_checklstring(L, 3, &len);
+                uint32_t    c   = puglNameToKey(key);
+                if (!c && !convertUtf8ToUnicodeChar(key, len, &c)) {
+                    return luaL_argerror(L, 3, lua_pushfstring(L, "invalid key '%s'", key));
+                }
+                a[0] = c;
+            }
+            a[1]  = luaL_optinteger(L, 4, 0);
+            input = luaL_optlstring(L, 5, NULL, &inputLength);
+            break;
+        }
+        case PUGL_POINTER_IN:
+        case PUGL_POINTER_OUT:
+        case PUGL_MOTION: {
+            a[0] = luaL_checknumber(L, 3);
+            a[1] = luaL_checknumber(L, 4);
+            a[2] = luaL_optinteger(L, 5, 0);
+            break;
+        }
+        case PUGL_SCROLL: {
+            a[0] = luaL_checknumber(L, 3);
+            a[1] = luaL_checknumber(L, 4);
+            a[2] = luaL_optnumber(L, 5, 0);
+            a[3] = luaL_optnumber(L, 6, 0);
+            break;
+        }
+        case PUGL_EXPOSE:
+        case PUGL_CONFIGURE: {
+            if (type == PUGL_EXPOSE && lua_gettop(L) <= 2) {
+                PuglRect frame = puglGetFrame(udata->puglView);
+                a[2] = frame.width;
+                a[3] = frame.height;
+            } else {
+                a[0] = luaL_checknumber(L, 3);
+                a[1] = luaL_checknumber(L, 4);
+                a[2] = luaL_checknumber(L, 5);
+                a[3] = luaL_checknumber(L, 6);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    PuglInjectedEvent e;
+    e.view = udata->puglView;
+    lpugl_view_init_injected_event(udata->puglView, type, a, &e.event);
+
+    if (inputLength > 0) {
+        if (inputLength <= 8) {
+            memcpy(e.event.key.input.data, input, inputLength);
+        } else {
+            e.event.key.input.ptr = malloc(inputLength); // freed by Pugl after dispatching
+            if (!e.event.key.input.ptr) {
+                return lpugl_ERROR_OUT_OF_MEMORY(L);
+            }
+            memcpy(e.event.key.input.ptr, input, inputLength);
+        }
+        e.event.key.inputLength = inputLength;
+    }
+    injectEvents(udata->world, &e, 1);
+    
+    return 0;
+}
+
+/* ============================================================================================ */
+
+int lpugl_view_inject_events(lua_State* L, LpuglWorld* world, int dataIdx, int viewsIdx)
+{
+    size_t      len;
+    const char* data = luaL_checklstring(L, dataIdx, &len);
+    if (len % LPUGL_INJECT_RECORD_SIZE != 0) {
+        return luaL_argerror(L, dataIdx, "invalid data length");
+    }
+    size_t count = len / LPUGL_INJECT_RECORD_SIZE;
+    
+    lua_Integer viewsCount = 1;
+    bool        viewsTable = lua_istable(L, viewsIdx);
+    if (viewsTable) {
+        viewsCount = luaL_len(L, viewsIdx);
+    }
+    PuglView** views = lua_newuserdata(L, (viewsCount > 0 ? viewsCount : 1) * sizeof(PuglView*));
+    for (lua_Integer i = 1; i <= viewsCount; ++i) {
+        if (viewsTable) {
+            lua_rawgeti(L, viewsIdx, i);                   /* -> views, view */
+        } else {
+            lua_pushvalue(L, viewsIdx);                    /* -> views, view */
+        }
+        ViewUserData* udata = luaL_testudata(L, -1, LPUGL_VIEW_CLASS_NAME);
+        if (!udata) {
+            return luaL_argerror(L, viewsIdx, "view or list of views expected");
+        }
+        if (!udata->puglView || udata->world != world) {
+            return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+        }
+        if (udata->drawing) {
+            return lpugl_ERROR_ILLEGAL_STATE(L, "not allowed within exposure event handling");
+        }
+        views[i - 1] = udata->puglView;
+        lua_pop(L, 1);                                     /* -> views */
+    }
+    PuglInjectedEvent* events = lua_newuserdata(L, (count > 0 ? count : 1) 
+                                                    * sizeof(PuglInjectedEvent));
+                                                           /* -> views, events */
+    for (size_t i = 0; i < count; ++i) {
+        const char* record = data + i * LPUGL_INJECT_RECORD_SIZE;
+        int32_t     viewIndex;
+        int32_t     type;
+        double      a[4];
+        memcpy(&viewIndex, record,     sizeof(int32_t));
+        memcpy(&type,      record + 4, sizeof(int32_t));
+        memcpy(a,          record + 8, sizeof(a));
+        
+        if (viewIndex < 1 || viewIndex > viewsCount) {
+            return luaL_error(L, "invalid view index %d in event record %d", (int)viewIndex, (int)(i + 1));
+        }
+        events[i].view = views[viewIndex - 1];
+        if (!lpugl_view_init_injected_event(events[i].view, type, a, &events[i].event)) {
+            return luaL_error(L, "invalid event type %d in event record %d", (int)type, (int)(i + 1));
+        }
+    }
+    injectEvents(world, events, count);
+    
+    lua_pop(L, 2);                                         /* -> */
+    return 0;
+}
+
+/* ============================================================================================ */
+
 static int View_getBackend(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
 
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
@@ -1132,7 +2051,7 @@ static int View_getBackend(lua_State* L)
 
 static int View_setTitle(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
     }
@@ -1149,6 +2068,56 @@ static int View_setTitle(lua_State* L)
 
 /* ============================================================================================ */
 
+static int View_getSwapInterval(lua_State* L)
+{
+    ViewUserData* udata = checkViewUdata(L, 1);
+    if (!udata->puglView) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    int interval = puglGetViewHint(udata->puglView, PUGL_SWAP_INTERVAL);
+    if (interval != PUGL_DONT_CARE) {
+        if (puglGetViewHint(udata->puglView, PUGL_ADAPTIVE_SYNC) == PUGL_TRUE) {
+            interval = -interval;
+        }
+        lua_pushinteger(L, interval);
+        return 1;
+    } else {
+        return 0;
+    }
+}
+
+/* ============================================================================================ */
+
+static int View_setSwapInterval(lua_State* L)
+{
+    ViewUserData* udata = checkViewUdata(L, 1);
+    if (!udata->puglView) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    int interval = luaL_checkinteger(L, 2);
+    if (puglSetSwapInterval(udata->puglView, interval) == PUGL_SUCCESS) {
+        return View_getSwapInterval(L);
+    } else {
+        return 0;
+    }
+}
+
+/* ============================================================================================ */
+
+static int View_setMaxFramesInFlight(lua_State* L)
+{
+    ViewUserData* udata = checkViewUdata(L, 1);
+    if (!udata->puglView) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    int maxFrames = luaL_checkinteger(L, 2);
+    luaL_argcheck(L, maxFrames >= 0, 2, "must not be negative");
+    puglSetViewHint(udata->puglView, PUGL_MAX_FRAMES_IN_FLIGHT, maxFrames);
+    return 0;
+}
+
+/* ============================================================================================ */
+
 static const char* cursorOptions[] = 
 {
     "ARROW",
@@ -1164,7 +2133,7 @@ static const char* cursorOptions[] =
 
 static int View_setCursor(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
     }
@@ -1179,7 +2148,7 @@ static int View_setCursor(lua_State* L)
 
 static int View_toString(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
     lua_pushfstring(L, "%s: %p", LPUGL_VIEW_CLASS_NAME, udata);
     return 1;
 }
@@ -1188,7 +2157,7 @@ static int View_toString(lua_State* L)
 
 static int View_getScreenScale(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
     }
@@ -1200,7 +2169,7 @@ static int View_getScreenScale(lua_State* L)
 
 static int View_getNativeHandle(lua_State* L)
 {
-    ViewUserData* udata = luaL_checkudata(L, 1, LPUGL_VIEW_CLASS_NAME);
+    ViewUserData* udata = checkViewUdata(L, 1);
     if (!udata->puglView) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
     }
@@ -1216,10 +2185,12 @@ static const luaL_Reg ViewMethods[] =
     { "hide",               View_hide         },
     { "close",              View_close        },
     { "isClosed",           View_isClosed     },
+    { "id",                 View_id           },
     { "isVisible",          View_isVisible    },
     { "hasFocus",           View_hasFocus     },
     { "grabFocus",          View_grabFocus    },
     { "getDrawContext",     View_getDrawContext   },
+    { "getBufferAge",       View_getBufferAge     },
     { "getLayoutContext",   View_getLayoutContext },
     { "setFrame",           View_setFrame        },
     { "getFrame",           View_getFrame        },
@@ -1230,8 +2201,15 @@ static const luaL_Reg ViewMethods[] =
     { "setMaxSize",         View_setMaxSize      },
     { "setTitle",           View_setTitle        },
     { "setCursor",          View_setCursor       },
+    { "setSwapInterval",    View_setSwapInterval },
+    { "getSwapInterval",    View_getSwapInterval },
+    { "setMaxFramesInFlight", View_setMaxFramesInFlight },
     { "getBackend",         View_getBackend      },
     { "postRedisplay",      View_postRedisplay   },
+    { "scrollContents",     View_scrollContents  },
+    { "snapshot",           View_snapshot        },
+    { "setRenderer",        View_setRenderer     },
+    { "injectEvent",        View_injectEvent     },
     { "requestClipboard",   View_requestClipboard},
     { "getNativeHandle",    View_getNativeHandle },
     
@@ -1255,10 +2233,12 @@ static void setupViewMeta(lua_State* L)
     lua_pushstring(L, LPUGL_VIEW_CLASS_NAME);
     lua_setfield(L, -2, "__metatable");
 
-    luaL_setfuncs(L, ViewMetaMethods, 0);
+    lua_pushvalue(L, -1);
+    luaL_setfuncs(L, ViewMetaMethods, 1);
     
-    lua_newtable(L);  /* BackendClass */
-        luaL_setfuncs(L, ViewMethods, 0);
+    lua_newtable(L);  /* ViewClass */
+        lua_pushvalue(L, -2);
+        luaL_setfuncs(L, ViewMethods, 1);
     lua_setfield (L, -2, "__index");
 }
 
@@ -6,6 +6,7 @@
 #include "pugl/pugl.h"
 
 struct LpuglWorld;
+struct LpuglBackend;
 struct ViewUserData;
 
 /* ============================================================================================ */
@@ -16,6 +17,9 @@ struct ViewUserData;
 #define LPUGL_VIEW_UV_DRAWCTX     -1
 #define LPUGL_VIEW_UV_EVENTFUNC    0
 
+//  int32 view index, int32 event type, 4 doubles event data
+#define LPUGL_INJECT_RECORD_SIZE  40
+
 /* ============================================================================================ */
 
 int lpugl_view_init_module(lua_State* L, int module);
@@ -24,5 +28,23 @@ int lpugl_view_new(lua_State* L, struct LpuglWorld* world, int initArg, int view
 
 bool lpugl_view_close(lua_State* L, struct ViewUserData* udata, int udataIdx);
 
+PuglView* lpugl_view_get_pugl_view(lua_State* L, int idx);
+
+bool lpugl_view_is_drawing(lua_State* L, int idx);
+
+bool lpugl_view_post_redisplay_id(lua_State* L, struct LpuglWorld* world, lua_Integer viewId, 
+                                  const double* rect);
+
+void lpugl_view_deliver_backend_event(lua_State* L, struct LpuglWorld* world, 
+                                      struct LpuglBackend* backend, const char* eventName,
+                                      int argsIdx, int nargs);
+
+bool lpugl_view_init_injected_event(PuglView* view, lua_Integer type, const double* a, 
+                                    PuglEvent* event);
+
+bool lpugl_view_get_injected_args(const PuglEvent* event, double* a);
+
+int lpugl_view_inject_events(lua_State* L, struct LpuglWorld* world, int dataIdx, int viewsIdx);
+
 
 #endif /* LPUGL_VIEW_H */
@@ -0,0 +1,202 @@
+#include "base.h"
+
+#include "pugl/pugl.h"
+
+#include "viewpool.h"
+#include "world.h"
+#include "backend.h"
+#include "record.h"
+#include "error.h"
+
+/* ============================================================================================ */
+
+typedef struct LpuglPooledView {
+    PuglView*     puglView;
+    LpuglBackend* backend;
+    int           backendRef;   // keeps the backend object alive
+    bool          doubleBuffer;
+    bool          resizable;
+} LpuglPooledView;
+
+typedef struct LpuglViewPool {
+    int              size;
+    int              count;
+    LpuglPooledView* views;
+} LpuglViewPool;
+
+/* ============================================================================================ */
+
+static PuglStatus handlePooledEvent(PuglView* LPUGL_UNUSED(view), const PuglEvent* LPUGL_UNUSED(event))
+{
+    return PUGL_SUCCESS; // hidden view without lua object
+}
+
+/* ============================================================================================ */
+
+static void freePooledView(lua_State* L, LpuglPooledView* entry)
+{
+    puglFreeView(entry->puglView);
+    luaL_unref(L, LUA_REGISTRYINDEX, entry->backendRef);
+    entry->puglView   = NULL;
+    entry->backendRef = LUA_REFNIL;
+}
+
+/* ============================================================================================ */
+
+bool lpugl_viewpool_set_size(lua_State* L, LpuglWorld* world, int size)
+{
+    LpuglViewPool* pool = world->viewPool;
+    if (size <= 0) {
+        if (pool) {
+            for (int i = 0; i < pool->count; ++i) {
+                freePooledView(L, pool->views + i);
+            }
+            free(pool->views);
+            free(pool);
+            world->viewPool = NULL;
+        }
+        return true;
+    }
+    if (!pool) {
+        pool = calloc(1, sizeof(LpuglViewPool));
+        if (!pool) {
+            return false;
+        }
+        world->viewPool = pool;
+    }
+    while (pool->count > size) {
+        freePooledView(L, pool->views + --pool->count); // drop the most recent views
+    }
+    LpuglPooledView* views = realloc(pool->views, size * sizeof(LpuglPooledView));
+    if (!views) {
+        return false;
+    }
+    pool->views = views;
+    pool->size  = size;
+    return true;
+}
+
+/* ============================================================================================ */
+
+void lpugl_viewpool_get_size(LpuglWorld* world, int* size, int* count)
+{
+    LpuglViewPool* pool = world->viewPool;
+    *size  = pool ? pool->size  : 0;
+    *count = pool ? pool->count : 0;
+}
+
+/* ============================================================================================ */
+
+PuglView* lpugl_viewpool_take(lua_State* L, LpuglWorld* world, LpuglBackend* backend,
+                              bool doubleBuffer, bool resizable)
+{
+    LpuglViewPool* pool = world->viewPool;
+    if (!pool || !backend) {
+        return NULL;
+    }
+    for (int i = pool->count - 1; i >= 0; --i) {
+        LpuglPooledView* entry = pool->views + i;
+        if (   entry->backend      == backend
+            && entry->doubleBuffer == doubleBuffer
+            && entry->resizable    == resizable)
+        {
+            PuglView* view = entry->puglView;
+            luaL_unref(L, LUA_REGISTRYINDEX, entry->backendRef);
+            pool->count -= 1;
+            memmove(entry, entry + 1, (pool->count - i) * sizeof(LpuglPooledView));
+
+            // reset settings that a new view would get from its options
+            puglSetViewHint(view, PUGL_DONT_MERGE_RECTS,     false);
+            puglSetViewHint(view, PUGL_PARTIAL_PRESENT,      false);
+            puglSetViewHint(view, PUGL_SKIP_STALE_EXPOSE,    false);
+            puglSetViewHint(view, PUGL_MAX_FRAMES_IN_FLIGHT, 0);
+            puglSetBackgroundColor(view, -1);
+            puglSetMinSize(view, 1, 1);
+            puglSetMaxSize(view, 0, 0);
+            if (puglGetViewHint(view, PUGL_SWAP_INTERVAL) != PUGL_DONT_CARE) {
+                puglSetSwapInterval(view, 1); // default of GLX/WGL_EXT_swap_control
+            }
+            puglDiscardRedisplay(view);
+            return view;
+        }
+    }
+    return NULL;
+}
+
+/* ============================================================================================ */
+
+bool lpugl_viewpool_put(lua_State* L, LpuglWorld* world, PuglView* view, int backendIdx,
+                        bool doubleBuffer, bool resizable)
+{
+    LpuglViewPool* pool    = world->viewPool;
+    LpuglBackend*  backend = lua_touserdata(L, backendIdx);
+    if (!pool || pool->count >= pool->size || !backend || !backend->world) {
+        return false;
+    }
+    if (world->recorder) {
+        lpugl_record_forget_view(world, view);
+    }
+    puglHide(view);
+    puglSetHandle(view, NULL);
+    puglSetEventFunc(view, handlePooledEvent);
+
+    LpuglPooledView* entry = pool->views + pool->count++;
+    entry->puglView     = view;
+    entry->backend      = backend;
+    entry->doubleBuffer = doubleBuffer;
+    entry->resizable    = resizable;
+    lua_pushvalue(L, backendIdx);
+    entry->backendRef   = luaL_ref(L, LUA_REGISTRYINDEX);
+    return true;
+}
+
+/* ============================================================================================ */
+
+void lpugl_viewpool_release(lua_State* L, LpuglWorld* world, LpuglBackend* backend)
+{
+    LpuglViewPool* pool = world->viewPool;
+    if (pool) {
+        int j = 0;
+        for (int i = 0; i < pool->count; ++i) {
+            LpuglPooledView* entry = pool->views + i;
+            if (!backend || entry->backend == backend) {
+                freePooledView(L, entry);
+            } else {
+                pool->views[j++] = *entry;
+            }
+        }
+        pool->count = j;
+    }
+}
+
+/* ============================================================================================ */
+
+int lpugl_viewpool_fill(lua_State* L, LpuglWorld* world, int count, int backendIdx,
+                        bool doubleBuffer, bool resizable)
+{
+    LpuglViewPool* pool    = world->viewPool;
+    LpuglBackend*  backend = lua_touserdata(L, backendIdx);
+    int            added   = 0;
+
+    while (pool && pool->count < pool->size && added < count) {
+        PuglView* view = puglNewView(world->puglWorld);
+        if (!view) {
+            return lpugl_ERROR_FAILED_OPERATION(L);
+        }
+        puglSetEventFunc(view, handlePooledEvent);
+        puglSetViewHint(view, PUGL_IS_POPUP,      true);
+        puglSetViewHint(view, PUGL_RESIZABLE,     resizable);
+        puglSetViewHint(view, PUGL_DOUBLE_BUFFER, doubleBuffer);
+        puglSetBackend(view, backend->puglBackend);
+        puglSetBackendData(view, backend->puglBackendData);
+        if (puglRealize(view) != PUGL_SUCCESS) {
+            puglFreeView(view);
+            return lpugl_ERROR_FAILED_OPERATION(L);
+        }
+        lpugl_viewpool_put(L, world, view, backendIdx, doubleBuffer, resizable);
+        added += 1;
+    }
+    return added;
+}
+
+/* ============================================================================================ */
@@ -0,0 +1,36 @@
+#ifndef LPUGL_VIEWPOOL_H
+#define LPUGL_VIEWPOOL_H
+
+#include "base.h"
+
+#include "pugl/pugl.h"
+
+struct LpuglWorld;
+struct LpuglBackend;
+
+/* ============================================================================================ */
+
+/*
+ * Pool of realized but hidden popup views. Closed popup views are kept with their
+ * native window and backend surface and are reused for new popup views with the same
+ * backend and the same creation hints.
+ */
+
+bool lpugl_viewpool_set_size(lua_State* L, struct LpuglWorld* world, int size);
+
+void lpugl_viewpool_get_size(struct LpuglWorld* world, int* size, int* count);
+
+PuglView* lpugl_viewpool_take(lua_State* L, struct LpuglWorld* world, struct LpuglBackend* backend,
+                              bool doubleBuffer, bool resizable);
+
+bool lpugl_viewpool_put(lua_State* L, struct LpuglWorld* world, PuglView* view, int backendIdx,
+                        bool doubleBuffer, bool resizable);
+
+void lpugl_viewpool_release(lua_State* L, struct LpuglWorld* world, struct LpuglBackend* backend);
+
+int lpugl_viewpool_fill(lua_State* L, struct LpuglWorld* world, int count, int backendIdx,
+                        bool doubleBuffer, bool resizable);
+
+/* ============================================================================================ */
+
+#endif /* LPUGL_VIEWPOOL_H */
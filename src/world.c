@@ -5,6 +5,12 @@
 #include "lpugl.h"
 #include "world.h"
 #include "view.h"
+#include "record.h"
+#include "viewpool.h"
+#include "worldmap.h"
+#include "channel.h"
+#include "triplebuf.h"
+#include "task.h"
 #include "error.h"
 #include "version.h"
 #include "backend.h"
@@ -14,10 +20,6 @@
 
 static const char* const LPUGL_WORLD_CLASS_NAME = "lpugl.world";
 
-static LpuglWorld* global_world_list = NULL;
-
-/* ============================================================================================ */
-
 static void setupWorldMeta(lua_State* L);
 
 static int pushWorldMeta(lua_State* L)
@@ -30,6 +32,24 @@ static int pushWorldMeta(lua_State* L)
 
 /* ============================================================================================ */
 
+/*
+ * World methods have the world meta table as first upvalue, see checkViewUdata() in view.c
+ */
+static WorldUserData* checkWorldUdata(lua_State* L, int idx)
+{
+    void* udata = lua_touserdata(L, idx);
+    if (udata && lua_getmetatable(L, idx)) {                    /* -> meta */
+        bool isWorld = lua_rawequal(L, -1, lua_upvalueindex(1));
+        lua_pop(L, 1);                                          /* -> */
+        if (isWorld) {
+            return udata;
+        }
+    }
+    return luaL_checkudata(L, idx, LPUGL_WORLD_CLASS_NAME);
+}
+
+/* ============================================================================================ */
+
 static const char* toLuaString(lua_State* L, WorldUserData* udata)
 {
     if (udata) {
@@ -132,6 +152,168 @@ static void lpugl_world_log(PuglWorld*   puglWorld,
     }
 }
 
+/*
+ * Passes an error of a backend, e.g. of a painter that was invoked while leaving
+ * an exposure, to the world's log function. Must be called on the world's thread.
+ */
+static void logBackendError(LpuglWorld* world, const char* msg)
+{
+    if (world->puglWorld) {
+        lpugl_world_log(world->puglWorld, PUGL_LOG_LEVEL_ERR, msg);
+    } else {
+        fprintf(stderr, "lpugl: %s\n", msg);
+    }
+}
+
+#define LPUGL_REQUEST_REDISPLAY     1
+#define LPUGL_REQUEST_PROCESS_TIME  2
+
+/*
+ * Request from a restricted world object, possibly in another thread.
+ */
+typedef struct LpuglWorldRequest {
+    struct LpuglWorldRequest* next;
+    int                       type;
+    bool                      hasRect;
+    lua_Integer               viewId;
+    double                    args[4];  // redisplay rect or process time in seconds
+} LpuglWorldRequest;
+
+/*
+ * Signals the event loop once until the next process event, returns 1 if the 
+ * world is closed. Can be called from any thread.
+ */
+static int sendAwake(LpuglWorld* world)
+{
+    int rc = 0;
+    async_lock_acquire(&world->lock);
+        if (world->puglWorld) {
+            if (atomic_set_if_equal(&world->awakeSent, 0, 1)) {
+                puglAwake(world->puglWorld);
+            }
+        } else {
+            rc = 1; // world closed
+        }
+    async_lock_release(&world->lock);
+    return rc;
+}
+
+/*
+ * Can be called from any thread, returns 1 if the world is closed. Awakes 
+ * only for handling the request, i.e. the process function is not invoked.
+ */
+static int pushRequest(LpuglWorld* world, LpuglWorldRequest* request)
+{
+    LpuglWorldRequest* head;
+    do {
+        head = atomic_get_ptr(&world->requests);
+        request->next = head;
+    } while (!atomic_set_ptr_if_equal(&world->requests, head, request));
+
+    if (atomic_get(&world->awakeSent) == 0) {
+        return sendAwake(world);
+    }
+    return 0;
+}
+
+/*
+ * Takes all pending requests, returns them in the order they were pushed.
+ */
+static LpuglWorldRequest* takeRequests(LpuglWorld* world)
+{
+    LpuglWorldRequest* requests;
+    do {
+        requests = atomic_get_ptr(&world->requests);
+    } while (requests && !atomic_set_ptr_if_equal(&world->requests, requests, NULL));
+
+    LpuglWorldRequest* rslt = NULL;
+    while (requests) {
+        LpuglWorldRequest* next = requests->next;
+        requests->next = rslt;
+        rslt = requests;
+        requests = next;
+    }
+    return rslt;
+}
+
+static void handleRequests(lua_State* L, LpuglWorld* world)
+{
+    LpuglWorldRequest* request = takeRequests(world);
+    double processTime = -1;
+    while (request) {
+        LpuglWorldRequest* next = request->next;
+        if (request->type == LPUGL_REQUEST_REDISPLAY) {
+            lpugl_view_post_redisplay_id(L, world, request->viewId, 
+                                         request->hasRect ? request->args : NULL);
+        } else if (processTime < 0 || request->args[0] < processTime) {
+            processTime = request->args[0];
+        }
+        free(request);
+        request = next;
+    }
+    if (processTime >= 0) {
+        // requests from other threads cannot postpone the next process time
+        double t = puglGetTime(world->puglWorld) + processTime;
+        if (world->nextProcessTime < 0 || t < world->nextProcessTime) {
+            world->nextProcessTime = t;
+            lpugl_world_schedule_process(world);
+        }
+    }
+}
+
+/* ============================================================================================ */
+
+/*
+ * Sets pugl's process timer to the earlier of the next process time and the
+ * time of the next sleeping task.
+ */
+void lpugl_world_schedule_process(LpuglWorld* world)
+{
+    if (!world->puglWorld) {
+        return;
+    }
+    double t        = world->nextProcessTime;
+    double taskTime = lpugl_task_next_time(world);
+    if (taskTime >= 0 && (t < 0 || taskTime < t)) {
+        t = taskTime;
+    }
+    if (t >= 0) {
+        double seconds = t - puglGetTime(world->puglWorld);
+        puglSetNextProcessTime(world->puglWorld, (seconds > 0) ? seconds : 0);
+    } else {
+        puglSetNextProcessTime(world->puglWorld, -1);
+    }
+}
+
+/* ============================================================================================ */
+
+void lpugl_world_handle_error(lua_State* L, int worldUservalueIdx, int msgh)
+{                                                                           /* -> error */
+    int  top     = lua_gettop(L);
+    bool handled = false;
+    if (lua_rawgeti(L, worldUservalueIdx, LPUGL_WORLD_UV_ERRFUNC) == LUA_TFUNCTION) { /* -> error, errFunc */
+        lua_rawgeti(L, top, 1);                                             /* -> error, errFunc, error[1] */
+        lua_rawgeti(L, top, 2);                                             /* -> error, errFunc, error[1], error[2] */
+        int rc2 = lua_pcall(L, 2, 0, msgh);                                 /* -> error, ? */
+        if (rc2 == 0) {                                                     /* -> error */
+            handled = true;
+        } else {                                                            /* -> error, error2 */
+            lua_rawgeti(L, -1, 1);                                          /* -> error, error2, errmsg2 */
+            fprintf(stderr, 
+                    "lpugl: %s: %s\n", LPUGL_ERROR_ERROR_IN_ERROR_HANDLING,
+                    lua_tostring(L, -1));
+        }
+    }
+    if (!handled) {
+        lua_rawgeti(L, top, 1);                                             /* -> error, ..., errmsg */
+        fprintf(stderr, 
+                "lpugl: %s: %s\n", LPUGL_ERROR_ERROR_IN_EVENT_HANDLING,
+                lua_tostring(L, -1));
+        abort();
+    }
+    lua_settop(L, top - 1);                                                 /* -> */
+}
+
 static PuglStatus lpugl_world_process(PuglWorld* puglWorld, void* voidData)
 {
     LpuglWorld* world = voidData;
@@ -143,9 +325,20 @@ static PuglStatus lpugl_world_process(PuglWorld* puglWorld, void* voidData)
         fprintf(stderr, "lpugl: internal error in world.c:%d\n", __LINE__);
         abort();
     }
-    atomic_set(&world->awakeSent, 0);
+    bool wasSent  = (atomic_set(&world->awakeSent, 0) != 0);
+    bool wasAwake = (atomic_set(&world->awakeCalled, 0) != 0);
     world->hadEvent = true;
 
+    // process function is not invoked if only tasks are due or requests are queued
+    bool hasTasks     = (world->sleepingTasks || world->fdTasks);
+    bool onlyRequests = (wasSent && !wasAwake);
+    bool wasDue       = (world->nextProcessTime >= 0 
+                         && world->nextProcessTime <= puglGetTime(world->puglWorld));
+    bool mustProcess  = (wasAwake || wasDue || (!hasTasks && !onlyRequests));
+    if (mustProcess) {
+        world->nextProcessTime = -1;
+    }
+
     lua_State* L = world->eventL;
     int oldTop = lua_gettop(L);
     
@@ -165,48 +358,39 @@ static PuglStatus lpugl_world_process(PuglWorld* puglWorld, void* voidData)
         fprintf(stderr, "lpugl: internal error in world.c:%d\n", __LINE__);
         abort();
     }
-    if (lua_rawgeti(L, -1, LPUGL_WORLD_UV_PROCFUNC) != LUA_TFUNCTION) {     /* -> weakWorld, worldUdata, worldUservalue, procFunc */
-        lua_settop(L, oldTop);
-        return PUGL_SUCCESS;
+    int worldUservalue = lua_gettop(L);
+
+    if (atomic_get_ptr(&world->requests)) {
+        handleRequests(L, world);
+    }
+    if (world->channels) {
+        lpugl_channel_deliver_all(L, world, worldUservalue, msgh);
     }
+    if (world->tripleBuffers && world->weakWorldRef != LUA_REFNIL) {
+        lpugl_triplebuf_deliver_all(L, world, worldUservalue, msgh);
+    }
+    if (hasTasks && world->weakWorldRef != LUA_REFNIL) {
+        lpugl_task_resume_all(L, world, worldUservalue, msgh);
+    }
+    if (   mustProcess
+        && world->weakWorldRef != LUA_REFNIL                                    /* world not closed by channel function */
+        && lua_rawgeti(L, worldUservalue, LPUGL_WORLD_UV_PROCFUNC) == LUA_TFUNCTION) /* -> weakWorld, worldUdata, worldUservalue, procFunc */
+    {
+        int rc = lua_pcall(L, 0, 0, msgh);                                  /* -> weakWorld, worldUdata, worldUservalue, ? */
+        if (rc != 0) {                                                      /* -> weakWorld, worldUdata, worldUservalue, error */
+            lpugl_world_handle_error(L, worldUservalue, msgh);              /* -> weakWorld, worldUdata, worldUservalue */
+        }
+    }
+    lua_settop(L, oldTop);
 
-    int rc = lua_pcall(L, 0, 0, msgh);                                      /* -> weakWorld, worldUdata, worldUservalue, ? */
+    if (world->sleepingTasks || world->nextProcessTime >= 0) {
+        lpugl_world_schedule_process(world); // pugl's timer was reset by processing
+    }
 
     world->inCallback = wasInCallback;
     if (!wasInCallback && world->mustClosePugl) {
         lpugl_world_close_pugl(world);
     }
-
-    if (rc != 0) {                                                          /* -> weakWorld, worldUdata, worldUservalue, error */
-        bool handled = false;
-        if (lua_rawgeti(L, -2, LPUGL_WORLD_UV_ERRFUNC) == LUA_TFUNCTION) {  /* -> weakWorld, worldUdata, worldUservalue, error, errFunc */
-            lua_rawgeti(L, -2, 1);                                          /* -> weakWorld, worldUdata, worldUservalue, error, errFunc, error[1] */
-            lua_rawgeti(L, -3, 2);                                          /* -> weakWorld, worldUdata, worldUservalue, error, errFunc, error[1], error[2] */
-            int rc2 = lua_pcall(L, 2, 0, msgh);                             /* -> weakWorld, worldUdata, worldUservalue, error, ? */
-            if (rc2 == 0) {
-                handled = true;                                             /* -> weakWorld, worldUdata, worldUservalue, error */
-                lua_pop(L, 1);                                              /* -> weakWorld, worldUdata, worldUservalue */
-            } else {                                                        /* -> weakWorld, worldUdata, worldUservalue, error, error2 */
-                lua_rawgeti(L, -1, 1);                                      /* -> weakWorld, worldUdata, worldUservalue, error, error2, errmsg2 */
-                fprintf(stderr, 
-                        "lpugl: %s: %s\n", LPUGL_ERROR_ERROR_IN_ERROR_HANDLING,
-                        lua_tostring(L, -1));
-                lua_pop(L, 2);                                              /* -> weakWorld, worldUdata, worldUservalue, error */
-            }
-        } else {                                                            /* -> weakWorld, worldUdata, worldUservalue, error, nil */
-            lua_pop(L, 1);                                                  /* -> weakWorld, worldUdata, worldUservalue, error */
-        }
-        if (!handled) {                                                     /* -> weakWorld, worldUdata, worldUservalue, error */
-            lua_rawgeti(L, -1, 1);                                          /* -> weakWorld, worldUdata, worldUservalue, error, errmsg */
-            fprintf(stderr, 
-                    "lpugl: %s: %s\n", LPUGL_ERROR_ERROR_IN_EVENT_HANDLING,
-                    lua_tostring(L, -1));
-            abort();
-        }                                                                   /* -> weakWorld, worldUdata, worldUservalue, error */
-        lua_pop(L, 1);                                                      /* -> weakWorld, worldUdata, worldUservalue */
-    }                                                                       /* -> weakWorld, worldUdata, worldUservalue */
-
-    lua_settop(L, oldTop);
     return PUGL_SUCCESS;
 }
 
@@ -235,6 +419,10 @@ static void registrateBackend(lua_State* L, int worldIdx, int backendIdx)
 
 static void deregistrateBackend(lua_State* L, int worldIdx, int backendIdx)
 {
+    WorldUserData* udata = lua_touserdata(L, worldIdx);
+    if (udata->world) {
+        lpugl_viewpool_release(L, udata->world, lua_touserdata(L, backendIdx));
+    }
     lua_getuservalue(L, worldIdx);                                   /* -> uservalue */
     if (lua_rawgeti(L, -1, LPUGL_WORLD_UV_BACKENDS) == LUA_TTABLE) { /* -> uservalue, backends */
         lua_pushnil(L);                                              /* -> uservalue, backends, nil */
@@ -249,6 +437,27 @@ static int Lpugl_newWorld(lua_State* L)
 {
     luaL_checkstring(L, 1); /* for puglSetClassName */
     
+    PuglWorldFlags flags = 0;
+    if (!lua_isnoneornil(L, 2)) {
+        luaL_checktype(L, 2, LUA_TTABLE);
+        lua_pushnil(L);                 /* -> nil */
+        while (lua_next(L, 2)) {        /* -> key, value */
+            const char* key = (lua_type(L, -2) == LUA_TSTRING) ? lua_tostring(L, -2) : NULL;
+            if (key && strcmp(key, "sharedDisplay") == 0) {
+                if (lua_type(L, -1) != LUA_TBOOLEAN) {
+                    return luaL_argerror(L, 2, lua_pushfstring(L, "boolean expected as 'sharedDisplay' value, got %s",
+                                                               luaL_typename(L, -1)));
+                }
+                if (lua_toboolean(L, -1)) {
+                    flags |= PUGL_WORLD_SHARED_DISPLAY;
+                }
+            } else {
+                return luaL_argerror(L, 2, lua_pushfstring(L, "unexpected table key '%s'", luaL_tolstring(L, -2, NULL)));
+            }
+            lua_pop(L, 1);              /* -> key */
+        }                               /* -> */
+    }
+    
     WorldUserData* udata = lua_newuserdata(L, sizeof(WorldUserData));
     memset(udata, 0, sizeof(WorldUserData));
     udata->magic = LPUGL_WORLD_MAGIC;
@@ -265,15 +474,18 @@ static int Lpugl_newWorld(lua_State* L)
     world->id = atomic_inc(&lpugl_id_counter);
     udata->id = world->id;
     world->weakWorldRef = LUA_REFNIL;
+    world->nextProcessTime = -1;
     world->registrateBackend = registrateBackend;
     world->deregistrateBackend = deregistrateBackend;
+    world->deliverBackendEvent = lpugl_view_deliver_backend_event;
+    world->logBackendError = logBackendError;
+    world->threads = lpugl_application_threads;
 
-    async_mutex_lock(lpugl_global_lock);
-        world->nextWorld = global_world_list;
-        global_world_list = world;
-    async_mutex_unlock(lpugl_global_lock);
+    if (!lpugl_worldmap_add(world)) {
+        return lpugl_ERROR_OUT_OF_MEMORY(L);
+    }
 
-    world->puglWorld = puglNewWorld(PUGL_MODULE, 0);
+    world->puglWorld = puglNewWorld(PUGL_MODULE, flags);
     if (!world->puglWorld) {
         return lpugl_ERROR_FAILED_OPERATION(L);
     }
@@ -315,14 +527,8 @@ static int Lpugl_world(lua_State* L)
     lua_setmetatable(L, -2); /* -> udata */
     udata->id         = id;
     udata->restricted = true;
-    LpuglWorld* w = global_world_list;
-    async_mutex_lock(lpugl_global_lock);
-        while (w && w->id != id) {
-            w = w->nextWorld;
-        }
-    async_mutex_unlock(lpugl_global_lock);
+    LpuglWorld* w = lpugl_worldmap_retain(id);
     if (w) {
-        atomic_inc(&w->used);
         udata->world = w;
         return 1;
     } else {
@@ -334,8 +540,14 @@ static int Lpugl_world(lua_State* L)
 
 static void closeAll(lua_State* L, int udata, LpuglWorld* world)
 {
+    lpugl_viewpool_set_size(L, world, 0); // frees pooled views, views closed here are not pooled
+
     if (lua_getuservalue(L, udata) == LUA_TTABLE)                       /* -> uservalue */
     {
+        lpugl_channel_close_all(L, world, lua_gettop(L));               /* -> uservalue */
+        lpugl_triplebuf_close_all(L, world, lua_gettop(L));             /* -> uservalue */
+        lpugl_task_close_all(L, world, lua_gettop(L));                  /* -> uservalue */
+
         if (lua_rawgeti(L, LUA_REGISTRYINDEX, 
                            world->weakWorldRef) == LUA_TTABLE)          
         {                                                               /* -> uservalue, weakWorld */
@@ -388,25 +600,28 @@ static void closeAll(lua_State* L, int udata, LpuglWorld* world)
 
 static void destructWorld(LpuglWorld* world)
 {
-    async_mutex_lock(lpugl_global_lock);
-        if (global_world_list == world) {
-            global_world_list = world->nextWorld;
-        } else {
-            LpuglWorld* w = global_world_list;
-            while (w && w->nextWorld != world) {
-                w = w->nextWorld;
-            }
-            if (w) {
-                w->nextWorld = world->nextWorld;
-            }
-        }
-    async_mutex_unlock(lpugl_global_lock);
+    lpugl_worldmap_remove(world);
+    LpuglWorldRequest* request = takeRequests(world);
+    while (request) {
+        LpuglWorldRequest* next = request->next;
+        free(request);
+        request = next;
+    }
     async_lock_destruct(&world->lock);
     free(world);
 }
 
 /* ============================================================================================ */
 
+void lpugl_world_release(LpuglWorld* world)
+{
+    if (atomic_dec(&world->used) <= 0) {
+        destructWorld(world);
+    }
+}
+
+/* ============================================================================================ */
+
 void lpugl_world_close_pugl(LpuglWorld* world)
 {
     async_lock_acquire(&world->lock);
@@ -428,6 +643,7 @@ static void releaseUdataWorld(lua_State* L, int udataIdx, WorldUserData* udata)
     if (world) {
         if (!udata->restricted) {
             closeAll(L, udataIdx, world);
+            lpugl_record_stop(world);
             if (world->puglWorld) {
                 puglSetProcessFunc(world->puglWorld, NULL, NULL);
             }
@@ -453,7 +669,7 @@ static void releaseUdataWorld(lua_State* L, int udataIdx, WorldUserData* udata)
 
 static int World_release(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     releaseUdataWorld(L, 1, udata);
     return 0;
 }
@@ -462,7 +678,7 @@ static int World_release(lua_State* L)
 
 static int World_close(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
 
     if (udata->restricted) {
         return lpugl_ERROR_RESTRICTED_ACCESS(L);
@@ -475,9 +691,33 @@ static int World_close(lua_State* L)
 
 /* ============================================================================================ */
 
+static LpuglBackend* checkBackendArg(lua_State* L, int arg, int idx, LpuglWorld* world)
+{
+    luaL_checktype(L, idx, LUA_TUSERDATA);
+    LpuglBackend* backend = lua_touserdata(L, idx);
+    if (!lua_getmetatable(L, idx) || lua_getfield(L, -1, "lpugl.backend") != LUA_TBOOLEAN || !lua_toboolean(L, -1)
+     || !backend || backend->magic != LPUGL_BACKEND_MAGIC)
+    {
+        luaL_argerror(L, arg, "invalid backend");
+    }                                                   /* -> meta, backendFlag */
+    lua_pop(L, 2);                                      /* -> */
+    if (strcmp(backend->versionId, "lpugl.backend-" LPUGL_PLATFORM_STRING "-" LPUGL_VERSION_STRING) != 0) {
+        luaL_argerror(L, arg, "backend version mismatch");
+    }
+    if (!backend->world) {
+        luaL_argerror(L, arg, "backend closed");
+    }
+    if (backend->world != world) {
+        luaL_argerror(L, arg, "backend belongs to other lpugl.world");
+    }
+    return backend;
+}
+
+/* ============================================================================================ */
+
 static int World_setDefaultBackend(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     
     if (udata->restricted) {
         return lpugl_ERROR_RESTRICTED_ACCESS(L);
@@ -491,23 +731,7 @@ static int World_setDefaultBackend(lua_State* L)
         lua_rawseti(L, -2, LPUGL_WORLD_UV_DEFBACKEND);  /* -> uservalue */
     }
     else {
-        luaL_checktype(L, 2, LUA_TUSERDATA);
-        LpuglBackend* backend = lua_touserdata(L, 2);
-        if (!lua_getmetatable(L, 2) || lua_getfield(L, -1, "lpugl.backend") != LUA_TBOOLEAN || !lua_toboolean(L, -1)
-         || !backend || backend->magic != LPUGL_BACKEND_MAGIC)
-        {
-            return luaL_argerror(L, 2, "invalid backend");
-        }                                               /* -> meta, backendFlag */
-        lua_pop(L, 2);                                  /* -> */
-        if (strcmp(backend->versionId, "lpugl.backend-" LPUGL_PLATFORM_STRING "-" LPUGL_VERSION_STRING) != 0) {
-            return luaL_argerror(L, 2, "backend version mismatch");
-        }
-        if (!backend->world) {
-            return luaL_argerror(L, 2, "backend closed");
-        }
-        if (backend->world != udata->world) {
-            return luaL_argerror(L, 2, "backend belongs to other lpugl.world");
-        }
+        checkBackendArg(L, 2, 2, udata->world);
         lua_getuservalue(L, 1);                         /* -> uservalue */
         lua_pushvalue(L, 2);                            /* -> uservalue, backend */
         lua_rawseti(L, -2, LPUGL_WORLD_UV_DEFBACKEND);  /* -> uservalue */
@@ -519,7 +743,7 @@ static int World_setDefaultBackend(lua_State* L)
 
 static int World_getDefaultBackend(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
 
     if (udata->restricted) {
         return lpugl_ERROR_RESTRICTED_ACCESS(L);
@@ -536,7 +760,7 @@ static int World_getDefaultBackend(lua_State* L)
 
 static int World_getLayoutContext(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
 
     if (udata->restricted) {
         return lpugl_ERROR_RESTRICTED_ACCESS(L);
@@ -562,7 +786,7 @@ static int World_getLayoutContext(lua_State* L)
 
 static int World_toString(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     toLuaString(L, udata);
     return 1;
 }
@@ -571,7 +795,7 @@ static int World_toString(lua_State* L)
 
 static int World_id(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     if (!udata->world || !udata->world->puglWorld) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
     }    
@@ -583,7 +807,7 @@ static int World_id(lua_State* L)
 
 static int World_newView(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     if (udata->restricted) {
         return lpugl_ERROR_RESTRICTED_ACCESS(L);
     }
@@ -625,9 +849,43 @@ static int World_newView(lua_State* L)
 
 /* ============================================================================================ */
 
+/*
+ * Performs incremental GC steps until the current cycle is finished or until 
+ * the idle time ends. A new cycle is only started if memory usage has grown
+ * since the last finished cycle.
+ */
+static void runIdleGC(lua_State* L, LpuglWorld* world, double endTime)
+{
+    int kb = lua_gc(L, LUA_GCCOUNT, 0);
+    if (!world->idleGCInCycle && kb < world->idleGCLastKB + world->idleGCStepKB) {
+        return;
+    }
+    double startTime = puglGetTime(world->puglWorld);
+    double deadline  = startTime + world->idleGCMaxTime;
+    if (endTime >= 0 && endTime < deadline) {
+        deadline = endTime;
+    }
+    if (world->nextProcessTime >= 0 && world->nextProcessTime < deadline) {
+        deadline = world->nextProcessTime;
+    }
+    double now = startTime;
+    world->idleGCInCycle = true;
+    while (now < deadline) {
+        world->gcStats.idleSteps += 1;
+        if (lua_gc(L, LUA_GCSTEP, world->idleGCStepKB)) {
+            world->gcStats.idleCycles += 1;
+            world->idleGCInCycle = false;
+            world->idleGCLastKB  = lua_gc(L, LUA_GCCOUNT, 0);
+            break;
+        }
+        now = puglGetTime(world->puglWorld);
+    }
+    world->gcStats.idleTime += puglGetTime(world->puglWorld) - startTime;
+}
+
 static int World_update(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     LpuglWorld* world = udata->world;
     if (udata->restricted) {
         return lpugl_ERROR_RESTRICTED_ACCESS(L);
@@ -652,7 +910,24 @@ static int World_update(lua_State* L)
     
     double endTime = (timeout < 0) ? -1 : puglGetTime(world->puglWorld) + timeout;
     PuglStatus status;
+
+    if (world->idleGC && timeout != 0) {
+        // idle GC only if no events are pending and no process function is due
+        status = puglUpdate(world->puglWorld, 0);
+        if (status != PUGL_FAILURE || world->hadEvent) {
+            goto done;
+        }
+        runIdleGC(L, world, endTime);
+        if (timeout > 0) {
+            timeout = endTime - puglGetTime(world->puglWorld);
+            if (timeout < 0) {
+                timeout = 0;
+            }
+        }
+    }
+#ifdef LPUGL_USE_X11
 again:
+#endif
     status = puglUpdate(world->puglWorld, timeout);
 
 #ifdef LPUGL_USE_X11
@@ -665,6 +940,7 @@ again:
         }
     }
 #endif
+done:
     world->inCallback = wasInCallback;
     if (!wasInCallback) {
         world->hadEvent = false;
@@ -682,9 +958,227 @@ again:
 
 /* ============================================================================================ */
 
+static int World_dispatchPending(lua_State* L)
+{
+    lua_settop(L, 1);           /* -> world */
+    lua_pushnumber(L, 0);       /* -> world, timeout */
+    return World_update(L);
+}
+
+/* ============================================================================================ */
+
+static int World_getPollFd(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }    
+    int fd = puglGetPollFd(world->puglWorld);
+    if (fd >= 0) {
+        lua_pushinteger(L, fd);
+    } else {
+        lua_pushnil(L);
+    }
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int World_getNextDeadline(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }    
+    double deadline = puglGetNextDeadline(world->puglWorld);
+    if (deadline >= 0) {
+        lua_pushnumber(L, deadline);
+    } else {
+        lua_pushnil(L);
+    }
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int World_setIdleGC(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    if (lua_isnoneornil(L, 2) || (lua_isboolean(L, 2) && !lua_toboolean(L, 2))) {
+        world->idleGC              = false;
+        world->idleGCPauseInExpose = false;
+        return 0;
+    }
+    luaL_checktype(L, 2, LUA_TTABLE);
+
+    lua_Integer stepKB        = 64;
+    lua_Number  maxMs         = 2;
+    bool        pauseInExpose = false;
+
+    if (lua_getfield(L, 2, "stepKB") != LUA_TNIL) {                 /* -> stepKB */
+        stepKB = (lua_Integer)lua_tonumber(L, -1);
+        if (!lua_isnumber(L, -1) || stepKB <= 0) {
+            return luaL_argerror(L, 2, "invalid 'stepKB' value");
+        }
+    }
+    if (lua_getfield(L, 2, "maxMs") != LUA_TNIL) {                  /* -> stepKB, maxMs */
+        maxMs = lua_tonumber(L, -1);
+        if (!lua_isnumber(L, -1) || maxMs <= 0) {
+            return luaL_argerror(L, 2, "invalid 'maxMs' value");
+        }
+    }
+    if (lua_getfield(L, 2, "pauseInExpose") != LUA_TNIL) {          /* -> stepKB, maxMs, pauseInExpose */
+        pauseInExpose = lua_toboolean(L, -1);
+    }
+    lua_pop(L, 3);                                                  /* -> */
+
+    world->idleGC              = true;
+    world->idleGCStepKB        = (int)stepKB;
+    world->idleGCMaxTime       = maxMs / 1000;
+    world->idleGCPauseInExpose = pauseInExpose;
+    return 0;
+}
+
+/* ============================================================================================ */
+
+static int World_getGCStats(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    LpuglGCStats* stats = &world->gcStats;
+    lua_newtable(L);                                       /* -> rslt */
+    lua_pushnumber(L, stats->idleTime);
+    lua_setfield(L, -2, "idleTime");
+    lua_pushinteger(L, stats->idleSteps);
+    lua_setfield(L, -2, "idleSteps");
+    lua_pushinteger(L, stats->idleCycles);
+    lua_setfield(L, -2, "idleCycles");
+    lua_pushnumber(L, stats->frameTime);
+    lua_setfield(L, -2, "frameTime");
+    lua_pushinteger(L, stats->frames);
+    lua_setfield(L, -2, "frames");
+    lua_pushinteger(L, stats->frameKB);
+    lua_setfield(L, -2, "frameKB");
+    lua_pushinteger(L, stats->frameCollections);
+    lua_setfield(L, -2, "frameCollections");
+    if (lua_toboolean(L, 2)) {
+        memset(stats, 0, sizeof(LpuglGCStats));
+    }
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int World_setViewPoolSize(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    lua_Integer size = luaL_checkinteger(L, 2);
+    if (size < 0 || size > INT_MAX / 64) {
+        return luaL_argerror(L, 2, "invalid size");
+    }
+    if (!lpugl_viewpool_set_size(L, world, (int)size)) {
+        return lpugl_ERROR_OUT_OF_MEMORY(L);
+    }
+    return 0;
+}
+
+/* ============================================================================================ */
+
+static int World_getViewPoolSize(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    int size, count;
+    lpugl_viewpool_get_size(world, &size, &count);
+    lua_pushinteger(L, size);
+    lua_pushinteger(L, count);
+    return 2;
+}
+
+/* ============================================================================================ */
+
+static int World_fillViewPool(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    lua_Integer count = luaL_checkinteger(L, 2);
+    bool doubleBuffer = false;
+    bool resizable    = false;
+    lua_settop(L, 3);
+    if (!lua_isnil(L, 3)) {
+        luaL_checktype(L, 3, LUA_TTABLE);
+        if (lua_getfield(L, 3, "useDoubleBuffer") != LUA_TNIL) {            /* -> useDoubleBuffer */
+            doubleBuffer = lua_toboolean(L, -1);
+        }
+        if (lua_getfield(L, 3, "resizable") != LUA_TNIL) {                  /* -> useDoubleBuffer, resizable */
+            resizable = lua_toboolean(L, -1);
+        }
+        lua_pop(L, 2);                                                      /* -> */
+        lua_getfield(L, 3, "backend");                                      /* -> backend */
+    } else {
+        lua_pushnil(L);                                                     /* -> nil */
+    }
+    if (lua_isnil(L, -1)) {
+        lua_pop(L, 1);                                                      /* -> */
+        lua_getuservalue(L, 1);                                             /* -> uservalue */
+        if (lua_rawgeti(L, -1, LPUGL_WORLD_UV_DEFBACKEND) == LUA_TNIL) {    /* -> uservalue, backend */
+            return luaL_argerror(L, 3, "missing backend parameter and no default backend available");
+        }
+        lua_remove(L, -2);                                                  /* -> backend */
+    }
+    int backendIdx = lua_gettop(L);
+    checkBackendArg(L, 3, backendIdx, world);
+    
+    lua_pushinteger(L, lpugl_viewpool_fill(L, world, (count > INT_MAX) ? INT_MAX : (int)count,
+                                           backendIdx, doubleBuffer, resizable));
+    return 1;
+}
+
+/* ============================================================================================ */
+
 static int World_hasViews(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     lua_pushboolean(L, udata->world && udata->world->viewCount > 0);
     return 1;
 }
@@ -693,7 +1187,7 @@ static int World_hasViews(lua_State* L)
 
 static int World_isClosed(lua_State* L)
 {
-    WorldUserData* udata  = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata  = checkWorldUdata(L, 1);
     LpuglWorld*    world  = udata->world;
     bool           closed;
     if (world) {
@@ -709,7 +1203,7 @@ static int World_isClosed(lua_State* L)
 
 static int World_viewList(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
 
     if (udata->restricted) {
         return lpugl_ERROR_RESTRICTED_ACCESS(L);
@@ -740,7 +1234,7 @@ static int World_viewList(lua_State* L)
 
 static int World_setProcessFunc(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     LpuglWorld* world = udata->world;
     if (udata->restricted) {
         return lpugl_ERROR_RESTRICTED_ACCESS(L);
@@ -760,7 +1254,7 @@ static int World_setProcessFunc(lua_State* L)
 
 static int World_setLogFunc(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     LpuglWorld* world = udata->world;
     if (udata->restricted) {
         return lpugl_ERROR_RESTRICTED_ACCESS(L);
@@ -790,7 +1284,7 @@ static const char* logLevels[] =
 
 static int World_setLogLevel(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     LpuglWorld* world = udata->world;
     if (udata->restricted) {
         return lpugl_ERROR_RESTRICTED_ACCESS(L);
@@ -815,7 +1309,7 @@ static int World_setLogLevel(lua_State* L)
 
 static int World_setErrorFunc(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     LpuglWorld* world = udata->world;
     if (udata->restricted) {
         return lpugl_ERROR_RESTRICTED_ACCESS(L);
@@ -835,7 +1329,108 @@ static int World_setErrorFunc(lua_State* L)
 
 static int World_setNextProcessTime(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    double seconds = luaL_checknumber(L, 2);
+    if (udata->restricted) {
+        if (seconds < 0) {
+            return luaL_argerror(L, 2, "non-negative number expected");
+        }
+        if (!world) {
+            lua_pushboolean(L, false);
+            return 1;
+        }
+        LpuglWorldRequest* request = calloc(1, sizeof(LpuglWorldRequest));
+        if (!request) {
+            return lpugl_ERROR_OUT_OF_MEMORY(L);
+        }
+        request->type    = LPUGL_REQUEST_PROCESS_TIME;
+        request->args[0] = seconds;
+        lua_pushboolean(L, pushRequest(world, request) == 0);
+        return 1;
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    world->nextProcessTime = (seconds >= 0) ? puglGetTime(world->puglWorld) + seconds : -1;
+    lpugl_world_schedule_process(world);
+    return 0;
+}
+
+/* ============================================================================================ */
+
+static int World_postRedisplay(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    lua_Integer viewId  = luaL_checkinteger(L, 2);
+    bool        hasRect = (lua_gettop(L) > 2);
+    double      rect[4];
+    if (hasRect) {
+        for (int i = 0; i < 4; ++i) {
+            rect[i] = luaL_checknumber(L, 3 + i);
+        }
+    }
+    if (udata->restricted) {
+        if (!world) {
+            lua_pushboolean(L, false);
+            return 1;
+        }
+        LpuglWorldRequest* request = calloc(1, sizeof(LpuglWorldRequest));
+        if (!request) {
+            return lpugl_ERROR_OUT_OF_MEMORY(L);
+        }
+        request->type    = LPUGL_REQUEST_REDISPLAY;
+        request->viewId  = viewId;
+        request->hasRect = hasRect;
+        if (hasRect) {
+            memcpy(request->args, rect, sizeof(rect));
+        }
+        lua_pushboolean(L, pushRequest(world, request) == 0);
+        return 1;
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    lua_pushboolean(L, lpugl_view_post_redisplay_id(L, world, viewId, hasRect ? rect : NULL));
+    return 1;
+}
+
+/* ============================================================================================ */
+
+static int World_injectEvents(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    return lpugl_view_inject_events(L, world, 2, 3);
+}
+
+/* ============================================================================================ */
+
+static int World_startRecording(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    return lpugl_record_start(L, world, luaL_checkstring(L, 2));
+}
+
+/* ============================================================================================ */
+
+static int World_stopRecording(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
     LpuglWorld* world = udata->world;
     if (udata->restricted) {
         return lpugl_ERROR_RESTRICTED_ACCESS(L);
@@ -843,42 +1438,159 @@ static int World_setNextProcessTime(lua_State* L)
     if (!world) {
         return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
     }
-    luaL_checknumber(L, 2);
-    puglSetNextProcessTime(world->puglWorld, lua_tonumber(L, 2));
+    lpugl_record_stop(world);
     return 0;
 }
 
 /* ============================================================================================ */
 
-static int awakeWorld(LpuglWorld* world)
+static int World_replay(lua_State* L)
 {
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    bool realTime = lua_toboolean(L, 4);
+    return lpugl_record_replay(L, world, 2, 3, realTime);
+}
+
+/* ============================================================================================ */
+
+int lpugl_world_awake(LpuglWorld* world)
+{
+    atomic_set(&world->awakeCalled, 1);
+    return sendAwake(world);
+}
+
+/*
+ * Like lpugl_world_awake() but never waits for the world's lock, can be called 
+ * from real-time threads. Returns 0 on success, 1 if the world is closed and 2 
+ * if the lock is held by another thread, i.e. the caller has to try again later.
+ */
+int lpugl_world_try_awake(LpuglWorld* world)
+{
+    atomic_set(&world->awakeCalled, 1);
+    if (!async_lock_tryacquire(&world->lock)) {
+        return 2;
+    }
     int rc = 0;
-    async_lock_acquire(&world->lock);
-        if (world->puglWorld) {
-            if (atomic_set_if_equal(&world->awakeSent, 0, 1)) {
-                puglAwake(world->puglWorld);
-            }
-        } else {
-            rc = 1; // world closed
+    if (world->puglWorld) {
+        if (atomic_set_if_equal(&world->awakeSent, 0, 1)) {
+            puglAwake(world->puglWorld); // write to non-blocking pipe
         }
+    } else {
+        rc = 1; // world closed
+    }
     async_lock_release(&world->lock);
     return rc;
 }
 
 static int World_awake(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     LpuglWorld*    world = udata->world;
-    bool wasNotified = (world != NULL) && (awakeWorld(world) == 0);
+    bool wasNotified = (world != NULL) && (lpugl_world_awake(world) == 0);
     lua_pushboolean(L, wasNotified);
     return 1;
 }
 
 /* ============================================================================================ */
 
+static int World_newChannel(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    return lpugl_channel_new(L, world, 1, 2);
+}
+
+/* ============================================================================================ */
+
+static int World_newTripleBuffer(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    lua_Integer count = luaL_checkinteger(L, 2);
+    luaL_argcheck(L, count > 0, 2, "count must be positive");
+    luaL_argcheck(L,    count <= INT_MAX
+                     && (size_t)count <= (SIZE_MAX - sizeof(LpuglTripleBuffer)) / (3 * sizeof(double)),
+                  2, "count too large");
+    if (!lua_isnoneornil(L, 3)) {
+        luaL_checktype(L, 3, LUA_TFUNCTION);
+    }
+    return lpugl_triplebuf_new(L, world, 1, count, lua_isnoneornil(L, 3) ? 0 : 3);
+}
+
+/* ============================================================================================ */
+
+static int World_spawn(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    return lpugl_task_spawn(L, world, 1, 2);
+}
+
+/* ============================================================================================ */
+
+/*
+ * Task functions can be invoked as world.sleep(s) or as world:sleep(s).
+ */
+static int taskFuncArg(lua_State* L)
+{
+    void* udata = lua_touserdata(L, 1);
+    if (udata && lua_getmetatable(L, 1)) {                      /* -> meta */
+        bool isWorld = lua_rawequal(L, -1, lua_upvalueindex(1));
+        lua_pop(L, 1);                                          /* -> */
+        if (isWorld) {
+            return 2;
+        }
+    }
+    return 1;
+}
+
+static int World_sleep(lua_State* L)
+{
+    return lpugl_task_sleep(L, taskFuncArg(L));
+}
+
+static int World_waitEvent(lua_State* L)
+{
+    return lpugl_task_wait_event(L, taskFuncArg(L));
+}
+
+static int World_waitFd(lua_State* L)
+{
+    return lpugl_task_wait_fd(L, taskFuncArg(L));
+}
+
+/* ============================================================================================ */
+
 static int World_getTime(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     LpuglWorld* world = udata->world;
  
     if (!world || !world->puglWorld) {
@@ -892,7 +1604,7 @@ static int World_getTime(lua_State* L)
 
 static int World_setClipboard(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     LpuglWorld* world = udata->world;
  
     if (udata->restricted) {
@@ -911,7 +1623,7 @@ static int World_setClipboard(lua_State* L)
 
 static int World_hasClipboard(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     LpuglWorld* world = udata->world;
  
     if (udata->restricted) {
@@ -927,9 +1639,27 @@ static int World_hasClipboard(lua_State* L)
 
 /* ============================================================================================ */
 
+static int World_hasPendingInput(lua_State* L)
+{
+    WorldUserData* udata = checkWorldUdata(L, 1);
+    LpuglWorld* world = udata->world;
+ 
+    if (udata->restricted) {
+        return lpugl_ERROR_RESTRICTED_ACCESS(L);
+    }
+    if (!world) {
+        return lpugl_ERROR_ILLEGAL_STATE(L, "closed");
+    }
+    
+    lua_pushboolean(L, puglHasPendingInput(world->puglWorld));
+    return 1;
+}
+
+/* ============================================================================================ */
+
 static int World_getScreenScale(lua_State* L)
 {
-    WorldUserData* udata = luaL_checkudata(L, 1, LPUGL_WORLD_CLASS_NAME);
+    WorldUserData* udata = checkWorldUdata(L, 1);
     if (udata->restricted) {
         return lpugl_ERROR_RESTRICTED_ACCESS(L);
     }
@@ -982,7 +1712,7 @@ static void notify_capi_releaseNotifier(notify_notifier* n)
 static int notify_capi_notify(notify_notifier* n, notifier_error_handler eh, void* ehdata)
 {
     LpuglWorld* world = (LpuglWorld*)n;
-    return awakeWorld(world);
+    return lpugl_world_awake(world);
 }
 
 static const notify_capi notify_capi_impl =
@@ -1010,13 +1740,33 @@ static const luaL_Reg WorldMethods[] =
     { "id",                 World_id                 },
     { "newView",            World_newView            },
     { "update",             World_update             },
+    { "dispatchPending",    World_dispatchPending    },
+    { "getPollFd",          World_getPollFd          },
+    { "getNextDeadline",    World_getNextDeadline    },
     { "close",              World_close              },
     { "isClosed",           World_isClosed           },
     { "hasViews",           World_hasViews           },
     { "viewList",           World_viewList           },
     { "setProcessFunc",     World_setProcessFunc     },
     { "setNextProcessTime", World_setNextProcessTime },
+    { "postRedisplay",      World_postRedisplay      },
+    { "setIdleGC",          World_setIdleGC          },
+    { "getGCStats",         World_getGCStats         },
+    { "setViewPoolSize",    World_setViewPoolSize    },
+    { "getViewPoolSize",    World_getViewPoolSize    },
+    { "fillViewPool",       World_fillViewPool       },
+    { "injectEvents",       World_injectEvents       },
+    { "startRecording",     World_startRecording     },
+    { "stopRecording",      World_stopRecording      },
+    { "replay",             World_replay             },
     { "awake",              World_awake              },
+    { "newChannel",         World_newChannel         },
+    { "newTripleBuffer",    World_newTripleBuffer    },
+    { "spawn",              World_spawn              },
+    { "sleep",              World_sleep              },
+    { "waitEvent",          World_waitEvent          },
+    { "waitFd",             World_waitFd             },
+    { "hasPendingInput",    World_hasPendingInput    },
     { "getTime",            World_getTime            },
     { "setErrorFunc",       World_setErrorFunc       },
     { "setLogFunc",         World_setLogFunc         },
@@ -1048,10 +1798,12 @@ static void setupWorldMeta(lua_State* L)
     lua_pushstring(L, LPUGL_WORLD_CLASS_NAME);          /* -> meta, className */
     lua_setfield(L, -2, "__metatable");                 /* -> meta */
 
-    luaL_setfuncs(L, WorldMetaMethods, 0);              /* -> meta */
+    lua_pushvalue(L, -1);                               /* -> meta, meta */
+    luaL_setfuncs(L, WorldMetaMethods, 1);              /* -> meta */
     
     lua_newtable(L);  /* WorldClass */                  /* -> meta, WorldClass */
-    luaL_setfuncs(L, WorldMethods, 0);                  /* -> meta, WorldClass */
+    lua_pushvalue(L, -2);                               /* -> meta, WorldClass, meta */
+    luaL_setfuncs(L, WorldMethods, 1);                  /* -> meta, WorldClass */
     lua_setfield (L, -2, "__index");                    /* -> meta */
 
     notify_set_capi(L, -1, &notify_capi_impl);          /* -> meta */  
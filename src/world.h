@@ -17,26 +17,68 @@
 #define LPUGL_WORLD_UV_LOGFUNC    5
 #define LPUGL_WORLD_UV_DEFBACKEND 6
 #define LPUGL_WORLD_UV_BACKENDS   7
+#define LPUGL_WORLD_UV_CHANNELS   8
+#define LPUGL_WORLD_UV_TRIPLEBUFS 9
+#define LPUGL_WORLD_UV_TASKS      10
 
 /* ============================================================================================ */
 
 struct LpuglBackend;
+struct LpuglRecorder;
+struct LpuglViewPool;
+struct LpuglChannel;
+struct LpuglTripleBuffer;
+struct LpuglTask;
+
+typedef struct LpuglGCStats {
+    double      idleTime;         // seconds spent in idle GC steps
+    lua_Integer idleSteps;
+    lua_Integer idleCycles;       // GC cycles finished by idle steps
+    double      frameTime;        // seconds spent in exposure handling
+    lua_Integer frames;
+    lua_Integer frameKB;          // memory allocated during exposure handling
+    lua_Integer frameCollections; // exposures during which memory was collected
+} LpuglGCStats;
 
 typedef struct LpuglWorld {
     Lock                  lock;
     lua_Integer           id;
     AtomicCounter         used;
     PuglWorld*            puglWorld;
-    struct LpuglWorld*    nextWorld;
     int                   weakWorldRef;
     int                   viewCount;
     lua_State*            eventL;
     bool                  inCallback;
     bool                  hadEvent;
     bool                  mustClosePugl;
+    bool                  threads;              // created after lpugl.initApplication(true)
     AtomicCounter         awakeSent;
+    AtomicCounter         awakeCalled;          // awake not only for queued requests
+    AtomicPtr             requests;             // requests from restricted worlds, most recent first
+    struct LpuglRecorder* recorder;
+    struct LpuglViewPool* viewPool;
+    struct LpuglChannel*  channels;             // open channels, see channel.h
+    int                   channelsChanged;
+    struct LpuglTripleBuffer* tripleBuffers;    // open triple buffers, see triplebuf.h
+    int                   tripleBuffersChanged;
+    int                   tripleBuffersPass;
+    struct LpuglTask*     sleepingTasks;        // sorted by time, see task.h
+    struct LpuglTask*     eventTasks;
+    struct LpuglTask*     fdTasks;
+    double                nextProcessTime;      // -1 if not set
+    bool                  idleGC;
+    bool                  idleGCPauseInExpose;
+    bool                  idleGCInCycle;
+    int                   idleGCStepKB;
+    double                idleGCMaxTime;
+    int                   idleGCLastKB;
+    LpuglGCStats          gcStats;
     void                  (*registrateBackend)(lua_State* L, int worldIdx, int backendIdx);
     void                  (*deregistrateBackend)(lua_State* L, int worldIdx, int backendIdx);
+    void                  (*deliverBackendEvent)(lua_State* L, struct LpuglWorld* world,
+                                                 struct LpuglBackend* backend, const char* eventName, 
+                                                 int argsIdx, int nargs); // see view.h
+    void                  (*logBackendError)(struct LpuglWorld* world, const char* msg); // see world.c
 } LpuglWorld;
 
 /* ============================================================================================ */
@@ -57,6 +99,16 @@ int lpugl_world_errormsghandler(lua_State* L);
 
 void lpugl_world_close_pugl(LpuglWorld* world);
 
+int lpugl_world_awake(LpuglWorld* world);
+
+int lpugl_world_try_awake(LpuglWorld* world);
+
+void lpugl_world_schedule_process(LpuglWorld* world);
+
+void lpugl_world_release(LpuglWorld* world);
+
+void lpugl_world_handle_error(lua_State* L, int worldUservalueIdx, int msgh);
+
 int lpugl_world_init_module(lua_State* L, int module);
 
 /* ============================================================================================ */
@@ -0,0 +1,166 @@
+#include "base.h"
+
+#include "lpugl.h"
+#include "worldmap.h"
+#include "world.h"
+
+/* ============================================================================================ */
+
+#define LPUGL_WORLDMAP_INITIAL_SIZE 64
+
+/*
+ * Open addressing with linear probing. A slot is marked as used when a world is stored
+ * for the first time and stays used after the world is removed, so that probing
+ * terminates at the first unused slot. Removed slots are reused for new worlds.
+ */
+typedef struct WorldSlot {
+    AtomicPtr      world;
+    AtomicCounter  readers;   // lookups currently accessing the slot's world
+    AtomicCounter  used;
+} WorldSlot;
+
+/*
+ * Tables are never freed. If the newest table is half full, a new table with twice
+ * the size is added, older tables are still searched until their worlds are removed.
+ */
+typedef struct WorldTable {
+    struct WorldTable* next;       // older table
+    size_t             mask;
+    size_t             usedCount;  // guarded by lpugl_global_lock
+    WorldSlot          slots[1];
+} WorldTable;
+
+static AtomicPtr world_tables; // newest table
+
+/* ============================================================================================ */
+
+static size_t hashId(lua_Integer id)
+{
+    size_t h = (size_t)id;
+    h ^= h >> 16;
+    h *= 0x45d9f3b;
+    h ^= h >> 16;
+    return h;
+}
+
+static bool retainIfUsed(LpuglWorld* world)
+{
+    int used;
+    do {
+        used = atomic_get(&world->used);
+        if (used <= 0) {
+            return false; // world is being destructed
+        }
+    } while (!atomic_set_if_equal(&world->used, used, used + 1));
+    return true;
+}
+
+/* ============================================================================================ */
+
+bool lpugl_worldmap_add(LpuglWorld* world)
+{
+    bool rslt = true;
+    async_mutex_lock(lpugl_global_lock);
+    
+        WorldTable* table = atomic_get_ptr(&world_tables);
+        WorldSlot*  slot  = NULL;
+        size_t      h     = hashId(world->id);
+        if (table) {
+            for (size_t i = 0; i <= table->mask; ++i) {
+                WorldSlot* s = table->slots + ((h + i) & table->mask);
+                if (!atomic_get(&s->used)) {
+                    if (table->usedCount < (table->mask + 1) / 2) {
+                        table->usedCount += 1;
+                        slot = s;
+                    }
+                    break;
+                }
+                if (!atomic_get_ptr(&s->world)) {
+                    slot = s; // reuse removed slot
+                    break;
+                }
+            }
+        }
+        if (!slot) {
+            size_t size = table ? 2 * (table->mask + 1) : LPUGL_WORLDMAP_INITIAL_SIZE;
+            WorldTable* newTable = calloc(1, sizeof(WorldTable) + (size - 1) * sizeof(WorldSlot));
+            if (newTable) {
+                newTable->next      = table;
+                newTable->mask      = size - 1;
+                newTable->usedCount = 1;
+                slot = newTable->slots + (h & newTable->mask);
+                atomic_set_ptr_if_equal(&world_tables, table, newTable);
+            } else {
+                rslt = false;
+            }
+        }
+        if (slot) {
+            atomic_set(&slot->used, 1);
+            atomic_set_ptr_if_equal(&slot->world, NULL, world);
+        }
+
+    async_mutex_unlock(lpugl_global_lock);
+    return rslt;
+}
+
+/* ============================================================================================ */
+
+/*
+ * Returns the world with the given id with increased reference counter or NULL if
+ * there is no such world. Does not lock.
+ */
+LpuglWorld* lpugl_worldmap_retain(lua_Integer id)
+{
+    size_t h = hashId(id);
+    for (WorldTable* table = atomic_get_ptr(&world_tables); table; table = table->next) {
+        for (size_t i = 0; i <= table->mask; ++i) {
+            WorldSlot* slot = table->slots + ((h + i) & table->mask);
+            if (!atomic_get(&slot->used)) {
+                break;
+            }
+            atomic_inc(&slot->readers);
+                LpuglWorld* world = atomic_get_ptr(&slot->world);
+                bool found    = (world && world->id == id);
+                bool retained = found && retainIfUsed(world);
+            atomic_dec(&slot->readers);
+            if (found) {
+                return retained ? world : NULL;
+            }
+        }
+    }
+    return NULL;
+}
+
+/* ============================================================================================ */
+
+/*
+ * After this call no lookup is accessing the world anymore and it can be freed.
+ */
+void lpugl_worldmap_remove(LpuglWorld* world)
+{
+    WorldSlot* slot = NULL;
+    size_t     h    = hashId(world->id);
+
+    async_mutex_lock(lpugl_global_lock);
+        for (WorldTable* table = atomic_get_ptr(&world_tables); table && !slot; table = table->next) {
+            for (size_t i = 0; i <= table->mask; ++i) {
+                WorldSlot* s = table->slots + ((h + i) & table->mask);
+                if (!atomic_get(&s->used)) {
+                    break;
+                }
+                if (atomic_set_ptr_if_equal(&s->world, world, NULL)) {
+                    slot = s;
+                    break;
+                }
+            }
+        }
+    async_mutex_unlock(lpugl_global_lock);
+
+    if (slot) {
+        while (atomic_get(&slot->readers) > 0) {
+            // lookups only hold the slot for comparing the id
+        }
+    }
+}
+
+/* ============================================================================================ */
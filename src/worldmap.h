@@ -0,0 +1,23 @@
+#ifndef LPUGL_WORLDMAP_H
+#define LPUGL_WORLDMAP_H
+
+#include "base.h"
+
+struct LpuglWorld;
+
+/* ============================================================================================ */
+
+/*
+ * Hash map from world id to world. Lookups do not lock and can be invoked from
+ * any thread, adding and removing worlds is guarded by lpugl_global_lock.
+ */
+
+bool lpugl_worldmap_add(struct LpuglWorld* world);
+
+struct LpuglWorld* lpugl_worldmap_retain(lua_Integer id);
+
+void lpugl_worldmap_remove(struct LpuglWorld* world);
+
+/* ============================================================================================ */
+
+#endif /* LPUGL_WORLDMAP_H */
@@ -0,0 +1,200 @@
+#include "init.h"
+
+#if defined(LPUGL_USE_X11)
+    #include <GL/gl.h>
+
+#elif defined(LPUGL_USE_WIN)
+    #include <Windows.h>
+    #include <GL/gl.h>
+
+#elif defined(LPUGL_USE_MAC)
+    #include <OpenGL/gl.h>
+#endif
+
+#include "base.h"
+#include "async_util.h"
+
+#define LPUGL_GLRENDERER_CAPI_IMPLEMENT_SET_CAPI 1
+#include "glrenderer_capi.h"
+
+/* ============================================================================================ */
+
+/*
+ * Minimal native renderer for testing the render thread of lpugl_opengl backends:
+ * clears the whole view with a fixed color and counts the rendered frames and the
+ * released contexts.
+ */
+
+LPUGL_DLL_PUBLIC int luaopen_lpugl_testrenderer(lua_State* L);
+
+static const char* const TESTRENDERER_CLASS_NAME = "lpugl_testrenderer";
+
+typedef struct TestRenderer {
+    AtomicCounter  used;
+    float          color[4];
+    AtomicCounter  frames;
+    AtomicCounter  released;
+    AtomicCounter  width;
+    AtomicCounter  height;
+} TestRenderer;
+
+typedef struct RendererUserData {
+    TestRenderer*  renderer;
+} RendererUserData;
+
+/* ============================================================================================ */
+
+static void releaseRenderer(TestRenderer* r)
+{
+    if (atomic_dec(&r->used) <= 0) {
+        free(r);
+    }
+}
+
+/* ============================================================================================ */
+
+static lpugl_glrenderer* glrenderer_capi_toRenderer(lua_State* L, int index)
+{
+    RendererUserData* udata = luaL_testudata(L, index, TESTRENDERER_CLASS_NAME);
+    return udata ? (lpugl_glrenderer*)udata->renderer : NULL;
+}
+
+static void glrenderer_capi_retainRenderer(lpugl_glrenderer* r)
+{
+    atomic_inc(&((TestRenderer*)r)->used);
+}
+
+static void glrenderer_capi_releaseRenderer(lpugl_glrenderer* r)
+{
+    releaseRenderer((TestRenderer*)r);
+}
+
+static void glrenderer_capi_renderFrame(lpugl_glrenderer* r, const lpugl_glframe* frame)
+{
+    TestRenderer* renderer = (TestRenderer*)r;
+    glViewport(0, 0, frame->width, frame->height);
+    glClearColor(renderer->color[0], renderer->color[1], renderer->color[2], renderer->color[3]);
+    glClear(GL_COLOR_BUFFER_BIT);
+    atomic_set(&renderer->width,  frame->width);
+    atomic_set(&renderer->height, frame->height);
+    atomic_inc(&renderer->frames);
+}
+
+static void glrenderer_capi_releaseContext(lpugl_glrenderer* r, const void* view)
+{
+    atomic_inc(&((TestRenderer*)r)->released);
+}
+
+static const lpugl_glrenderer_capi glrenderer_capi_impl =
+{
+    LPUGL_GLRENDERER_CAPI_VERSION_MAJOR,
+    LPUGL_GLRENDERER_CAPI_VERSION_MINOR,
+    LPUGL_GLRENDERER_CAPI_VERSION_PATCH,
+    NULL, // next_capi
+
+    glrenderer_capi_toRenderer,
+
+    glrenderer_capi_retainRenderer,
+    glrenderer_capi_releaseRenderer,
+
+    glrenderer_capi_renderFrame,
+    glrenderer_capi_releaseContext
+};
+
+/* ============================================================================================ */
+
+static int TestRenderer_new(lua_State* L)
+{
+    RendererUserData* udata = lua_newuserdata(L, sizeof(RendererUserData)); /* -> udata */
+    memset(udata, 0, sizeof(RendererUserData));
+    luaL_setmetatable(L, TESTRENDERER_CLASS_NAME);                           /* -> udata */
+
+    TestRenderer* r = calloc(1, sizeof(TestRenderer));
+    if (!r) {
+        return luaL_error(L, "out of memory");
+    }
+    atomic_set(&r->used, 1);
+    for (int i = 0; i < 4; ++i) {
+        r->color[i] = (float)luaL_optnumber(L, i + 1, (i == 3) ? 1 : 0);
+    }
+    udata->renderer = r;
+    return 1;
+}
+
+static TestRenderer* checkRenderer(lua_State* L)
+{
+    RendererUserData* udata = luaL_checkudata(L, 1, TESTRENDERER_CLASS_NAME);
+    return udata->renderer;
+}
+
+static int TestRenderer_release(lua_State* L)
+{
+    RendererUserData* udata = luaL_checkudata(L, 1, TESTRENDERER_CLASS_NAME);
+    if (udata->renderer) {
+        releaseRenderer(udata->renderer);
+        udata->renderer = NULL;
+    }
+    return 0;
+}
+
+static int TestRenderer_frames(lua_State* L)
+{
+    lua_pushinteger(L, atomic_get(&checkRenderer(L)->frames));
+    return 1;
+}
+
+static int TestRenderer_released(lua_State* L)
+{
+    lua_pushinteger(L, atomic_get(&checkRenderer(L)->released));
+    return 1;
+}
+
+static int TestRenderer_size(lua_State* L)
+{
+    TestRenderer* r = checkRenderer(L);
+    lua_pushinteger(L, atomic_get(&r->width));
+    lua_pushinteger(L, atomic_get(&r->height));
+    return 2;
+}
+
+/* ============================================================================================ */
+
+static const luaL_Reg RendererMethods[] =
+{
+    { "frames",    TestRenderer_frames   },
+    { "released",  TestRenderer_released },
+    { "size",      TestRenderer_size     },
+    { NULL,        NULL } /* sentinel */
+};
+
+static const luaL_Reg RendererMetaMethods[] =
+{
+    { "__gc",      TestRenderer_release  },
+    { NULL,        NULL } /* sentinel */
+};
+
+static const luaL_Reg ModuleFunctions[] =
+{
+    { "new",       TestRenderer_new      },
+    { NULL,        NULL } /* sentinel */
+};
+
+LPUGL_DLL_PUBLIC int luaopen_lpugl_testrenderer(lua_State* L)
+{
+    luaL_checkversion(L); /* does nothing if compiled for Lua 5.1 */
+
+    if (luaL_newmetatable(L, TESTRENDERER_CLASS_NAME)) {     /* -> meta */
+        luaL_setfuncs(L, RendererMetaMethods, 0);            /* -> meta */
+        lua_newtable(L);                                     /* -> meta, RendererClass */
+        luaL_setfuncs(L, RendererMethods, 0);                /* -> meta, RendererClass */
+        lua_setfield(L, -2, "__index");                      /* -> meta */
+        lpugl_glrenderer_set_capi(L, -1, &glrenderer_capi_impl);
+    }
+    lua_pop(L, 1);                                           /* -> */
+
+    lua_newtable(L);                                         /* -> module */
+    luaL_setfuncs(L, ModuleFunctions, 0);                    /* -> module */
+    return 1;
+}
+
+/* ============================================================================================ */
@@ -0,0 +1,34 @@
+#!/bin/sh
+#
+# Runs all tests under Xvfb.
+#
+# Usage: run.sh [test ...]
+#
+# Environment:
+#   LUA        - Lua interpreter (default: lua)
+#   XVFB       - set to empty to run on the current display
+#
+# The OpenGL tests are forced to software rendering with Mesa llvmpipe.
+
+DIR=$(cd "$(dirname "$0")" && pwd)
+LUA=${LUA:-lua}
+TESTS=${*:-$(cd "$DIR" && ls test_*.lua | sed 's/\.lua$//')}
+XVFB=${XVFB-xvfb-run -a -s "-screen 0 1280x1024x24"}
+
+export LIBGL_ALWAYS_SOFTWARE=1
+export GALLIUM_DRIVER=llvmpipe
+
+FAILED=0
+for TEST in $TESTS; do
+    if eval "$XVFB" '$LUA "$DIR/$TEST.lua"'; then
+        echo "passed $TEST"
+    else
+        echo "FAILED $TEST"
+        FAILED=$((FAILED + 1))
+    fi
+done
+
+if [ $FAILED -gt 0 ]; then
+    echo "$FAILED test(s) failed"
+    exit 1
+fi
@@ -0,0 +1,73 @@
+local lpugl        = require"lpugl_opengl"
+local testrenderer = require"lpugl_testrenderer"
+
+----------------------------------------------------------------------------------------------
+
+lpugl.initApplication(true)
+
+local world = lpugl.newWorld("test_render_thread.lua", { renderThread = true })
+
+local function waitFor(condition)
+    local t0 = world:getTime()
+    while not condition() do
+        assert(world:getTime() - t0 < 5, "timeout")
+        world:update(0.01)
+    end
+end
+
+local exposures = 0
+
+local view = world:newView {
+    title     = "test_render_thread",
+    size      = { 200, 150 },
+    eventFunc = function(view, event, ...)
+        if event == "EXPOSE" then
+            exposures = exposures + 1
+        end
+    end
+}
+local renderer = testrenderer.new(0.2, 0.4, 0.6)
+view:setRenderer(renderer)
+view:show()
+
+-- first frame is rendered on the render thread after the first exposure
+
+waitFor(function() return renderer:frames() >= 1 end)
+local w, h = renderer:size()
+assert(w > 0 and h > 0)
+
+-- redraw
+
+local frames = renderer:frames()
+view:postRedisplay()
+waitFor(function() return renderer:frames() > frames end)
+
+-- requests that arrive before the render thread has started the previous frame
+-- are combined, but every exposure results in at least one more frame
+
+for i = 1, 20 do
+    frames = renderer:frames()
+    view:postRedisplay()
+    world:update(0)
+end
+waitFor(function() return renderer:frames() > frames end)
+assert(renderer:frames() <= exposures)
+
+-- removing the renderer waits until its context objects are released
+
+view:setRenderer(nil)
+assert(renderer:released() == 1)
+frames = renderer:frames()
+
+view:postRedisplay() -- drawn on the world's thread
+world:update(0.1)
+assert(renderer:frames() == frames)
+
+-- closing the view releases the renderer's context objects
+
+view:setRenderer(renderer)
+waitFor(function() return renderer:frames() > frames end)
+view:close()
+assert(renderer:released() == 2)
+
+world:close()
@@ -0,0 +1,37 @@
+local lpugl = require"lpugl_opengl"
+
+----------------------------------------------------------------------------------------------
+
+local world = lpugl.newWorld("test_swap_interval.lua")
+
+-- adaptive vertical synchronization must not be confused with an unset swap interval
+
+local view = world:newView {
+    title        = "test_swap_interval",
+    size         = { 100, 100 },
+    swapInterval = -1,
+    eventFunc    = function() end
+}
+assert(view:getSwapInterval() == -1)
+
+view:show()
+world:update(0)
+
+-- -1 if GLX_EXT_swap_control_tear is available, 1 otherwise
+local interval = view:getSwapInterval()
+assert(interval == -1 or interval == 1, tostring(interval))
+
+local effective = view:setSwapInterval(-1)
+if effective then
+    assert(view:getSwapInterval() == effective)
+    assert(effective == interval)
+end
+
+effective = view:setSwapInterval(0)
+if effective then
+    assert(effective == 0)
+    assert(view:getSwapInterval() == 0)
+end
+
+view:close()
+world:close()